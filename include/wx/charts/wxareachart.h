@@ -39,7 +39,9 @@
 #include "wxchart.h"
 #include "wxareachartoptions.h"
 #include "wxchartgrid.h"
-#include "wxchartpoint.h"
+#include "wxchartpointseries.h"
+#include "wxchartelementcache.h"
+#include "wxchartxindex.h"
 
 class wxAreaChartDataset
 {
@@ -101,9 +103,6 @@ public:
 
     virtual const wxAreaChartOptions& GetOptions() const wxOVERRIDE;
 
-    void Save(const wxString &filename, const wxBitmapType &type,
-        const wxSize &size);
-
 private:
     void Initialize(const wxAreaChartData &data);
     static wxDouble GetMinXValue(const wxVector<wxAreaChartDataset::ptr>& datasets);
@@ -114,28 +113,22 @@ private:
     virtual void DoSetSize(const wxSize &size) wxOVERRIDE;
     virtual void DoFit() wxOVERRIDE;
     virtual void DoDraw(wxGraphicsContext &gc) wxOVERRIDE;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) wxOVERRIDE;
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) wxOVERRIDE;
+    const wxChartElement* GetActivePoint(size_t datasetIndex, size_t index);
 
 private:
-    class Point : public wxChartPoint
+    class TooltipProvider : public wxChartDatasetTooltipProvider
     {
     public:
-        typedef wxSharedPtr<Point> ptr;
-
-        Point(wxPoint2DDouble value,
-            const wxChartTooltipProvider::ptr tooltipProvider,
-            wxDouble x, wxDouble y,wxDouble radius,
-            unsigned int strokeWidth,const wxColor &fillColor,
-            wxDouble hitDetectionRange);
+        TooltipProvider(const wxAreaChartDataset::ptr dataset);
 
-        virtual wxPoint2DDouble GetTooltipPosition() const;
-        virtual bool HitTest(const wxPoint &point) const;
-
-        wxPoint2DDouble GetValue() const;
+        virtual wxString GetTooltipTitle(size_t index) const;
+        virtual wxString GetTooltipText(size_t index) const;
+        virtual wxColor GetAssociatedColor(size_t index) const;
 
     private:
-        wxPoint2DDouble m_value;
-        wxDouble m_hitDetectionRange;
+        wxAreaChartDataset::ptr m_dataset;
     };
 
     class Dataset
@@ -143,27 +136,53 @@ private:
     public:
         typedef wxSharedPtr<Dataset> ptr;
 
-        Dataset(bool showDots, bool showLine,
-            const wxColor &lineColor);
+        Dataset(const wxAreaChartDataset::ptr data,
+            const wxChartDatasetTooltipProvider::ptr tooltipProvider,
+            wxDouble dotRadius, wxDouble hitDetectionRange,
+            const wxChartPointOptions &dotOptions);
 
         bool ShowDots() const;
         bool ShowLine() const;
         const wxColor& GetLineColor() const;
 
-        const wxVector<Point::ptr>& GetPoints() const;
-        void AppendPoint(Point::ptr point);
+        const wxVector<wxPoint2DDouble>& GetValues() const;
+        const wxChartDatasetTooltipProvider::ptr& GetTooltipProvider() const;
+        const wxChartPointSeries& GetPoints() const;
+        wxChartPointSeries& GetPoints();
 
     private:
         bool m_showDots;
         bool m_showLine;
         wxColor m_lineColor;
-        wxVector<Point::ptr> m_points;
+        wxAreaChartDataset::ptr m_data;
+        wxChartDatasetTooltipProvider::ptr m_tooltipProvider;
+        wxChartPointSeries m_points;
+    };
+
+    // The element created on demand for an active point
+    class Point : public wxChartElement
+    {
+    public:
+        Point(const Dataset &dataset, size_t index);
+
+        virtual bool HitTest(const wxPoint &point) const;
+        virtual wxPoint2DDouble GetTooltipPosition() const;
+        virtual const wxChartTooltipProvider::ptr GetTooltipProvider() const;
+
+    private:
+        const Dataset &m_dataset;
+        size_t m_index;
     };
 
 private:
     wxAreaChartOptions m_options;
     wxChartGrid m_grid;
     wxVector<Dataset::ptr> m_datasets;
+    // One index per dataset
+    wxVector<wxChartXIndex> m_xIndices;
+    wxChartElementCache m_activePoints;
+    // Scratch buffer used by GetActiveElements
+    wxVector<size_t> m_hitPoints;
 };
 
 #endif
@@ -60,11 +60,15 @@ private:
     virtual void DoSetSize(const wxSize &size) wxOVERRIDE;
     virtual void DoFit() wxOVERRIDE;
     virtual void DoDraw(wxGraphicsContext &gc) wxOVERRIDE;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) wxOVERRIDE;
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) wxOVERRIDE;
 
     wxDouble GetBarHeight() const;
+    size_t GetNumberOfBars() const;
 
 private:
+    class BarLoop;
+
     class Bar : public wxChartRectangle
     {
     public:
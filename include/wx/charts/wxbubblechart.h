@@ -29,6 +29,7 @@
 #include "wxbubblechartoptions.h"
 #include "wxchartgrid.h"
 #include "wxchartcircle.h"
+#include "wxchartspatialindex.h"
 
 class wxDoubleTriplet
 {
@@ -104,23 +105,44 @@ private:
 
     virtual void DoSetSize(const wxSize &size) wxOVERRIDE;
     virtual void DoFit() wxOVERRIDE;
+    virtual wxChart::Layout* CreateLayout() wxOVERRIDE;
+    virtual void ApplyLayout(wxChart::Layout &layout) wxOVERRIDE;
     virtual void DoDraw(wxGraphicsContext &gc) wxOVERRIDE;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) wxOVERRIDE;
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) wxOVERRIDE;
+    size_t GetNumberOfCircles() const;
 
 private:
+    class TooltipProvider : public wxChartDatasetTooltipProvider
+    {
+    public:
+        TooltipProvider(const wxBubbleChartDataset::ptr dataset);
+
+        virtual wxString GetTooltipTitle(size_t index) const;
+        virtual wxString GetTooltipText(size_t index) const;
+        virtual wxColor GetAssociatedColor(size_t index) const;
+
+    private:
+        wxBubbleChartDataset::ptr m_dataset;
+    };
+
     class Circle : public wxChartCircle
     {
     public:
         typedef wxSharedPtr<Circle> ptr;
 
         Circle(wxDoubleTriplet value, wxDouble x, wxDouble y, wxDouble radius,
-            const wxChartTooltipProvider::ptr tooltipProvider,
-            const wxChartCircleOptions &options);
+            const wxChartDatasetTooltipProvider::ptr tooltipProvider,
+            size_t index, const wxChartCircleOptions &options);
+
+        virtual const wxChartTooltipProvider::ptr GetTooltipProvider() const;
 
         wxDoubleTriplet GetValue() const;
 
     private:
         wxDoubleTriplet m_value;
+        wxChartDatasetTooltipProvider::ptr m_tooltipProvider;
+        size_t m_index;
     };
 
     class Dataset
@@ -142,12 +164,47 @@ private:
         wxVector<Circle::ptr> m_circles;
     };
 
+    class CircleLoop;
+
+    // The centers and radii of the circles and the
+    // index built from them
+    class Layout : public wxChart::Layout
+    {
+    public:
+        Layout(const wxChartGridMapping &mapping,
+            const wxVector<Dataset::ptr> &datasets,
+            wxDouble minZValue, wxDouble maxZValue,
+            wxChartThreadPool *pool);
+
+        virtual void Compute() wxOVERRIDE;
+
+        // The circles of all the datasets, in order
+        const wxVector<wxPoint2DDouble>& GetCenters() const;
+        const wxVector<wxDouble>& GetRadii() const;
+        wxChartSpatialIndex& GetIndex();
+
+    private:
+        wxChartGridMapping m_mapping;
+        wxVector<Dataset::ptr> m_datasets;
+        wxDouble m_minZValue;
+        wxDouble m_maxZValue;
+        // The pool used to compute the positions in
+        // parallel, may be 0
+        wxChartThreadPool *m_pool;
+        wxVector<wxPoint2DDouble> m_centers;
+        wxVector<wxDouble> m_radii;
+        wxChartSpatialIndex m_index;
+    };
+
 private:
     wxBubbleChartOptions m_options;
     wxChartGrid m_grid;
     wxVector<Dataset::ptr> m_datasets;
     wxDouble m_minZValue;
     wxDouble m_maxZValue;
+    wxChartSpatialIndex m_index;
+    // Scratch buffer used by GetActiveElements
+    wxVector<size_t> m_hitCircles;
 };
 
 #endif
@@ -29,6 +29,7 @@
 #include "wxchartohlcdata.h"
 #include "wxcandlestickchartoptions.h"
 #include "wxchartgrid.h"
+#include "wxchartbatchrenderer.h"
 
 /// Data for the wxCandlestickChartCtrl control.
 class wxCandlestickChartData
@@ -71,10 +72,26 @@ private:
 
     virtual void DoSetSize(const wxSize &size) wxOVERRIDE;
     virtual void DoFit() wxOVERRIDE;
+    virtual wxChart::Layout* CreateLayout() wxOVERRIDE;
+    virtual void ApplyLayout(wxChart::Layout &layout) wxOVERRIDE;
     virtual void DoDraw(wxGraphicsContext &gc) wxOVERRIDE;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) wxOVERRIDE;
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) wxOVERRIDE;
 
 private:
+    class TooltipProvider : public wxChartDatasetTooltipProvider
+    {
+    public:
+        TooltipProvider(const wxSharedPtr<wxCandlestickChartData> data);
+
+        virtual wxString GetTooltipTitle(size_t index) const;
+        virtual wxString GetTooltipText(size_t index) const;
+        virtual wxColor GetAssociatedColor(size_t index) const;
+
+    private:
+        wxSharedPtr<wxCandlestickChartData> m_data;
+    };
+
     class Candlestick : public wxChartElement
     {
     public:
@@ -82,19 +99,30 @@ private:
 
         Candlestick(const wxChartOHLCData &data, const wxColor &lineColor, unsigned int lineWidth,
             const wxColor &upFillColor, const wxColor &downFillColor, unsigned int rectangleWidth,
-            const wxChartTooltipProvider::ptr tooltipProvider);
+            const wxChartDatasetTooltipProvider::ptr tooltipProvider,
+            size_t index);
 
         virtual bool HitTest(const wxPoint &point) const;
         virtual wxPoint2DDouble GetTooltipPosition() const;
+        virtual const wxChartTooltipProvider::ptr GetTooltipProvider() const;
 
-        /// Draws the OHLDC lines.
-        /// @param gc The graphics context.
-        void Draw(wxGraphicsContext &gc);
+        /// Whether the close value is above the open value.
+        /// @return True if the value went up.
+        bool IsUp() const;
+        /// Draws the candlestick.
+        /// @param renderer The batch renderer.
+        void Draw(wxChartBatchRenderer &renderer) const;
 
-        void Update(const wxChartGridMapping& mapping, size_t index);
+        const wxChartOHLCData& GetData() const;
+        void SetPoints(const wxPoint2DDouble &lowPoint,
+            const wxPoint2DDouble &highPoint,
+            const wxPoint2DDouble &openPoint,
+            const wxPoint2DDouble &closePoint);
 
     private:
         wxChartOHLCData m_data;
+        wxChartDatasetTooltipProvider::ptr m_tooltipProvider;
+        size_t m_index;
         wxPoint2DDouble m_lowPoint;
         wxPoint2DDouble m_highPoint;
         wxPoint2DDouble m_openPoint;
@@ -106,6 +134,31 @@ private:
         unsigned int m_rectangleWidth;
     };
 
+    class CandlestickLoop;
+
+    // The positions of the low, high, open and close
+    // values of the candlesticks
+    class Layout : public wxChart::Layout
+    {
+    public:
+        Layout(const wxChartGridMapping &mapping,
+            const wxVector<Candlestick::ptr> &candlesticks,
+            wxChartThreadPool *pool);
+
+        virtual void Compute() wxOVERRIDE;
+
+        // 4 points per candlestick: low, high, open and close
+        const wxVector<wxPoint2DDouble>& GetPoints() const;
+
+    private:
+        wxChartGridMapping m_mapping;
+        wxVector<Candlestick::ptr> m_candlesticks;
+        // The pool used to compute the positions in
+        // parallel, may be 0
+        wxChartThreadPool *m_pool;
+        wxVector<wxPoint2DDouble> m_points;
+    };
+
 private:
     wxCandlestickChartOptions m_options;
     wxChartGrid m_grid;
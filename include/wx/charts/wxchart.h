@@ -27,12 +27,35 @@
 
 #include "wxchartoptions.h"
 #include "wxchartelement.h"
+#include "wxchartgraphicscache.h"
+#include "wxcharttooltipoptions.h"
 #include <wx/sharedptr.h>
+#include <wx/image.h>
+#include <wx/event.h>
+#include <wx/thread.h>
+
+class wxChartThreadPool;
+
+/// Sent by a chart to the handler passed to
+/// wxChart::DrawChart() when the positions of its
+/// elements have been computed on a background thread.
+/// The handler should call wxChart::ApplyBackgroundFit().
+wxDECLARE_EVENT(wxEVT_CHART_LAYOUT_READY, wxThreadEvent);
 
 class wxChart
 {
+    friend class wxChartSVGExporter;
+    friend class wxChartTiledExporter;
+
 public:
     wxChart();
+    /// Constructs a wxChart instance.
+    /// @param size The initial size of the chart.
+    wxChart(const wxSize &size);
+    /// Waits for the positions being computed on a
+    /// background thread, if any, before destroying
+    /// the chart.
+    virtual ~wxChart();
 
     /// Gets the options for the chart. Derived classes
     /// would typically change the signature of this method
@@ -40,23 +63,194 @@ public:
     /// @return The options.
     virtual const wxChartOptions& GetOptions() const = 0;
 
+    /// Gets the size the chart is laid out for.
+    /// @return The size of the chart.
+    const wxSize& GetSize() const;
     void SetSize(const wxSize &size);
+    /// Draws the chart and the tooltips of the active
+    /// elements.
+    /// @param gc The graphics context to draw on.
     void Draw(wxGraphicsContext &gc);
-    void ActivateElementsAt(const wxPoint &point);
+    /// Draws the chart without the tooltips. The result
+    /// only depends on the state of the chart so it can
+    /// be cached until GetRevision() changes.
+    /// @param gc The graphics context to draw on.
+    void DrawChart(wxGraphicsContext &gc);
+    /// Draws the chart without the tooltips. If the chart
+    /// has many elements and needs to be fitted again, the
+    /// positions of the elements may be computed on a
+    /// background thread while the previous positions are
+    /// drawn. In that case a wxEVT_CHART_LAYOUT_READY event
+    /// is queued to a handler once they are available,
+    /// see GetOptions().GetBackgroundFitThreshold().
+    /// @param gc The graphics context to draw on.
+    /// @param layoutHandler The handler the event is
+    /// queued to. It must outlive the chart.
+    void DrawChart(wxGraphicsContext &gc, wxEvtHandler &layoutHandler);
+    /// Replaces the positions of the elements by the
+    /// ones computed on a background thread. This must
+    /// be called on the thread the chart is drawn on.
+    /// @return true if the positions changed and the
+    /// chart needs to be drawn again, false otherwise.
+    bool ApplyBackgroundFit();
+    /// Draws the tooltips of the active elements.
+    /// @param gc The graphics context to draw on.
+    void DrawTooltips(wxGraphicsContext &gc);
+    /// Activates the elements located at a given
+    /// point. Active elements have their tooltips
+    /// displayed.
+    /// @param point The point.
+    /// @return true if the set of active elements
+    /// changed, false otherwise.
+    bool ActivateElementsAt(const wxPoint &point);
+
+    /// Gets a counter that is incremented each time
+    /// something that affects the output of DrawChart()
+    /// changes.
+    /// @return The current revision of the chart.
+    unsigned int GetRevision() const;
+
+    /// Renders the chart without a window. The chart is
+    /// laid out for the requested size and drawn, without
+    /// the tooltips, on a white background. The chart is
+    /// then laid out again for its previous size.
+    /// @param size The size of the image.
+    /// @return The image, check wxImage::IsOk() to know
+    /// whether the rendering succeeded.
+    wxImage RenderToImage(const wxSize &size);
+    /// Renders the chart without a window into memory
+    /// owned by the caller, see RenderToImage().
+    /// @param size The size of the image.
+    /// @param rgba The first row of the image. Each pixel
+    /// is written as 4 bytes: red, green, blue and alpha.
+    /// @param stride The number of bytes between the start
+    /// of two rows, at least 4 times the width.
+    /// @return true if the rendering succeeded, false
+    /// otherwise.
+    bool RenderToBuffer(const wxSize &size, unsigned char *rgba,
+        size_t stride);
+    /// Renders the chart without a window and saves the
+    /// result to a file, see RenderToImage().
+    /// @param filename The name of the file.
+    /// @param type The format of the file.
+    /// @param size The size of the image.
+    /// @return true if the file was saved, false otherwise.
+    bool Save(const wxString &filename, const wxBitmapType &type,
+        const wxSize &size);
+
+protected:
+    /// The positions of the elements of a chart, computed
+    /// without accessing the chart so that it can be done
+    /// on a background thread. Derived classes that have
+    /// many elements should implement one, see
+    /// CreateLayout().
+    class Layout
+    {
+    public:
+        virtual ~Layout();
+
+        /// Computes the positions. This may be called from
+        /// a background thread, it must only use data that
+        /// is not modified by the chart.
+        virtual void Compute() = 0;
+    };
 
 protected:
     void Fit();
-    void DrawTooltips(wxGraphicsContext &gc);
+    /// Makes sure the next call to DrawChart() without a
+    /// handler fits the chart on the calling thread if a
+    /// layout is being computed on a background thread.
+    /// That layout is then discarded. This is used before
+    /// exporting the chart since the export must show the
+    /// elements at their final positions.
+    void ForceSynchronousFit();
+    /// Signals that the chart needs to be fitted and
+    /// redrawn. Derived classes should call this when
+    /// their data or their axes change.
+    void Invalidate();
+    /// Deactivates all the elements. Derived classes
+    /// should call this when the elements returned by
+    /// GetActiveElements() may no longer exist.
+    void ResetActiveElements();
+    /// Gets the cache of the pens, brushes and fonts
+    /// used to draw the chart. Derived classes should
+    /// use it instead of creating these objects on
+    /// every draw.
+    /// @return The cache.
+    wxChartGraphicsCache& GetGraphicsCache();
+    /// Gets the pool that should be used to compute the
+    /// positions of the elements in parallel, see
+    /// wxChartOptions::GetParallelFitThreshold(). The
+    /// pool is shared by all the charts and created on
+    /// first use. Several threads can use it at the same
+    /// time, for instance to export charts in parallel.
+    /// @param numberOfElements The number of elements
+    /// whose positions are computed.
+    /// @return The pool, or 0 if the positions should be
+    /// computed by the calling thread alone.
+    wxChartThreadPool* GetFitPool(size_t numberOfElements);
 
 private:
     virtual void DoSetSize(const wxSize &size) = 0;
     virtual void DoFit() = 0;
+    /// Creates a layout capturing what is needed to fit
+    /// the chart for its current size. It is only called
+    /// when the chart could be fitted on a background
+    /// thread. The default implementation returns 0.
+    /// @return The layout, or 0 if the chart must be
+    /// fitted by DoFit() on the calling thread.
+    virtual Layout* CreateLayout();
+    /// Moves the elements to the positions computed by a
+    /// layout returned by CreateLayout(). The default
+    /// implementation does nothing.
+    /// @param layout The layout, Compute() has been
+    /// called.
+    virtual void ApplyLayout(Layout &layout);
     virtual void DoDraw(wxGraphicsContext &gc) = 0;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) = 0;
+    /// Gets the elements located at a given point.
+    /// @param point The point.
+    /// @param activeElements The list the elements are
+    /// appended to. It is always empty on entry.
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) = 0;
+
+private:
+    class LayoutTask;
+
+    void OnLayoutComputed(Layout *layout);
 
 private:
+    wxSize m_size;
     bool m_needsFit;
-    wxSharedPtr<wxVector<const wxChartElement*> > m_activeElements;
+    unsigned int m_revision;
+    // Whether DoFit() has been called at least once,
+    // until then there is nothing to draw while a
+    // layout is being computed
+    bool m_fitted;
+    // The handler passed to DrawChart(), only set
+    // while the chart is being drawn
+    wxEvtHandler *m_layoutHandler;
+    // Created the first time a layout is computed on
+    // a background thread
+    wxChartThreadPool *m_layoutPool;
+    bool m_layoutInProgress;
+    // Whether the chart was invalidated again while a
+    // layout was being computed
+    bool m_layoutQueued;
+    // Whether the chart was fitted synchronously while
+    // a layout was being computed
+    bool m_layoutDiscarded;
+    // Protects m_completedLayout
+    wxMutex m_layoutMutex;
+    Layout *m_completedLayout;
+    wxVector<const wxChartElement*> m_activeElements;
+    // Scratch buffer reused by ActivateElementsAt to
+    // avoid an allocation on every mouse move
+    wxVector<const wxChartElement*> m_candidateElements;
+    wxChartGraphicsCache m_graphicsCache;
+    // Kept so the font of the tooltips is only
+    // created once
+    wxChartTooltipOptions m_tooltipOptions;
 };
 
 #endif
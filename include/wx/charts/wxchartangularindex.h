@@ -0,0 +1,82 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTANGULARINDEX_H_
+#define _WX_CHARTS_WXCHARTANGULARINDEX_H_
+
+#include "wxchartarc.h"
+
+/// An index of arcs sharing the same center.
+
+/// This is used by the circular charts to hit test their
+/// slices. The angle and distance of the point from the
+/// center are computed once and, when the slices follow
+/// each other around the circle, a binary search on their
+/// angles finds the few slices that need to be hit tested.
+/// Otherwise all the slices are hit tested.
+///
+/// The index doesn't own the arcs and must be rebuilt when
+/// they change.
+class wxChartAngularIndex
+{
+public:
+    /// Constructs an empty wxChartAngularIndex instance.
+    wxChartAngularIndex();
+
+    /// Removes all the arcs from the index.
+    /// @param center The center shared by the arcs that
+    /// will be added to the index.
+    void Clear(const wxPoint2DDouble &center);
+    /// Adds an arc to the index. The angles are the ones
+    /// passed to wxChartArc::SetAngles.
+    /// @param arc The arc.
+    /// @param startAngle The angle at which the arc starts.
+    /// @param endAngle The angle at which the arc ends.
+    void Add(const wxChartArc *arc, wxDouble startAngle,
+        wxDouble endAngle);
+
+    /// Appends the arcs that contain a given point. Arcs
+    /// are appended in the order in which they were added.
+    /// @param point The point.
+    /// @param elements The list the arcs are appended to.
+    /// The index must not be queried from several threads
+    /// at the same time.
+    void Query(const wxPoint &point,
+        wxVector<const wxChartElement*> &elements) const;
+
+private:
+    void AddCandidates(wxDouble angle, wxVector<size_t> &candidates) const;
+
+private:
+    wxPoint2DDouble m_center;
+    wxVector<const wxChartArc*> m_arcs;
+    wxVector<wxDouble> m_startAngles;
+    wxVector<wxDouble> m_endAngles;
+    bool m_isSorted;
+    // Scratch buffer used by Query, kept to avoid
+    // an allocation for every query
+    mutable wxVector<size_t> m_candidates;
+};
+
+#endif
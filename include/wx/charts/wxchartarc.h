@@ -37,6 +37,7 @@
 #define _WX_CHARTS_WXCHARTARC_H_
 
 #include "wxchartelement.h"
+#include "wxchartbatchrenderer.h"
 #include "wxchartarcoptions.h"
 #include <wx/graphics.h>
 
@@ -63,17 +64,31 @@ public:
 		const wxString &tooltip, const wxChartArcOptions &options);
 
 	virtual bool HitTest(const wxPoint &point) const;
+	/// Checks whether a point given in polar coordinates
+	/// relative to the center of the arc is inside the arc.
+	/// @param angle The angle of the point, in the range
+	/// [0, 2 * M_PI).
+	/// @param radialDistanceFromCenter The distance between the point
+	/// and the center of the arc.
+	/// @return true if the point is inside the arc.
+	bool HitTest(wxDouble angle, wxDouble radialDistanceFromCenter) const;
 
 	virtual wxPoint2DDouble GetTooltipPosition() const;
 
 	/// Draws the arc.
 	/// @param gc The graphics context.
 	void Draw(wxGraphicsContext &gc);
+	/// Adds the arc to a batch of shapes.
+	/// @param renderer The batch renderer.
+	void Draw(wxChartBatchRenderer &renderer) const;
 
 	/// Sets the center of the arc.
 	/// @param x The X coordinate of the center.
 	/// @param y The Y coordinate of the center.
 	void SetCenter(wxDouble x, wxDouble y);
+	/// Gets the center of the arc.
+	/// @return The center of the arc.
+	wxPoint2DDouble GetCenter() const;
 	/// Sets the start and end angles. The angles are measured
 	/// in radians, they start from the 3 o'clock position
 	/// and follow a clockwise direction.
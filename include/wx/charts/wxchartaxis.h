@@ -69,7 +69,8 @@ public:
 
 	/// Draws the axis.
 	/// @param gc The graphics context.
-	void Draw(wxGraphicsContext &gc);
+	/// @param cache The cache of the pens, brushes and fonts.
+	void Draw(wxGraphicsContext &gc, wxChartGraphicsCache &cache);
 
 	/// Updates the size of each label using the 
 	/// font details specified in the axis options
@@ -83,6 +84,10 @@ public:
 	/// Gets the labels.
 	/// @return The list of labels.
 	const wxChartLabelGroup& GetLabels() const;
+	/// Replaces the labels. New labels that have the
+	/// same text as one of the current labels take its
+	/// size so they don't need to be measured again.
+	/// @param labels The new labels.
 	void SetLabels(const wxVector<wxChartLabel> &labels);
 
 	wxPoint2DDouble CalculateLabelPosition(size_t index);
@@ -26,6 +26,7 @@
 #define _WX_CHARTS_WXCHARTBACKGROUND_H_
 
 #include "wxchartbackgroundoptions.h"
+#include "wxchartgraphicscache.h"
 #include <wx/graphics.h>
 
 /// Class to draw backgrounds for various chart elements.
@@ -38,6 +39,12 @@ public:
         wxGraphicsContext &gc);
     void Draw(wxDouble x, wxDouble y, wxDouble width, wxDouble height,
         wxGraphicsContext &gc);
+    /// Draws the background using a cached brush.
+    void Draw(const wxPoint2DDouble &position, const wxSize &size,
+        wxGraphicsContext &gc, wxChartGraphicsCache &cache);
+    /// Draws the background using a cached brush.
+    void Draw(wxDouble x, wxDouble y, wxDouble width, wxDouble height,
+        wxGraphicsContext &gc, wxChartGraphicsCache &cache);
 
 private:
     wxChartBackgroundOptions m_options;
@@ -0,0 +1,140 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTBATCHEXPORTER_H_
+#define _WX_CHARTS_WXCHARTBATCHEXPORTER_H_
+
+#include "wxchart.h"
+#include <wx/thread.h>
+#include <wx/sharedptr.h>
+#include <wx/vector.h>
+
+/// Renders many charts to files using several threads.
+
+/// The charts are not given to the exporter directly:
+/// each export has a factory that creates its chart on
+/// the worker thread that renders it. The chart is laid
+/// out for its target size, drawn into its own image
+/// backed graphics context, see wxChart::RenderToImage(),
+/// and deleted as soon as the file is saved. This way the
+/// charts are built in parallel and only the charts being
+/// rendered are in memory. The charts are rendered on a
+/// wxChartThreadPool. An export waits before starting a
+/// chart if the images of the charts being rendered would
+/// exceed the memory budget.
+///
+/// The factories are called from several threads at the
+/// same time. The image handlers for the requested formats
+/// must have been added before calling Run().
+class wxChartBatchExporter
+{
+public:
+    /// Creates the chart of an export.
+    class ChartFactory
+    {
+    public:
+        /// Smart pointer typedef.
+        typedef wxSharedPtr<ChartFactory> ptr;
+
+        virtual ~ChartFactory();
+
+        /// Creates the chart. This is called from one of
+        /// the worker threads, possibly at the same time as
+        /// the other factories of the exporter.
+        /// @param size The size of the image.
+        /// @return The chart, the exporter deletes it once
+        /// it has been saved. If NULL the export fails.
+        virtual wxChart* CreateChart(const wxSize &size) const = 0;
+    };
+
+    /// Constructs a wxChartBatchExporter instance.
+    /// @param numberOfThreads The number of worker threads,
+    /// 0 means one per processor.
+    /// @param memoryBudget The maximum number of bytes used
+    /// by the images being rendered at any given time. A
+    /// chart whose image is larger than the budget is
+    /// rendered on its own.
+    wxChartBatchExporter(unsigned int numberOfThreads = 0,
+        size_t memoryBudget = 256 * 1024 * 1024);
+
+    /// Adds a chart to the list of charts to export.
+    /// @param factory The factory that creates the chart
+    /// when it is exported.
+    /// @param size The size of the image.
+    /// @param filename The name of the file.
+    /// @param type The format of the file.
+    void Add(ChartFactory::ptr factory, const wxSize &size,
+        const wxString &filename, const wxBitmapType &type);
+    /// Gets the number of charts to export.
+    /// @return The number of charts.
+    size_t GetCount() const;
+    /// Removes all the charts.
+    void Clear();
+
+    /// Renders and saves all the charts. The function
+    /// returns when all the charts have been exported.
+    /// @return The number of charts that were successfully
+    /// exported.
+    size_t Run();
+    /// Whether a chart was successfully exported by the
+    /// last call to Run().
+    /// @param index The index of the chart.
+    /// @return true if the file was saved, false otherwise.
+    bool Succeeded(size_t index) const;
+
+    /// Gets an estimate of the memory needed to render a
+    /// chart, it includes the image and the surface used
+    /// by the graphics context.
+    /// @param size The size of the image.
+    /// @return The number of bytes.
+    static size_t GetMemoryRequirement(const wxSize &size);
+
+private:
+    struct Job
+    {
+        Job(ChartFactory::ptr factory, const wxSize &size,
+            const wxString &filename, const wxBitmapType &type);
+
+        ChartFactory::ptr m_factory;
+        wxSize m_size;
+        wxString m_filename;
+        wxBitmapType m_type;
+        bool m_succeeded;
+    };
+
+    class ExportTask;
+
+    void ReserveMemory(size_t bytes);
+    void ReleaseMemory(size_t bytes);
+
+private:
+    unsigned int m_numberOfThreads;
+    size_t m_memoryBudget;
+    wxVector<Job> m_jobs;
+    wxMutex m_mutex;
+    wxCondition m_memoryReleased;
+    size_t m_memoryInUse;
+};
+
+#endif
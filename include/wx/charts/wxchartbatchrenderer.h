@@ -0,0 +1,156 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTBATCHRENDERER_H_
+#define _WX_CHARTS_WXCHARTBATCHRENDERER_H_
+
+#include "wxchartgraphicscache.h"
+#include <wx/graphics.h>
+#include <wx/hashmap.h>
+#include <wx/vector.h>
+
+/// Draws many shapes with as few state changes as possible.
+
+/// Consecutive shapes that share the same style are
+/// accumulated into one path that is filled and stroked
+/// with a single pen and brush when the style changes or
+/// when the batch is flushed. All the fills of a batch
+/// are drawn before its outlines, so only shapes that
+/// don't overlap are merged: the batch is flushed before
+/// a filled shape whose bounds, outline included,
+/// intersect the bounds of a filled shape already in the
+/// batch. The result is the same as drawing the shapes
+/// one at a time, whether the fill is opaque or not.
+/// Lines are not taken into account and are drawn on
+/// top of all the fills of their batch.
+///
+/// The charts draw all the elements of a dataset through
+/// one renderer so that drawing thousands of points or
+/// bars doesn't create thousands of pens, brushes and
+/// paths.
+class wxChartBatchRenderer
+{
+public:
+    /// Constructs a wxChartBatchRenderer instance.
+    /// @param gc The graphics context to draw on.
+    wxChartBatchRenderer(wxGraphicsContext &gc);
+    /// Constructs a wxChartBatchRenderer instance that
+    /// gets its pens and brushes from a cache.
+    /// @param gc The graphics context to draw on.
+    /// @param cache The cache of the pens, brushes and fonts.
+    wxChartBatchRenderer(wxGraphicsContext &gc, wxChartGraphicsCache &cache);
+    /// Flushes the current batch.
+    ~wxChartBatchRenderer();
+
+    /// Gets the graphics context the shapes are drawn on.
+    /// @return The graphics context.
+    wxGraphicsContext& GetGraphicsContext();
+
+    /// Sets the style of the shapes that are added next.
+    /// The shapes are filled and outlined.
+    /// @param fillColor The color of the brush.
+    /// @param strokeColor The color of the pen.
+    /// @param strokeWidth The width of the pen.
+    void SetStyle(const wxColor &fillColor,
+        const wxColor &strokeColor, unsigned int strokeWidth);
+    /// Sets the style of the shapes that are added next.
+    /// The shapes are only outlined.
+    /// @param strokeColor The color of the pen.
+    /// @param strokeWidth The width of the pen.
+    void SetStrokeStyle(const wxColor &strokeColor,
+        unsigned int strokeWidth);
+
+    /// Adds a circle to the batch.
+    /// @param x The X coordinate of the center.
+    /// @param y The Y coordinate of the center.
+    /// @param radius The radius of the circle.
+    void AddCircle(wxDouble x, wxDouble y, wxDouble radius);
+    /// Adds a rectangle to the batch.
+    /// @param x The X coordinate of the top left corner.
+    /// @param y The Y coordinate of the top left corner.
+    /// @param width The width of the rectangle.
+    /// @param height The height of the rectangle.
+    /// @param directions The sides of the rectangle that
+    /// are outlined, a combination of wxTOP, wxRIGHT,
+    /// wxBOTTOM and wxLEFT.
+    void AddRectangle(wxDouble x, wxDouble y, wxDouble width,
+        wxDouble height, int directions = wxALL);
+    /// Adds an arc to the batch. If the inner radius is
+    /// 0 the arc is a pie slice, otherwise it is a slice
+    /// of a ring.
+    /// @param x The X coordinate of the center.
+    /// @param y The Y coordinate of the center.
+    /// @param startAngle The start angle in radians.
+    /// @param endAngle The end angle in radians.
+    /// @param outerRadius The outer radius.
+    /// @param innerRadius The inner radius.
+    void AddArc(wxDouble x, wxDouble y, wxDouble startAngle,
+        wxDouble endAngle, wxDouble outerRadius, wxDouble innerRadius);
+    /// Adds a line to the batch. Lines are only stroked.
+    /// @param start The start of the line.
+    /// @param end The end of the line.
+    void AddLine(const wxPoint2DDouble &start, const wxPoint2DDouble &end);
+
+    /// Draws the shapes accumulated so far.
+    void Flush();
+
+private:
+    // Flushes the batch if a shape with the given bounds
+    // would overlap one of the shapes already in it and
+    // then adds the bounds to the batch
+    void AddBounds(wxDouble x, wxDouble y, wxDouble width, wxDouble height);
+    bool Intersects(const wxRect2DDouble &bounds) const;
+    void StrokeLine(const wxPoint2DDouble &start, const wxPoint2DDouble &end);
+    void ChangeStyle(bool filled, const wxColor &fillColor,
+        const wxColor &strokeColor, unsigned int strokeWidth);
+
+private:
+    wxGraphicsContext &m_gc;
+    // Only used if no cache was given
+    wxChartGraphicsCache m_ownCache;
+    wxChartGraphicsCache &m_cache;
+    wxGraphicsPath m_fillPath;
+    wxGraphicsPath m_strokePath;
+    bool m_isEmpty;
+    bool m_hasStyle;
+    bool m_filled;
+    wxColor m_fillColor;
+    wxColor m_strokeColor;
+    unsigned int m_strokeWidth;
+
+    WX_DECLARE_HASH_MAP(long, wxVector<size_t>, wxIntegerHash, wxIntegerEqual, CellMap);
+
+    // The bounds of the filled shapes of the batch
+    wxVector<wxRect2DDouble> m_bounds;
+    // The indices of the bounds in m_bounds that
+    // intersect each cell of a grid, cells are
+    // identified by a hash of their coordinates
+    CellMap m_cells;
+    wxDouble m_cellSize;
+    // The indices of the bounds that span too many
+    // cells to be added to the grid
+    wxVector<size_t> m_largeBounds;
+};
+
+#endif
@@ -26,6 +26,7 @@
 #define _WX_CHARTS_WXCHARTCIRCLE_H_
 
 #include "wxchartelement.h"
+#include "wxchartbatchrenderer.h"
 #include "wxchartcircleoptions.h"
 
 /// This class is used to draw a circle on the chart.
@@ -43,6 +44,9 @@ public:
     /// Draws the arc.
     /// @param gc The graphics context.
     void Draw(wxGraphicsContext &gc);
+    /// Adds the circle to a batch of shapes.
+    /// @param renderer The batch renderer.
+    void Draw(wxChartBatchRenderer &renderer) const;
 
     /// Sets the center of the circle.
     /// @param x The X coordinate of the center.
@@ -52,6 +56,12 @@ public:
     /// @param position The new center of the circle.
     void SetCenter(wxPoint2DDouble center);
     void SetRadius(wxDouble radius);
+    /// Gets the center of the circle.
+    /// @return The center of the circle.
+    wxPoint2DDouble GetCenter() const;
+    /// Gets the radius of the circle.
+    /// @return The radius of the circle.
+    wxDouble GetRadius() const;
 
 private:
     wxChartCircleOptions m_options;
@@ -27,6 +27,7 @@
 
 #include "wxchart.h"
 #include <wx/control.h>
+#include <wx/bitmap.h>
 
 /// Base class for the chart controls.
 
@@ -56,10 +57,22 @@ public:
 private:
     virtual wxChart& GetChart() = 0;
 
+    bool IsChartLayerValid(const wxSize &size);
+    void UpdateChartLayer(const wxSize &size);
+
     void OnPaint(wxPaintEvent &evt);
 	void OnSize(wxSizeEvent &evt);
+    void OnLayoutReady(wxThreadEvent &evt);
 	void OnMouseOver(wxMouseEvent &evt);
 
+private:
+    // The chart drawn without the tooltips. It is
+    // blitted on every paint so that only the tooltips
+    // need to be redrawn when the mouse moves.
+    wxBitmap m_chartLayer;
+    bool m_chartLayerIsValid;
+    unsigned int m_chartLayerRevision;
+
 	DECLARE_EVENT_TABLE();
 };
 
@@ -0,0 +1,105 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTDOWNSAMPLING_H_
+#define _WX_CHARTS_WXCHARTDOWNSAMPLING_H_
+
+#include <wx/geometry.h>
+#include <wx/vector.h>
+
+/// The methods that can be used to reduce the number
+/// of vertices of a line before it is drawn.
+enum wxChartDownsamplingMode
+{
+    /// Every point is part of the line.
+    wxCHARTDOWNSAMPLINGMODE_NONE = 0,
+    /// The line is reduced to a few points per pixel
+    /// column using the Largest-Triangle-Three-Buckets
+    /// algorithm. The shape of the line is preserved but
+    /// some extreme values may be skipped.
+    wxCHARTDOWNSAMPLINGMODE_LTTB = 1,
+    /// For each pixel column only the first, last, lowest
+    /// and highest points are kept. The line is drawn
+    /// exactly as if all the points were used.
+    wxCHARTDOWNSAMPLINGMODE_M4 = 2,
+    /// The lowest and highest points of each pixel are
+    /// read from a min/max pyramid built once for each
+    /// dataset and only the visible part of the data is
+    /// processed. Picking the points of the line then has
+    /// a cost that doesn't depend on the number of points,
+    /// the visible points are still all positioned so their
+    /// dots can be drawn and hovered. This requires
+    /// the points to be sorted by X and is only supported by
+    /// wxMath2DPlot. In other cases wxCHARTDOWNSAMPLINGMODE_M4
+    /// is used instead.
+    wxCHARTDOWNSAMPLINGMODE_MINMAXPYRAMID = 3
+};
+
+/// This class contains the functions used to
+/// downsample the lines of the charts.
+
+/// The functions work on window coordinates so the
+/// result only depends on how the points are laid
+/// out on screen. It needs to be recomputed when the
+/// chart is resized or zoomed but not when it is
+/// just redrawn.
+class wxChartDownsampling
+{
+public:
+    /// Gets the number of points a line should be reduced
+    /// to so it still looks the same on screen.
+    /// @param width The width of the plot area in pixels.
+    /// @return The number of points.
+    static size_t GetThreshold(wxDouble width);
+
+    /// Reduces a line using the Largest-Triangle-Three-Buckets
+    /// algorithm. The points are split into buckets of
+    /// consecutive points and the point of each bucket that
+    /// forms the largest triangle with the previously selected
+    /// point and the average of the next bucket is kept. The
+    /// first and last points are always kept.
+    /// @param points The points of the line.
+    /// @param threshold The number of points to keep.
+    /// @param result When the function returns this contains
+    /// the selected points in the same order as in points.
+    /// If there are fewer points than threshold they are all
+    /// copied.
+    static void LargestTriangleThreeBuckets(const wxVector<wxPoint2DDouble> &points,
+        size_t threshold, wxVector<wxPoint2DDouble> &result);
+
+    /// Reduces a line by keeping, for each run of consecutive
+    /// points that fall in the same pixel column, the first,
+    /// last, lowest and highest points. The segments between
+    /// the removed points are all covered by the segments
+    /// between the points that are kept so the rasterized
+    /// line is the same. At most 4 points per pixel column
+    /// are kept.
+    /// @param points The points of the line.
+    /// @param result When the function returns this contains
+    /// the selected points in the same order as in points.
+    static void M4(const wxVector<wxPoint2DDouble> &points,
+        wxVector<wxPoint2DDouble> &result);
+};
+
+#endif
@@ -60,9 +60,10 @@ public:
 	/// @return Whether the mouse is in the activation zone.
 	virtual bool HitTest(const wxPoint &point) const = 0;
 
-	/// Gets the tooltip provider.
+	/// Gets the tooltip provider. Derived classes can
+	/// override this to create the provider on demand.
 	/// @return The tooltip provider.
-	const wxChartTooltipProvider::ptr GetTooltipProvider() const;
+	virtual const wxChartTooltipProvider::ptr GetTooltipProvider() const;
 	/// Gets the position of the tooltip.
 	/// @return The position of the tooltip.
 	virtual wxPoint2DDouble GetTooltipPosition() const = 0;
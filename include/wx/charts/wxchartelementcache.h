@@ -0,0 +1,82 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTELEMENTCACHE_H_
+#define _WX_CHARTS_WXCHARTELEMENTCACHE_H_
+
+#include "wxchartelement.h"
+#include <wx/vector.h>
+
+/// Holds the elements that a chart creates on demand.
+
+/// Charts that store their data in arrays only create
+/// wxChartElement instances for the points that are
+/// returned by wxChart::GetActiveElements. Active
+/// elements are compared by address so the same element
+/// must be returned for as long as a point remains active.
+///
+/// The lookups are organized in passes, typically one per
+/// call to GetActiveElements. Elements that are not looked
+/// up during a pass are released at the start of the next
+/// one so that they are never in use when their memory can
+/// be reused.
+class wxChartElementCache
+{
+public:
+    /// Constructs an empty wxChartElementCache instance.
+    wxChartElementCache();
+
+    /// Starts a new pass.
+    void StartPass();
+    /// Gets the element of a point if it was created during
+    /// the current pass or the previous one.
+    /// @param dataset The index of the dataset the point
+    /// belongs to.
+    /// @param index The index of the point in the dataset.
+    /// @return The element or NULL if there is none.
+    const wxChartElement* Get(size_t dataset, size_t index);
+    /// Adds the element of a point to the cache.
+    /// @param dataset The index of the dataset the point
+    /// belongs to.
+    /// @param index The index of the point in the dataset.
+    /// @param element The element. The cache takes ownership
+    /// of it.
+    /// @return The element.
+    const wxChartElement* Add(size_t dataset, size_t index,
+        wxChartElement *element);
+
+private:
+    struct Entry
+    {
+        size_t dataset;
+        size_t index;
+        wxSharedPtr<wxChartElement> element;
+    };
+
+private:
+    wxVector<Entry> m_current;
+    wxVector<Entry> m_previous;
+};
+
+#endif
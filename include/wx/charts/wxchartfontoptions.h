@@ -46,7 +46,16 @@ public:
 		wxFontStyle style, wxFontWeight weight,
 		const wxColor &color);
 
-	wxFont GetFont() const;
+	/// Gets the font. The font is only created the
+	/// first time this is called.
+	/// @return The font.
+	const wxFont& GetFont() const;
+	/// Gets the native description of the font, used
+	/// to identify it in wxChartTextExtentCache. The
+	/// description is only built the first time this
+	/// is called.
+	/// @return The description of the font.
+	const wxString& GetFontDescription() const;
 
 	/// Gets the font family.
 	/// @return The font family.
@@ -70,6 +79,8 @@ private:
 	wxFontStyle m_style;
 	wxFontWeight m_weight;
 	wxColor m_color;
+	mutable wxFont m_font;
+	mutable wxString m_fontDescription;
 };
 
 #endif
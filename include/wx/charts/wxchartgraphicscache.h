@@ -0,0 +1,117 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTGRAPHICSCACHE_H_
+#define _WX_CHARTS_WXCHARTGRAPHICSCACHE_H_
+
+#include "wxchartfontoptions.h"
+#include <wx/graphics.h>
+#include <wx/vector.h>
+
+/// A cache of the pens, brushes and fonts used to draw
+/// a chart.
+
+/// Setting a wxPen, wxBrush or wxFont on a graphics
+/// context converts it to a native object every time.
+/// This cache creates the native object the first time
+/// a given style is used and returns the same object
+/// on the following draws.
+///
+/// The objects are keyed by the full style so a change
+/// in the options simply results in a new entry. The
+/// objects belong to the renderer of the graphics
+/// context they were created with, the cache is cleared
+/// if it is used with a context from another renderer
+/// or with another resolution.
+class wxChartGraphicsCache
+{
+public:
+    /// Constructs an empty wxChartGraphicsCache instance.
+    wxChartGraphicsCache();
+
+    /// Gets a pen.
+    /// @param gc The graphics context the pen will be
+    /// used with.
+    /// @param color The color of the pen.
+    /// @param width The width of the pen.
+    /// @return The pen.
+    wxGraphicsPen GetPen(wxGraphicsContext &gc,
+        const wxColor &color, unsigned int width);
+    /// Gets a brush.
+    /// @param gc The graphics context the brush will be
+    /// used with.
+    /// @param color The color of the brush.
+    /// @return The brush.
+    wxGraphicsBrush GetBrush(wxGraphicsContext &gc,
+        const wxColor &color);
+    /// Gets a font, including its color.
+    /// @param gc The graphics context the font will be
+    /// used with.
+    /// @param options The font settings.
+    /// @return The font.
+    wxGraphicsFont GetFont(wxGraphicsContext &gc,
+        const wxChartFontOptions &options);
+
+    /// Removes all the objects from the cache.
+    void Clear();
+
+private:
+    void CheckRenderer(wxGraphicsContext &gc);
+
+private:
+    struct Pen
+    {
+        Pen(const wxColor &color, unsigned int width,
+            const wxGraphicsPen &pen);
+
+        wxColor m_color;
+        unsigned int m_width;
+        wxGraphicsPen m_pen;
+    };
+
+    struct Brush
+    {
+        Brush(const wxColor &color, const wxGraphicsBrush &brush);
+
+        wxColor m_color;
+        wxGraphicsBrush m_brush;
+    };
+
+    struct Font
+    {
+        Font(const wxChartFontOptions &options, const wxGraphicsFont &font);
+
+        wxChartFontOptions m_options;
+        wxGraphicsFont m_font;
+    };
+
+    wxGraphicsRenderer *m_renderer;
+    wxDouble m_dpiX;
+    wxDouble m_dpiY;
+    wxVector<Pen> m_pens;
+    wxVector<Brush> m_brushes;
+    wxVector<Font> m_fonts;
+};
+
+#endif
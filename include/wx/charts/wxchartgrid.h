@@ -113,7 +113,8 @@ public:
 
     /// Draws the grid.
     /// @param gc The graphics context.
-    void Draw(wxGraphicsContext &gc);
+    /// @param cache The cache of the pens, brushes and fonts.
+    void Draw(wxGraphicsContext &gc, wxChartGraphicsCache &cache);
 
     /// Resizes the grid.
     /// @param size The new size of the area where the grid
@@ -125,20 +126,68 @@ public:
     /// @return The grid mapping.
     const wxChartGridMapping& GetMapping() const;
 
+    /// Replaces the labels of the X axis. This can only
+    /// be used on a grid whose X axis was specified by
+    /// labels.
+    /// @param labels The new labels of the X axis.
+    void SetXLabels(const wxVector<wxString> &labels);
+    /// Changes the range of values that need to be
+    /// displayed on the Y axis. The Y axis is only rebuilt
+    /// if the tick marks computed for the new range are
+    /// different from the current ones.
+    /// @param minYValue The minimum of the values that
+    /// will be shown on the chart for the Y coordinate.
+    /// @param maxYValue The maximum of the values that
+    /// will be shown on the chart for the Y coordinate.
+    /// @return true if the Y axis was rebuilt, false
+    /// otherwise.
+    bool SetYRange(wxDouble minYValue, wxDouble maxYValue);
+    /// Changes the ranges of values that need to be
+    /// displayed on the X and Y axes. This can only be
+    /// used on a grid whose X axis is numerical. The axes
+    /// are only rebuilt if the tick marks computed for
+    /// the new ranges are different from the current ones.
+    /// This also becomes the range restored when the
+    /// zoom is reset. If the user has zoomed or panned
+    /// the current viewport is kept until the zoom is
+    /// reset.
+    /// @param minXValue The minimum of the values that
+    /// will be shown on the chart for the X coordinate.
+    /// @param maxXValue The maximum of the values that
+    /// will be shown on the chart for the X coordinate.
+    /// @param minYValue The minimum of the values that
+    /// will be shown on the chart for the Y coordinate.
+    /// @param maxYValue The maximum of the values that
+    /// will be shown on the chart for the Y coordinate.
+    /// @return true if one of the axes was rebuilt, false
+    /// otherwise.
+    bool SetRange(wxDouble minXValue, wxDouble maxXValue,
+        wxDouble minYValue, wxDouble maxYValue);
+
     bool Scale(int coeff);
     void Shift(double dx,double dy);
 
 private:
     static wxChartAxis::ptr CreateNumericalAxis(wxDouble minValue, wxDouble maxValue,
         const wxChartAxisOptions &options);
+    static void CalculateAxisRange(wxDouble minValue, wxDouble maxValue,
+        const wxChartAxisOptions &options, wxDouble &graphMinValue,
+        wxDouble &graphMaxValue, size_t &steps, wxDouble &stepValue);
+    static bool UpdateNumericalAxis(wxChartAxis &axis, wxDouble minValue,
+        wxDouble maxValue, const wxChartAxisOptions &options);
     void Fit(wxGraphicsContext &gc);
-    void Update();
+    bool Update();
     void CalculatePadding(const wxChartAxis &xAxis,
         const wxChartAxis &yAxis, wxDouble &left, wxDouble &right);
-    static void DrawHorizontalGridLines(const wxChartAxis &horizontalAxis, const wxChartAxis &verticalAxis,
-        const wxChartGridLineOptions &options, wxGraphicsContext &gc);
-    static void DrawVerticalGridLines(const wxChartAxis &horizontalAxis, const wxChartAxis &verticalAxis,
-        const wxChartGridLineOptions &options, wxGraphicsContext &gc);
+    static void AddHorizontalGridLines(const wxChartAxis &horizontalAxis, const wxChartAxis &verticalAxis,
+        const wxChartGridLineOptions &options, wxGraphicsPath &majorLines,
+        wxGraphicsPath &minorLines);
+    static void AddVerticalGridLines(const wxChartAxis &horizontalAxis, const wxChartAxis &verticalAxis,
+        const wxChartGridLineOptions &options, wxGraphicsPath &majorLines,
+        wxGraphicsPath &minorLines);
+    static void StrokeGridLines(const wxChartGridLineOptions &options,
+        const wxGraphicsPath &majorLines, const wxGraphicsPath &minorLines,
+        wxGraphicsContext &gc, wxChartGraphicsCache &cache);
 
 private:
     struct AxisLimits
@@ -161,8 +210,20 @@ private:
     // Whether something has changed and we
     // need to rearrange the chart
     bool m_needsFit;
+    // All the major and all the minor grid lines in
+    // a single path each, rebuilt on the next draw
+    // after the grid has been refitted
+    wxGraphicsPath m_horizontalMajorLines;
+    wxGraphicsPath m_horizontalMinorLines;
+    wxGraphicsPath m_verticalMajorLines;
+    wxGraphicsPath m_verticalMinorLines;
+    bool m_gridLinesValid;
+    wxGraphicsRenderer *m_gridLinesRenderer;
     AxisLimits m_curAxisLimits;
     AxisLimits m_origAxisLimits;
+    // Whether Scale() or Shift() moved the viewport away
+    // from m_origAxisLimits
+    bool m_viewportChanged;
 };
 
 #endif
@@ -46,14 +46,29 @@ public:
 	wxChartGridMapping(const wxSize &size,
 		const wxChartAxis::ptr xAxis, const wxChartAxis::ptr yAxis);
 
+	/// Creates a copy of the mapping that doesn't share
+	/// its axes with this one. The copy can be used on
+	/// another thread while the grid keeps updating the
+	/// original axes.
+	/// @return The copy.
+	wxChartGridMapping Clone() const;
+
 	const wxSize& GetSize() const;
 	void SetSize(const wxSize &size);
 
     wxPoint2DDouble GetWindowPosition(wxDouble x, wxDouble y) const;
 	wxPoint2DDouble GetWindowPositionAtTickMark(size_t index, wxDouble value) const;
+	/// Gets the area of the window between the minimum
+	/// and maximum values of the axes. Anything drawn
+	/// outside of it is not visible on the grid.
+	/// @return The area covered by the axes.
+	wxRect2DDouble GetPlotArea() const;
 	
 	const wxChartAxis& GetXAxis() const;
-	
+
+private:
+	static wxChartAxis::ptr CloneAxis(const wxChartAxis &axis);
+
 private:
 	wxSize m_size;
 	wxChartAxis::ptr m_XAxis;
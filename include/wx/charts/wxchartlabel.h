@@ -28,6 +28,7 @@
 #include "wxchartelement.h"
 #include "wxchartlabeloptions.h"
 #include "wxchartpadding.h"
+#include "wxchartgraphicscache.h"
 #include <wx/graphics.h>
 #include <wx/string.h>
 
@@ -62,6 +63,10 @@ public:
 	/// Draws the label.
 	/// @param gc The graphics context.
 	void Draw(wxGraphicsContext &gc) const;
+	/// Draws the label using a cached font.
+	/// @param gc The graphics context.
+	/// @param cache The cache of the pens, brushes and fonts.
+	void Draw(wxGraphicsContext &gc, wxChartGraphicsCache &cache) const;
 
 	/// Gets the text of the label.
 	/// @return The text of the label.
@@ -33,8 +33,19 @@ class wxChartLabelGroup : public wxVector<wxChartLabel>
 public:
     wxChartLabelGroup();
 
-    void Draw(wxGraphicsContext &gc);
+    /// Draws the labels.
+    /// @param gc The graphics context.
+    /// @param cache The cache of the pens, brushes and fonts.
+    void Draw(wxGraphicsContext &gc, wxChartGraphicsCache &cache);
 
+    /// Measures the labels whose size is not known
+    /// yet. A label that has been measured has a non
+    /// zero height so labels that keep the same text
+    /// are only measured once. All the labels are
+    /// measured again if the renderer or the resolution
+    /// of the graphics context changed since the last
+    /// call. The font of a label can't change.
+    /// @param gc The graphics context.
     void UpdateSizes(wxGraphicsContext &gc);
 
     /// Gets the width of the widest label. Note that
@@ -46,6 +57,10 @@ public:
 
 private:
     wxDouble m_maxWidth;
+    // What the sizes were measured with
+    wxGraphicsRenderer *m_renderer;
+    wxDouble m_dpiX;
+    wxDouble m_dpiY;
 };
 
 #endif
@@ -27,6 +27,7 @@
 
 #include "wxchartelement.h"
 #include "wxchartlegendlineoptions.h"
+#include "wxchartgraphicscache.h"
 
 /// This class is used to draw a line in a legend.
 
@@ -51,6 +52,11 @@ public:
 	/// Draws the legend line.
 	/// @param gc The graphics context.
 	void Draw(wxGraphicsContext &gc);
+	/// Draws the legend line using a cached font
+	/// and brushes.
+	/// @param gc The graphics context.
+	/// @param cache The cache of the pens, brushes and fonts.
+	void Draw(wxGraphicsContext &gc, wxChartGraphicsCache &cache);
 
 	const wxPoint2DDouble& GetPosition() const;
 	void SetPosition(wxDouble x, wxDouble y);
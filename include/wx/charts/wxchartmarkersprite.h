@@ -0,0 +1,78 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTMARKERSPRITE_H_
+#define _WX_CHARTS_WXCHARTMARKERSPRITE_H_
+
+#include "wxchartpointoptions.h"
+#include <wx/graphics.h>
+#include <wx/image.h>
+#include <wx/vector.h>
+
+/// A point marker that is rendered once and then
+/// stamped at the position of each point.
+
+/// Filling and stroking a circle for every point is
+/// expensive when there are hundreds of thousands of
+/// points. The sprite draws the marker into a small
+/// image with an alpha channel the first time it is
+/// used and then draws that image at the position of
+/// each point, rounded to the nearest pixel. If the
+/// marker is opaque, points that round to the same
+/// pixel are only stamped once. Translucent markers
+/// are stamped for every point so that dense clusters
+/// look the same as when the shapes are drawn.
+class wxChartMarkerSprite
+{
+public:
+    /// Constructs a wxChartMarkerSprite instance.
+    /// @param radius The radius of the circle used to
+    /// represent the points.
+    /// @param options The settings of the points.
+    wxChartMarkerSprite(wxDouble radius, const wxChartPointOptions &options);
+
+    /// Draws the marker at a list of positions.
+    /// @param gc The graphics context.
+    /// @param positions The centers of the markers.
+    void Draw(wxGraphicsContext &gc,
+        const wxVector<wxPoint2DDouble> &positions);
+
+private:
+    void Rasterize();
+
+private:
+    wxDouble m_radius;
+    wxChartPointOptions m_options;
+    wxImage m_image;
+    // The distance between the center of the marker
+    // and the edges of the image, 0 until the marker
+    // has been rasterized
+    int m_halfSize;
+    // One entry per pixel of the area that can be drawn
+    // on, used to skip the positions that were already
+    // stamped
+    wxVector<unsigned char> m_stamped;
+};
+
+#endif
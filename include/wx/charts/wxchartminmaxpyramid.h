@@ -0,0 +1,123 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTMINMAXPYRAMID_H_
+#define _WX_CHARTS_WXCHARTMINMAXPYRAMID_H_
+
+#include "wxchartringbuffer.h"
+#include <wx/geometry.h>
+
+/// A multi-resolution summary of the Y values of a
+/// list of points.
+
+/// Each level splits the points into buckets of
+/// consecutive points and stores the indices of the
+/// lowest and highest point of each bucket. The size
+/// of the buckets doubles from one level to the next.
+/// This makes it possible to pick the points that
+/// need to be drawn for any range of points at a cost
+/// that only depends on the number of buckets
+/// requested, not on the number of points in the
+/// range.
+///
+/// The buckets are aligned on the position of the
+/// points since the pyramid was cleared, not on their
+/// index in the list. When the oldest points are
+/// discarded from a full ring buffer only the buckets
+/// at both ends of the list need to be recomputed.
+class wxChartMinMaxPyramid
+{
+public:
+    /// Constructs an empty wxChartMinMaxPyramid instance.
+    wxChartMinMaxPyramid();
+
+    /// Updates the pyramid after points have been added
+    /// to the end of the list or discarded from its start.
+    /// Only the buckets containing the points that were
+    /// added and the first bucket, if points were
+    /// discarded from it, are recomputed.
+    /// @param points The points.
+    /// @param firstPosition The number of points discarded
+    /// from the start of the list since the pyramid was
+    /// cleared.
+    void Update(const wxChartRingBuffer<wxPoint2DDouble> &points,
+        size_t firstPosition);
+    /// Removes all the levels. The next update rebuilds
+    /// the whole pyramid.
+    void Clear();
+
+    /// Selects the points that need to be drawn to show a
+    /// range of points when about one bucket fits in each
+    /// pixel. The level with the smallest buckets that still
+    /// produces no more than the requested number of buckets
+    /// is used. The first and last points of the range are
+    /// always selected.
+    /// @param first The index of the first point of the range.
+    /// @param last The index of the point after the last point
+    /// of the range.
+    /// @param buckets The number of buckets the range should be
+    /// split into, usually the width of the plot in pixels.
+    /// @param indices The indices of the selected points are
+    /// appended to this list in increasing order.
+    void Select(size_t first, size_t last, size_t buckets,
+        wxVector<size_t> &indices) const;
+
+private:
+    struct Bucket
+    {
+        Bucket();
+        Bucket(size_t minIndex, size_t maxIndex);
+
+        // The positions of the points, not their
+        // index in the list
+        size_t m_minIndex;
+        size_t m_maxIndex;
+    };
+
+    struct Level
+    {
+        Level();
+
+        // The buckets before the one containing the first
+        // point are only erased once they make up half of
+        // the vector
+        wxVector<Bucket> m_buckets;
+        // The number of the bucket in m_buckets[0]
+        size_t m_first;
+    };
+
+    void UpdateBucket(const wxChartRingBuffer<wxPoint2DDouble> &points,
+        size_t level, size_t bucket);
+
+private:
+    // The buckets of m_levels[i] contain
+    // 2^(i + FirstLevel) points
+    wxVector<Level> m_levels;
+    // The position of the first point and of the point
+    // after the last one at the last update
+    size_t m_begin;
+    size_t m_end;
+};
+
+#endif
@@ -52,6 +52,10 @@ public:
 	/// in as argument.
 	/// @param gc The graphics context.
 	void Draw(wxGraphicsContext &gc);
+	/// Draws the tooltip using cached fonts and brushes.
+	/// @param gc The graphics context.
+	/// @param cache The cache of the pens, brushes and fonts.
+	void Draw(wxGraphicsContext &gc, wxChartGraphicsCache &cache);
 
 	void AddTooltip(const wxChartTooltip &tooltip);
 
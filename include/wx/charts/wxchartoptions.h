@@ -69,12 +69,46 @@ public:
     /// @retval false No contextual menu is provided.
     bool IsSaveAsMenuEnabled() const;
 
+    /// Gets the number of elements above which the
+    /// positions of the elements are computed on a
+    /// background thread when a control resizes the
+    /// chart.
+    /// @return The threshold, 0 means the positions are
+    /// always computed on the calling thread.
+    size_t GetBackgroundFitThreshold() const;
+    /// Sets the number of elements above which the
+    /// positions of the elements are computed on a
+    /// background thread when a control resizes the
+    /// chart. Until the computation completes the
+    /// control keeps showing the previous positions.
+    /// The default is 100000.
+    /// @param threshold The threshold, 0 means the
+    /// positions are always computed on the calling
+    /// thread.
+    void SetBackgroundFitThreshold(size_t threshold);
+    /// Gets the number of elements above which the
+    /// positions of the elements are computed by
+    /// several threads, one per processor.
+    /// @return The threshold, 0 means the positions are
+    /// always computed by a single thread.
+    size_t GetParallelFitThreshold() const;
+    /// Sets the number of elements above which the
+    /// positions of the elements are computed by
+    /// several threads, one per processor. The result
+    /// is the same as with a single thread. The default
+    /// is 50000.
+    /// @param threshold The threshold, 0 means the
+    /// positions are always computed by a single thread.
+    void SetParallelFitThreshold(size_t threshold);
+
 private:
 	wxChartPadding m_padding;
 	bool m_responsive;
 	bool m_showTooltips;
     wxChartMultiTooltipOptions m_multiTooltipOptions;
     bool m_enableSaveAsMenu;
+    size_t m_backgroundFitThreshold;
+    size_t m_parallelFitThreshold;
 };
 
 #endif
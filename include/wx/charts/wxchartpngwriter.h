@@ -0,0 +1,93 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTPNGWRITER_H_
+#define _WX_CHARTS_WXCHARTPNGWRITER_H_
+
+#include <wx/stream.h>
+#include <wx/zstream.h>
+#include <wx/gdicmn.h>
+#include <wx/vector.h>
+
+/// Writes a PNG image band by band.
+
+/// wxImage can only save a PNG file once the whole image
+/// is in memory. This writer encodes the rows as they
+/// are provided so an image much larger than the
+/// available memory can be written as long as it is
+/// produced a few rows at a time.
+///
+/// The image is written as 8 bit RGB without alpha.
+class wxChartPNGWriter
+{
+public:
+    /// Constructs a wxChartPNGWriter instance and writes
+    /// the header of the image.
+    /// @param stream The stream the image is written to.
+    /// It must remain valid until Close() is called.
+    /// @param size The size of the image.
+    wxChartPNGWriter(wxOutputStream &stream, const wxSize &size);
+    ~wxChartPNGWriter();
+
+    /// Encodes rows of the image. The rows are provided
+    /// from top to bottom.
+    /// @param rgb The first row. Each pixel is 3 bytes:
+    /// red, green and blue.
+    /// @param stride The number of bytes between the start
+    /// of two rows.
+    /// @param numberOfRows The number of rows.
+    void WriteRows(const unsigned char *rgb, size_t stride,
+        size_t numberOfRows);
+    /// Writes the end of the image.
+    /// @return true if the image was written successfully
+    /// and all the rows were provided, false otherwise.
+    bool Close();
+
+private:
+    // Collects the output of the compressor until it can
+    // be written as a chunk
+    class DataBuffer : public wxOutputStream
+    {
+    public:
+        wxVector<unsigned char> m_data;
+
+    protected:
+        virtual size_t OnSysWrite(const void *buffer, size_t size) wxOVERRIDE;
+    };
+
+    void WriteChunk(const char *type, const unsigned char *data, size_t size);
+    void WriteImageData(bool force);
+
+private:
+    wxOutputStream &m_stream;
+    wxSize m_size;
+    size_t m_rowsWritten;
+    DataBuffer m_imageData;
+    wxZlibOutputStream *m_compressor;
+    // The filtered version of a row
+    wxVector<unsigned char> m_row;
+    bool m_closed;
+};
+
+#endif
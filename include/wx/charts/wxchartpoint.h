@@ -26,6 +26,7 @@
 #define _WX_CHARTS_WXCHARTPOINT_H_
 
 #include "wxchartelement.h"
+#include "wxchartbatchrenderer.h"
 #include "wxchartpointoptions.h"
 #include <wx/graphics.h>
 
@@ -56,6 +57,9 @@ public:
 	/// Draws the point.
 	/// @param gc The graphics context.
 	void Draw(wxGraphicsContext &gc);
+	/// Adds the point to a batch of shapes.
+	/// @param renderer The batch renderer.
+	void Draw(wxChartBatchRenderer &renderer) const;
 
 	/// Gets the position of the point.
 	/// @return The position of the point.
@@ -67,6 +71,10 @@ public:
 	/// Sets the position of the point.
 	/// @param position The new position of the point.
 	void SetPosition(wxPoint2DDouble position);
+	/// Gets the distance from the position of the point
+	/// within which HitTest succeeds.
+	/// @return The hit detection range.
+	wxDouble GetHitDetectionRange() const;
 
 private:
     wxChartPointOptions m_options;
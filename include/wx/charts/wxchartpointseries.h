@@ -0,0 +1,116 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTPOINTSERIES_H_
+#define _WX_CHARTS_WXCHARTPOINTSERIES_H_
+
+#include "wxchartpointoptions.h"
+#include "wxchartbatchrenderer.h"
+#include <wx/vector.h>
+
+/// A series of points that share the same settings.
+
+/// The positions of the points are stored in a single
+/// contiguous array instead of one wxChartPoint per point.
+/// This is used by the charts that can display a large
+/// number of points. The points are drawn and hit tested
+/// exactly like wxChartPoint does it.
+class wxChartPointSeries
+{
+public:
+    /// Constructs a wxChartPointSeries instance.
+    /// @param count The number of points. All the points
+    /// are initially positioned at (0, 0).
+    /// @param radius The radius of the circle used to
+    /// represent the points.
+    /// @param hitDetectionRange The distance from the
+    /// center of a point beyond which HitTest fails.
+    /// @param options The settings to be used for the
+    /// points.
+    wxChartPointSeries(size_t count, wxDouble radius,
+        wxDouble hitDetectionRange, const wxChartPointOptions &options);
+
+    /// Gets the number of points.
+    /// @return The number of points.
+    size_t GetCount() const;
+    /// Changes the number of points. Points that are
+    /// added are positioned at (0, 0).
+    /// @param count The new number of points.
+    void SetCount(size_t count);
+    /// Gets the position of a point.
+    /// @param index The index of the point.
+    /// @return The position of the point.
+    const wxPoint2DDouble& GetPosition(size_t index) const;
+    /// Gets the positions of all the points.
+    /// @return The positions of the points.
+    const wxVector<wxPoint2DDouble>& GetPositions() const;
+    /// Sets the position of a point.
+    /// @param index The index of the point.
+    /// @param position The new position of the point.
+    void SetPosition(size_t index, const wxPoint2DDouble &position);
+    /// Replaces the positions of all the points by
+    /// exchanging them with the content of a list.
+    /// @param positions The new positions of the points,
+    /// one per point. On return it contains the previous
+    /// positions.
+    void SwapPositions(wxVector<wxPoint2DDouble> &positions);
+
+    wxDouble GetRadius() const;
+    wxDouble GetHitDetectionRange() const;
+    const wxChartPointOptions& GetOptions() const;
+
+    /// Checks whether a point is within the hit detection
+    /// range of one of the points of the series.
+    /// @param index The index of the point of the series.
+    /// @param point The point to test.
+    /// @return Whether the point is in range.
+    bool HitTest(size_t index, const wxPoint &point) const;
+
+    /// Draws all the points. All the points are added
+    /// to a single batch.
+    /// @param renderer The batch renderer.
+    void Draw(wxChartBatchRenderer &renderer) const;
+    /// Draws the points that are visible in an area of
+    /// the window.
+    /// @param renderer The batch renderer.
+    /// @param clip The area outside of which points
+    /// are not drawn.
+    void Draw(wxChartBatchRenderer &renderer, const wxRect2DDouble &clip) const;
+    /// Draws some of the points, skipping those that are
+    /// not visible in an area of the window.
+    /// @param renderer The batch renderer.
+    /// @param indices The indices of the points to draw.
+    /// @param clip The area outside of which points
+    /// are not drawn.
+    void Draw(wxChartBatchRenderer &renderer, const wxVector<size_t> &indices,
+        const wxRect2DDouble &clip) const;
+
+private:
+    wxVector<wxPoint2DDouble> m_positions;
+    wxDouble m_radius;
+    wxDouble m_hitDetectionRange;
+    wxChartPointOptions m_options;
+};
+
+#endif
@@ -67,7 +67,8 @@ public:
 
 	/// Draws the radial grid.
 	/// @param gc The graphics context.
-	void Draw(wxGraphicsContext &gc);
+	/// @param cache The cache of the pens, brushes and fonts.
+	void Draw(wxGraphicsContext &gc, wxChartGraphicsCache &cache);
 
 	void Resize(const wxSize &size);
 
@@ -75,8 +76,8 @@ public:
 
 private:
     void Fit(wxGraphicsContext &gc);
-	void DrawCircular(wxGraphicsContext &gc);
-	void DrawPolygonal(wxGraphicsContext &gc);
+	void DrawCircular(wxGraphicsContext &gc, wxChartGraphicsCache &cache);
+	void DrawPolygonal(wxGraphicsContext &gc, wxChartGraphicsCache &cache);
 	static wxPoint2DDouble CalculateCenter(const wxSize& size);
 	static wxDouble CalculateCenterOffset(wxDouble value, 
 		wxDouble drawingArea, wxDouble minValue,
@@ -26,6 +26,7 @@
 #define _WX_CHARTS_WXCHARTRECTANGLE_H_
 
 #include "wxchartelement.h"
+#include "wxchartbatchrenderer.h"
 #include "wxchartrectangleoptions.h"
 #include <wx/graphics.h>
 
@@ -52,6 +53,9 @@ public:
 	/// Draws the rectangle.
 	/// @param gc The graphics context.
 	void Draw(wxGraphicsContext &gc) const;
+	/// Adds the rectangle to a batch of shapes.
+	/// @param renderer The batch renderer.
+	void Draw(wxChartBatchRenderer &renderer) const;
 
 	/// Gets the position of the upper left
 	/// corner of the rectangle.
@@ -0,0 +1,145 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTRINGBUFFER_H_
+#define _WX_CHARTS_WXCHARTRINGBUFFER_H_
+
+#include <wx/vector.h>
+
+/// A list of values that can optionally be limited to
+/// a fixed number of items.
+
+/// When a capacity is set and the list is full, appending
+/// a value discards the oldest one. This is done without
+/// moving the other values so a chart can keep a rolling
+/// window over a stream of data at a constant cost per
+/// value. Items are accessed in the order they were
+/// appended, item 0 being the oldest one.
+template <class T>
+class wxChartRingBuffer
+{
+public:
+    /// Constructs an empty wxChartRingBuffer instance.
+    /// @param capacity The maximum number of items, 0
+    /// means there is no limit.
+    wxChartRingBuffer(size_t capacity = 0)
+        : m_first(0), m_capacity(capacity)
+    {
+    }
+
+    /// Gets the maximum number of items.
+    /// @return The capacity, 0 means there is no limit.
+    size_t GetCapacity() const
+    {
+        return m_capacity;
+    }
+
+    /// Sets the maximum number of items. If there are
+    /// more items than the new capacity the oldest ones
+    /// are discarded.
+    /// @param capacity The maximum number of items, 0
+    /// means there is no limit.
+    void SetCapacity(size_t capacity)
+    {
+        size_t count = GetCount();
+        size_t first = 0;
+        if ((capacity != 0) && (count > capacity))
+        {
+            first = count - capacity;
+        }
+
+        wxVector<T> items;
+        items.reserve(count - first);
+        for (size_t i = first; i < count; ++i)
+        {
+            items.push_back((*this)[i]);
+        }
+        m_items.swap(items);
+        m_first = 0;
+        m_capacity = capacity;
+    }
+
+    /// Gets the number of items.
+    /// @return The number of items.
+    size_t GetCount() const
+    {
+        return m_items.size();
+    }
+
+    /// Checks whether appending a value will discard
+    /// the oldest one.
+    /// @return Whether the list is full.
+    bool IsFull() const
+    {
+        return ((m_capacity != 0) && (m_items.size() == m_capacity));
+    }
+
+    /// Gets an item.
+    /// @param index The index of the item, 0 is the
+    /// oldest item.
+    /// @return The item.
+    const T& operator[](size_t index) const
+    {
+        index += m_first;
+        if (index >= m_items.size())
+        {
+            index -= m_items.size();
+        }
+        return m_items[index];
+    }
+
+    /// Appends a value. If the list is full the oldest
+    /// item is discarded.
+    /// @param value The value to append.
+    void Append(const T &value)
+    {
+        if (IsFull())
+        {
+            m_items[m_first] = value;
+            if (++m_first == m_items.size())
+            {
+                m_first = 0;
+            }
+        }
+        else
+        {
+            m_items.push_back(value);
+        }
+    }
+
+    /// Removes all the items. The capacity is unchanged.
+    void Clear()
+    {
+        m_items.clear();
+        m_first = 0;
+    }
+
+private:
+    wxVector<T> m_items;
+    // The index in m_items of the oldest item
+    size_t m_first;
+    size_t m_capacity;
+};
+
+#endif
@@ -41,6 +41,9 @@
 #include "wxcandlestickchartctrl.h"
 #include "wxohlcchartctrl.h"
 #include "wxchartlegendctrl.h"
+#include "wxchartbatchexporter.h"
+#include "wxcharttiledexporter.h"
+#include "wxchartsvgexporter.h"
 
 #ifdef _MSC_VER
 
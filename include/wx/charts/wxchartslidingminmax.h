@@ -0,0 +1,106 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTSLIDINGMINMAX_H_
+#define _WX_CHARTS_WXCHARTSLIDINGMINMAX_H_
+
+#include <wx/vector.h>
+
+/// Keeps track of the minimum and maximum of a window
+/// of values.
+
+/// Values enter the window at the back and leave it at
+/// the front, in the order they were added. The minimum
+/// and maximum are maintained with two monotonic queues
+/// so adding or removing a value has an amortized
+/// constant cost, whatever the size of the window.
+class wxChartSlidingMinMax
+{
+public:
+    /// Constructs an empty wxChartSlidingMinMax instance.
+    wxChartSlidingMinMax();
+
+    /// Adds a value at the back of the window.
+    /// @param value The value.
+    void Push(wxDouble value);
+    /// Removes the oldest value from the window. The
+    /// window must not be empty.
+    void Pop();
+    /// Removes all the values from the window.
+    void Clear();
+
+    /// Checks whether the window is empty.
+    /// @return Whether the window is empty.
+    bool IsEmpty() const;
+    /// Gets the minimum of the values in the window.
+    /// The window must not be empty.
+    /// @return The minimum.
+    wxDouble GetMin() const;
+    /// Gets the maximum of the values in the window.
+    /// The window must not be empty.
+    /// @return The maximum.
+    wxDouble GetMax() const;
+
+private:
+    struct Entry
+    {
+        Entry(size_t position, wxDouble value);
+
+        // The number of values pushed before this one
+        size_t m_position;
+        wxDouble m_value;
+    };
+
+    // A double-ended queue stored in a vector. The
+    // entries before first have been removed and
+    // are only erased once they make up half of
+    // the vector.
+    class Queue
+    {
+    public:
+        Queue();
+
+        bool IsEmpty() const;
+        const Entry& GetFront() const;
+        const Entry& GetBack() const;
+        void PushBack(const Entry &entry);
+        void PopFront();
+        void PopBack();
+        void Clear();
+
+    private:
+        wxVector<Entry> m_entries;
+        size_t m_first;
+    };
+
+private:
+    // Values are increasing from front to back
+    Queue m_min;
+    // Values are decreasing from front to back
+    Queue m_max;
+    size_t m_pushed;
+    size_t m_popped;
+};
+
+#endif
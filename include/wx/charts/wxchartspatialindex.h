@@ -0,0 +1,99 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTSPATIALINDEX_H_
+#define _WX_CHARTS_WXCHARTSPATIALINDEX_H_
+
+#include <wx/vector.h>
+#include <wx/geometry.h>
+
+/// A screen space index used to speed up hit testing.
+
+/// The index is a uniform grid of square cells. Each item
+/// is registered in all the cells its hit detection area
+/// overlaps so a query only needs to return the items of
+/// the cell containing the point.
+///
+/// Items are identified by the order in which they are
+/// added with Add(), the first item being item 0. The index
+/// is usable once Build() has been called and must be
+/// rebuilt when the items move.
+class wxChartSpatialIndex
+{
+public:
+    /// Constructs an empty wxChartSpatialIndex instance.
+    wxChartSpatialIndex();
+
+    /// Removes all the items from the index.
+    void Clear();
+    /// Adds the next item to the index.
+    /// @param position The position of the item in window
+    /// coordinates.
+    /// @param extent The distance from the position beyond
+    /// which the item can't be hit.
+    void Add(const wxPoint2DDouble &position, wxDouble extent);
+    /// Builds the grid from the items added since the
+    /// last call to Clear().
+    void Build();
+    /// Exchanges the content of two indices.
+    /// @param other The other index.
+    void Swap(wxChartSpatialIndex &other);
+
+    /// Appends the items that may be hit at a given point.
+    /// The caller is expected to perform the exact hit test
+    /// on them. Items are appended in the order in which they
+    /// were added.
+    /// @param point The point.
+    /// @param items The list the items are appended to.
+    void Query(const wxPoint &point, wxVector<size_t> &items) const;
+
+private:
+    struct Entry
+    {
+        size_t item;
+        wxDouble x;
+        wxDouble y;
+        wxDouble extent;
+    };
+
+    bool GetCellRange(wxDouble minX, wxDouble minY,
+        wxDouble maxX, wxDouble maxY, size_t &firstColumn,
+        size_t &firstRow, size_t &lastColumn, size_t &lastRow) const;
+
+private:
+    wxVector<Entry> m_pending;
+    wxDouble m_originX;
+    wxDouble m_originY;
+    wxDouble m_cellSize;
+    size_t m_columns;
+    size_t m_rows;
+    size_t m_count;
+    // m_cellStarts[c] is the index in m_items of the first
+    // item of cell c, the list has one extra entry so that
+    // the end of the last cell can be found the same way
+    wxVector<size_t> m_cellStarts;
+    wxVector<size_t> m_items;
+};
+
+#endif
@@ -0,0 +1,76 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTSVGEXPORTER_H_
+#define _WX_CHARTS_WXCHARTSVGEXPORTER_H_
+
+#include "wxchart.h"
+#include <wx/stream.h>
+
+/// Exports charts to SVG documents.
+
+/// The chart is laid out for the size of the document
+/// and drawn on a graphics context that writes each
+/// path, text and image to the output stream as soon as
+/// it is drawn, so the document is never held in memory.
+///
+/// Since the chart is laid out for the target size the
+/// downsampling of the lines happens at the resolution
+/// of the document. In addition only the first, last,
+/// lowest and highest points of a line are written for
+/// each pixel column, as with wxCHARTDOWNSAMPLINGMODE_M4,
+/// and the points of a series that fall on the same pixel
+/// are only written once, so the size of the output
+/// follows the visible detail rather than the number of
+/// points.
+///
+/// The styles are written as CSS classes shared by all
+/// the elements that use them.
+class wxChartSVGExporter
+{
+public:
+    /// Constructs a wxChartSVGExporter instance.
+    wxChartSVGExporter();
+
+    /// Renders a chart and saves it to an SVG file. The
+    /// chart is laid out again for its previous size
+    /// afterwards.
+    /// @param chart The chart.
+    /// @param size The size of the document in pixels.
+    /// @param filename The name of the file.
+    /// @return true if the file was saved, false otherwise.
+    bool Save(wxChart &chart, const wxSize &size,
+        const wxString &filename);
+    /// Renders a chart and writes it as an SVG document to
+    /// a stream.
+    /// @param chart The chart.
+    /// @param size The size of the document in pixels.
+    /// @param stream The stream.
+    /// @return true if the document was written, false
+    /// otherwise.
+    bool Save(wxChart &chart, const wxSize &size,
+        wxOutputStream &stream);
+};
+
+#endif
@@ -0,0 +1,144 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTTEXTEXTENTCACHE_H_
+#define _WX_CHARTS_WXCHARTTEXTEXTENTCACHE_H_
+
+#include "wxchartfontoptions.h"
+#include <wx/graphics.h>
+#include <wx/font.h>
+#include <wx/hashmap.h>
+#include <wx/thread.h>
+#include <list>
+
+/// A process-wide cache of the size of text strings.
+
+/// Measuring a string requires setting the font on
+/// a graphics context and asking the platform for the
+/// extent of the text, which is slow compared to the
+/// rest of a chart layout. The same strings (axis
+/// labels, tooltip titles...) are measured over and
+/// over again, often by many charts at once, so the
+/// sizes are remembered, keyed by the renderer and
+/// resolution of the graphics context, the description
+/// of the font and the string.
+///
+/// When the cache is full the least recently used
+/// entry is discarded. The cache can be used from
+/// several threads.
+class wxChartTextExtentCache
+{
+public:
+    /// Constructs an empty wxChartTextExtentCache instance.
+    /// @param capacity The maximum number of strings
+    /// whose size is kept.
+    wxChartTextExtentCache(size_t capacity = 4096);
+
+    /// Gets the cache shared by all the charts.
+    /// @return The cache.
+    static wxChartTextExtentCache& Get();
+
+    /// Gets the size of the text for the given font. The
+    /// text is only measured if it isn't in the cache yet.
+    /// @param gc The graphics context used to measure the
+    /// text if needed.
+    /// @param font The font.
+    /// @param string The text that we need to measure.
+    /// @param width When the function returns this will contain
+    /// the width of the string.
+    /// @param height When the function returns this will contain
+    /// the height of the string.
+    void GetTextSize(wxGraphicsContext &gc, const wxFont &font,
+        const wxString &string, wxDouble &width, wxDouble &height);
+    /// Gets the size of the text for the given font
+    /// options. This avoids building the description of
+    /// the font for every string.
+    /// @param gc The graphics context used to measure the
+    /// text if needed.
+    /// @param fontOptions The font options.
+    /// @param string The text that we need to measure.
+    /// @param width When the function returns this will contain
+    /// the width of the string.
+    /// @param height When the function returns this will contain
+    /// the height of the string.
+    void GetTextSize(wxGraphicsContext &gc,
+        const wxChartFontOptions &fontOptions, const wxString &string,
+        wxDouble &width, wxDouble &height);
+
+    /// Gets the maximum number of strings whose size is kept.
+    /// @return The capacity of the cache.
+    size_t GetCapacity() const;
+    /// Sets the maximum number of strings whose size is kept.
+    /// The least recently used entries are discarded if there
+    /// are too many.
+    /// @param capacity The capacity of the cache, 0 disables
+    /// the cache.
+    void SetCapacity(size_t capacity);
+    /// Gets the number of requests that were answered
+    /// from the cache.
+    /// @return The number of hits.
+    size_t GetHits() const;
+    /// Gets the number of requests for which the text had
+    /// to be measured.
+    /// @return The number of misses.
+    size_t GetMisses() const;
+    /// Removes all the entries and resets the counters.
+    void Clear();
+
+private:
+    void DoGetTextSize(wxGraphicsContext &gc, const wxFont &font,
+        const wxString &fontDescription, const wxString &string,
+        wxDouble &width, wxDouble &height);
+    // Gets the part of the key that identifies the
+    // renderer and resolution of the context
+    const wxString& GetContextKey(wxGraphicsContext &gc);
+    void Trim();
+
+private:
+    struct Entry
+    {
+        Entry(const wxString &key, wxDouble width, wxDouble height);
+
+        wxString m_key;
+        wxDouble m_width;
+        wxDouble m_height;
+    };
+    typedef std::list<Entry> EntryList;
+    WX_DECLARE_STRING_HASH_MAP(EntryList::iterator, EntryMap);
+
+    mutable wxCriticalSection m_lock;
+    size_t m_capacity;
+    // Most recently used first
+    EntryList m_entries;
+    EntryMap m_index;
+    size_t m_hits;
+    size_t m_misses;
+    // The context the last key was built for
+    wxGraphicsRenderer *m_contextRenderer;
+    wxDouble m_contextDPIX;
+    wxDouble m_contextDPIY;
+    wxString m_contextKey;
+};
+
+#endif
@@ -0,0 +1,130 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTTHREADPOOL_H_
+#define _WX_CHARTS_WXCHARTTHREADPOOL_H_
+
+#include <wx/thread.h>
+#include <wx/vector.h>
+#include <deque>
+
+/// A fixed set of worker threads running tasks.
+
+/// The tasks are run in the order they were submitted
+/// but since several of them run at the same time they
+/// may complete in any order. The tasks must not use
+/// the GUI.
+class wxChartThreadPool
+{
+public:
+    /// A unit of work run by the pool.
+    class Task
+    {
+    public:
+        virtual ~Task();
+
+        /// Does the work. This is called from one of the
+        /// worker threads.
+        virtual void Run() = 0;
+    };
+
+    /// The body of a loop whose iterations don't depend
+    /// on each other.
+    class Loop
+    {
+    public:
+        virtual ~Loop();
+
+        /// Runs the iterations in a range. This is called
+        /// from several threads at the same time with ranges
+        /// that don't overlap.
+        /// @param begin The first iteration.
+        /// @param end The iteration after the last one.
+        virtual void Run(size_t begin, size_t end) = 0;
+    };
+
+public:
+    /// Constructs a wxChartThreadPool instance and starts
+    /// the worker threads.
+    /// @param numberOfThreads The number of worker threads,
+    /// 0 means one per processor.
+    wxChartThreadPool(unsigned int numberOfThreads = 0);
+    /// Waits for the submitted tasks to complete and stops
+    /// the worker threads.
+    ~wxChartThreadPool();
+
+    /// Gets the number of worker threads.
+    /// @return The number of worker threads.
+    unsigned int GetNumberOfThreads() const;
+
+    /// Queues a task. The pool takes ownership of the task
+    /// and deletes it once it has been run.
+    /// @param task The task.
+    void Submit(Task *task);
+    /// Waits until all the submitted tasks have been run.
+    void Wait();
+    /// Runs the iterations of a loop on the worker threads
+    /// and on the calling thread, then waits until all the
+    /// iterations have been run. Several threads can run
+    /// loops on the same pool at the same time. The
+    /// iterations are split into chunks that only depend
+    /// on the number of iterations so the work done for a
+    /// chunk doesn't depend on the number of threads. This
+    /// must not be called from one of the worker threads.
+    /// @param loop The loop.
+    /// @param count The number of iterations.
+    void RunLoop(Loop &loop, size_t count);
+
+private:
+    class LoopTask;
+
+    class Worker : public wxThread
+    {
+    public:
+        Worker(wxChartThreadPool &pool);
+
+    private:
+        virtual ExitCode Entry() wxOVERRIDE;
+
+    private:
+        wxChartThreadPool &m_pool;
+    };
+
+    // Blocks until a task is available, returns 0 when
+    // the pool is stopping
+    Task* TakeTask();
+    void CompleteTask(Task *task);
+
+private:
+    wxMutex m_mutex;
+    wxCondition m_taskAvailable;
+    wxCondition m_tasksCompleted;
+    std::deque<Task*> m_tasks;
+    // The number of tasks that are queued or running
+    size_t m_pendingTasks;
+    bool m_stopping;
+    wxVector<Worker*> m_workers;
+};
+
+#endif
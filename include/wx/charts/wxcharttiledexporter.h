@@ -0,0 +1,81 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTTILEDEXPORTER_H_
+#define _WX_CHARTS_WXCHARTTILEDEXPORTER_H_
+
+#include "wxchart.h"
+#include <wx/stream.h>
+
+/// Exports very large images of a chart to PNG files.
+
+/// wxChart::Save() renders the whole image at once which
+/// fails or uses gigabytes of memory for poster sized
+/// exports. This exporter lays the chart out once for
+/// the full size and renders it one tile at a time: each
+/// tile is drawn into a small image with the graphics
+/// context translated to the position of the tile and
+/// clipped to it. The tiles of a row are assembled into
+/// a band of rows that is handed to a wxChartPNGWriter.
+///
+/// Memory use is bounded by two bands (the width of the
+/// image times the height of a tile) and one tile. The
+/// PNG encoding of a band runs on a worker thread while
+/// the tiles of the next band are rendered.
+class wxChartTiledExporter
+{
+public:
+    /// Constructs a wxChartTiledExporter instance.
+    /// @param tileSize The size of the tiles.
+    wxChartTiledExporter(const wxSize &tileSize = wxSize(1024, 256));
+
+    /// Renders a chart and saves it to a PNG file. The
+    /// chart is laid out again for its previous size
+    /// afterwards.
+    /// @param chart The chart.
+    /// @param size The size of the image.
+    /// @param filename The name of the file.
+    /// @return true if the file was saved, false otherwise.
+    bool Save(wxChart &chart, const wxSize &size,
+        const wxString &filename);
+    /// Renders a chart and writes it as a PNG image to a
+    /// stream.
+    /// @param chart The chart.
+    /// @param size The size of the image.
+    /// @param stream The stream.
+    /// @return true if the image was written, false otherwise.
+    bool Save(wxChart &chart, const wxSize &size,
+        wxOutputStream &stream);
+
+private:
+    class EncodeTask;
+
+    bool RenderBand(wxChart &chart, int top, int numberOfRows,
+        wxImage &tile, unsigned char *band, size_t stride);
+
+private:
+    wxSize m_tileSize;
+};
+
+#endif
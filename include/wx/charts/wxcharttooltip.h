@@ -27,6 +27,7 @@
 
 #include "wxcharttooltipoptions.h"
 #include "wxcharttooltipprovider.h"
+#include "wxchartgraphicscache.h"
 #include <wx/graphics.h>
 
 /// This class is used to display a tooltip.
@@ -45,11 +46,23 @@ public:
 		const wxString &text);
 	wxChartTooltip(const wxPoint2DDouble &position,
 		const wxChartTooltipProvider::ptr provider);
+	/// Constructs a new wxChartTooltip instance with
+	/// the given options. Copying the options also
+	/// copies the font they have already created.
+	/// @param position The position of the tooltip.
+	/// @param text The text to display in the tooltip.
+	/// @param options The settings of the tooltip.
+	wxChartTooltip(const wxPoint2DDouble &position,
+		const wxString &text, const wxChartTooltipOptions &options);
 
 	/// Draws the tooltip using the graphics context passed
 	/// in as argument.
 	/// @param gc The graphics context.
 	void Draw(wxGraphicsContext &gc);
+	/// Draws the tooltip using a cached font and brush.
+	/// @param gc The graphics context.
+	/// @param cache The cache of the pens, brushes and fonts.
+	void Draw(wxGraphicsContext &gc, wxChartGraphicsCache &cache);
 
 	/// Gets the position of the tooltip.
 	/// @return The position of the tooltip.
@@ -26,6 +26,7 @@
 #define _WX_CHARTS_WXCHARTTOOLTIPOPTIONS_H_
 
 #include "wxchartbackgroundoptions.h"
+#include "wxchartfontoptions.h"
 #include <wx/colour.h>
 #include <wx/font.h>
 
@@ -52,6 +53,10 @@ public:
 	/// the text.
 	/// @return The font color.
 	const wxColor& GetFontColor() const;
+	/// Gets the font settings of the text, built from
+	/// the family, size, style and color above.
+	/// @return The font settings.
+	const wxChartFontOptions& GetFontOptions() const;
 
 	/// Gets the horizontal padding. The padding will
 	/// be added on the left and on the right of the text 
@@ -70,6 +75,7 @@ private:
 	int m_fontSize;
 	wxFontStyle m_fontStyle;
 	wxColor m_fontColor;
+	wxChartFontOptions m_fontOptions;
 	wxDouble m_horizontalPadding;
 	wxDouble m_verticalPadding;
     wxChartBackgroundOptions m_backgroundOptions;
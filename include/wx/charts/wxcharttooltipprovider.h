@@ -38,6 +38,7 @@ public:
 
 	/// Constructs a wxChartTooltipProvider instance.
 	wxChartTooltipProvider();
+	virtual ~wxChartTooltipProvider();
 
 	// Gets the title of the tooltip.
 	/// @return A wxString containing the title of the tooltip.
@@ -80,4 +81,57 @@ private:
 	wxColor m_color;
 };
 
+/// Interface for the classes that generate the content of the tooltips of all the elements of a dataset.
+
+/// Charts with a large number of elements share one instance
+/// between all the elements of a dataset instead of creating
+/// a wxChartTooltipProvider for each element. The content of
+/// a tooltip is only generated when the tooltip is displayed.
+class wxChartDatasetTooltipProvider
+{
+public:
+	/// Smart pointer typedef.
+	typedef wxSharedPtr<wxChartDatasetTooltipProvider> ptr;
+
+	/// Constructs a wxChartDatasetTooltipProvider instance.
+	wxChartDatasetTooltipProvider();
+	virtual ~wxChartDatasetTooltipProvider();
+
+	/// Gets the title of the tooltip of an element.
+	/// @param index The index of the element in the dataset.
+	/// @return A wxString containing the title of the tooltip.
+	virtual wxString GetTooltipTitle(size_t index) const = 0;
+	/// Gets the text of the tooltip of an element.
+	/// @param index The index of the element in the dataset.
+	/// @return A wxString containing the text of the tooltip.
+	virtual wxString GetTooltipText(size_t index) const = 0;
+	/// Gets the color associated with an element.
+	/// @param index The index of the element in the dataset.
+	/// @return The color.
+	virtual wxColor GetAssociatedColor(size_t index) const = 0;
+};
+
+/// Implementation of the wxChartTooltipProvider interface for one element of a dataset.
+
+/// This forwards the calls to a wxChartDatasetTooltipProvider.
+/// Elements create it on demand when their tooltip is displayed.
+class wxChartTooltipProviderDatasetItem : public wxChartTooltipProvider
+{
+public:
+	/// Constructs a wxChartTooltipProviderDatasetItem instance.
+	/// @param provider The provider shared by the elements of
+	/// the dataset.
+	/// @param index The index of the element in the dataset.
+	wxChartTooltipProviderDatasetItem(const wxChartDatasetTooltipProvider::ptr provider,
+		size_t index);
+
+	virtual wxString GetTooltipTitle() const;
+	virtual wxString GetTooltipText() const;
+	virtual wxColor GetAssociatedColor() const;
+
+private:
+	wxChartDatasetTooltipProvider::ptr m_provider;
+	size_t m_index;
+};
+
 #endif
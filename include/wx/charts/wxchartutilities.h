@@ -52,7 +52,8 @@ public:
     static void BuildNumericalLabels(wxDouble minValue, size_t steps,
         wxDouble stepValue, const wxChartLabelOptions &options,
         wxVector<wxChartLabel> &labels);
-	/// Gets the size of the text for the given font.
+	/// Gets the size of the text for the given font. The
+	/// sizes are cached, see wxChartTextExtentCache.
 	/// @param gc The graphics context.
 	/// @param font The font.
 	/// @param string The text that we need to measure.
@@ -63,6 +64,19 @@ public:
 	static void GetTextSize(wxGraphicsContext &gc,
 		const wxFont &font, const wxString &string,
 		wxDouble &width, wxDouble &height);
+	/// Gets the size of the text for the given font
+	/// options. The sizes are cached, see
+	/// wxChartTextExtentCache.
+	/// @param gc The graphics context.
+	/// @param fontOptions The font options.
+	/// @param string The text that we need to measure.
+	/// @param width When the function returns this will contain
+	/// the width of the string.
+	/// @param height When the function returns this will contain
+	/// the height of the string.
+	static void GetTextSize(wxGraphicsContext &gc,
+		const wxChartFontOptions &fontOptions, const wxString &string,
+		wxDouble &width, wxDouble &height);
 };
 
 #endif
@@ -0,0 +1,69 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+/// @file
+
+#ifndef _WX_CHARTS_WXCHARTXINDEX_H_
+#define _WX_CHARTS_WXCHARTXINDEX_H_
+
+#include <wx/vector.h>
+
+/// An index of the X coordinates of a series of points.
+
+/// This is used by charts whose points are hit tested
+/// based on their X coordinate only. When the points
+/// are sorted by X, which is the usual case for line
+/// charts, a query is a binary search. Otherwise all the
+/// points are tested.
+///
+/// Points are identified by their position in the series
+/// and the index must be rebuilt when they move.
+class wxChartXIndex
+{
+public:
+    /// Constructs an empty wxChartXIndex instance.
+    wxChartXIndex();
+
+    /// Removes all the points from the index.
+    void Clear();
+    /// Adds the next point of the series to the index.
+    /// The first point added is point 0.
+    /// @param x The X coordinate of the point in
+    /// window coordinates.
+    void Add(wxDouble x);
+
+    /// Appends the points whose distance from a given
+    /// X coordinate is less than a given range. Points
+    /// are appended in the order they were added.
+    /// @param x The X coordinate.
+    /// @param range The range.
+    /// @param points The list the indices of the points
+    /// are appended to.
+    void Query(wxDouble x, wxDouble range,
+        wxVector<size_t> &points) const;
+
+private:
+    wxVector<wxDouble> m_x;
+    bool m_isSorted;
+};
+
+#endif
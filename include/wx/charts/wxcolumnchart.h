@@ -58,11 +58,15 @@ private:
     virtual void DoSetSize(const wxSize &size) wxOVERRIDE;
     virtual void DoFit() wxOVERRIDE;
     virtual void DoDraw(wxGraphicsContext &gc) wxOVERRIDE;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) wxOVERRIDE;
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) wxOVERRIDE;
 
     wxDouble GetColumnWidth() const;
+    size_t GetNumberOfColumns() const;
 
 private:
+    class ColumnLoop;
+
     class Column : public wxChartRectangle
     {
     public:
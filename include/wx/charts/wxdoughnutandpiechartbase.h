@@ -40,6 +40,7 @@
 #include "wxchartslicedata.h"
 #include "wxdoughnutandpiechartoptionsbase.h"
 #include "wxchartarc.h"
+#include "wxchartangularindex.h"
 #include <wx/control.h>
 #include <wx/sharedptr.h>
 
@@ -54,7 +55,8 @@ class wxDoughnutAndPieChartBase : public wxChart
 public:
 	/// Constructs a wxDoughnutAndPieChartBase
     /// instance.
-	wxDoughnutAndPieChartBase();
+	/// @param size The initial size of the chart.
+	wxDoughnutAndPieChartBase(const wxSize &size);
 
 protected:
 	void Add(const wxChartSliceData &slice, const wxSize &size);
@@ -65,7 +67,8 @@ private:
     virtual void DoSetSize(const wxSize &size) wxOVERRIDE;
     virtual void DoFit() wxOVERRIDE;
     virtual void DoDraw(wxGraphicsContext &gc) wxOVERRIDE;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) wxOVERRIDE;
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) wxOVERRIDE;
     
 	wxDouble CalculateCircumference(double value);
 	
@@ -94,6 +97,7 @@ private:
     wxSize m_size;
 	wxVector<SliceArc::ptr> m_slices;
 	wxDouble m_total;
+	wxChartAngularIndex m_index;
 };
 
 #endif
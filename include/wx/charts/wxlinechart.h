@@ -39,7 +39,11 @@
 #include "wxchart.h"
 #include "wxlinechartoptions.h"
 #include "wxchartgrid.h"
-#include "wxchartpoint.h"
+#include "wxchartpointseries.h"
+#include "wxchartelementcache.h"
+#include "wxchartxindex.h"
+#include "wxchartringbuffer.h"
+#include "wxchartslidingminmax.h"
 
 enum wxLineType
 {
@@ -143,38 +147,61 @@ public:
 
     virtual const wxLineChartOptions& GetOptions() const wxOVERRIDE;
 
-    void Save(const wxString &filename, const wxBitmapType &type,
-        const wxSize &size);
+    /// Appends values at the end of a dataset. If a
+    /// capacity has been set the oldest values of the
+    /// dataset are discarded to make room for the new
+    /// ones.
+    /// @param datasetIndex The index of the dataset.
+    /// @param values The values to append.
+    void AppendValues(size_t datasetIndex, const wxVector<wxDouble> &values);
+    /// Appends labels at the end of the X axis. If a
+    /// capacity has been set the oldest labels are
+    /// discarded to make room for the new ones.
+    /// @param labels The labels to append.
+    void AppendLabels(const wxVector<wxString> &labels);
+    /// Gets the maximum number of values kept in each
+    /// dataset.
+    /// @return The capacity, 0 means there is no limit.
+    size_t GetCapacity() const;
+    /// Sets the maximum number of values kept in each
+    /// dataset and of labels on the X axis. With a
+    /// capacity the chart shows a rolling window over
+    /// the most recent values. By default there is no
+    /// limit.
+    /// @param capacity The maximum number of values, 0
+    /// means there is no limit.
+    void SetCapacity(size_t capacity);
 
 private:
     void Initialize(const wxLineChartData &data);
     static wxDouble GetMinValue(const wxVector<wxLineChartDataset::ptr>& datasets);
     static wxDouble GetMaxValue(const wxVector<wxLineChartDataset::ptr>& datasets);
+    void UpdateValueRange();
+    void UpdateGrid();
 
     virtual void DoSetSize(const wxSize &size) wxOVERRIDE;
     virtual void DoFit() wxOVERRIDE;
     virtual void DoDraw(wxGraphicsContext &gc) wxOVERRIDE;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) wxOVERRIDE;
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) wxOVERRIDE;
+    const wxChartElement* GetActivePoint(size_t datasetIndex, size_t index);
 
 private:
-    class Point : public wxChartPoint
+    class Dataset;
+
+    class TooltipProvider : public wxChartDatasetTooltipProvider
     {
     public:
-        typedef wxSharedPtr<Point> ptr;
+        TooltipProvider(const wxChartRingBuffer<wxString> &labels,
+            const Dataset &dataset);
 
-        Point(wxDouble value,
-            const wxChartTooltipProvider::ptr tooltipProvider,
-            wxDouble x, wxDouble y, wxDouble radius,
-            unsigned int strokeWidth, const wxColor &strokeColor,
-            const wxColor &fillColor, wxDouble hitDetectionRange);
-
-        virtual bool HitTest(const wxPoint &point) const;
-
-        wxDouble GetValue() const;
+        virtual wxString GetTooltipTitle(size_t index) const;
+        virtual wxString GetTooltipText(size_t index) const;
+        virtual wxColor GetAssociatedColor(size_t index) const;
 
     private:
-        wxDouble m_value;
-        wxDouble m_hitDetectionRange;
+        const wxChartRingBuffer<wxString> &m_labels;
+        const Dataset &m_dataset;
     };
 
     class Dataset
@@ -182,9 +209,10 @@ private:
     public:
         typedef wxSharedPtr<Dataset> ptr;
 
-        Dataset(bool showDots, bool showLine, const wxColor &lineColor,
-                bool fill, const wxColor &fillColor,
-                const wxLineType &lineType=wxLINETYPE_STRAIGHTLINE);
+        Dataset(const wxLineChartDataset &data,
+            const wxChartRingBuffer<wxString> &labels,
+            wxDouble dotRadius, wxDouble hitDetectionRange,
+            const wxChartPointOptions &dotOptions);
 
         bool ShowDots() const;
         bool ShowLine() const;
@@ -193,8 +221,15 @@ private:
         const wxColor& GetFillColor() const;
         const wxLineType& GetType() const;
 
-        const wxVector<Point::ptr>& GetPoints() const;
-        void AppendPoint(Point::ptr point);
+        const wxChartRingBuffer<wxDouble>& GetValues() const;
+        void AppendValue(wxDouble value);
+        void SetCapacity(size_t capacity);
+        const wxChartSlidingMinMax& GetRange() const;
+        const wxChartDatasetTooltipProvider::ptr& GetTooltipProvider() const;
+        const wxChartPointSeries& GetPoints() const;
+        wxChartPointSeries& GetPoints();
+        void UpdateLine(wxChartDownsamplingMode mode, size_t threshold);
+        const wxVector<wxPoint2DDouble>& GetLine() const;
 
     private:
         bool m_showDots;
@@ -203,13 +238,49 @@ private:
         bool m_fill;
         wxColor m_fillColor;
         wxLineType m_type;
-        wxVector<Point::ptr> m_points;
+        wxChartRingBuffer<wxDouble> m_values;
+        // The range of the values in m_values
+        wxChartSlidingMinMax m_range;
+        wxChartDatasetTooltipProvider::ptr m_tooltipProvider;
+        wxChartPointSeries m_points;
+        // The downsampled line, empty if the line goes
+        // through all the points
+        wxVector<wxPoint2DDouble> m_line;
+    };
+
+    // The element created on demand for an active point
+    class Point : public wxChartElement
+    {
+    public:
+        Point(const Dataset &dataset, size_t index);
+
+        virtual bool HitTest(const wxPoint &point) const;
+        virtual wxPoint2DDouble GetTooltipPosition() const;
+        virtual const wxChartTooltipProvider::ptr GetTooltipProvider() const;
+
+    private:
+        const Dataset &m_dataset;
+        size_t m_index;
     };
 
 private:
     wxLineChartOptions m_options;
     wxChartGrid m_grid;
+    wxChartRingBuffer<wxString> m_labels;
     wxVector<Dataset::ptr> m_datasets;
+    // The range of the values of all the datasets,
+    // combined from the range of each dataset
+    wxDouble m_minValue;
+    wxDouble m_maxValue;
+    // Whether the grid needs to be updated before
+    // the next draw
+    bool m_labelsChanged;
+    bool m_valuesChanged;
+    // One index per dataset
+    wxVector<wxChartXIndex> m_xIndices;
+    wxChartElementCache m_activePoints;
+    // Scratch buffer used by GetActiveElements
+    wxVector<size_t> m_hitPoints;
 };
 
 #endif
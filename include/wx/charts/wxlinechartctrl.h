@@ -77,6 +77,24 @@ public:
 	wxLineChartCtrl(wxWindow *parent, wxWindowID id, const wxLineChartData &data,
 		const wxLineChartOptions &options, const wxPoint &pos = wxDefaultPosition,
 		const wxSize &size = wxDefaultSize, long style = 0);
+
+    /// Appends values at the end of a dataset and
+    /// refreshes the control.
+    /// @param datasetIndex The index of the dataset.
+    /// @param values The values to append.
+    /// @see wxLineChart::AppendValues
+    void AppendValues(size_t datasetIndex, const wxVector<wxDouble> &values);
+    /// Appends labels at the end of the X axis and
+    /// refreshes the control.
+    /// @param labels The labels to append.
+    /// @see wxLineChart::AppendLabels
+    void AppendLabels(const wxVector<wxString> &labels);
+    /// Sets the maximum number of values kept in each
+    /// dataset.
+    /// @param capacity The maximum number of values, 0
+    /// means there is no limit.
+    /// @see wxLineChart::SetCapacity
+    void SetCapacity(size_t capacity);
     
 private:
     virtual wxLineChart& GetChart() wxOVERRIDE;
@@ -27,6 +27,7 @@
 
 #include "wxchartoptions.h"
 #include "wxchartgridoptions.h"
+#include "wxchartdownsampling.h"
 
 /// The options for the wxLineChartCtrl control.
 class wxLineChartOptions : public wxChartOptions
@@ -66,12 +67,25 @@ public:
 	/// @return The hit detection range.
 	wxDouble GetHitDetectionRange() const;
 
+	/// Gets the method used to reduce the number of
+	/// points of the lines before they are drawn.
+	/// @return The downsampling mode.
+	wxChartDownsamplingMode GetDownsamplingMode() const;
+	/// Sets the method used to reduce the number of
+	/// points of the lines before they are drawn. By
+	/// default all the points are drawn. This only
+	/// affects the lines, the dots and the hit
+	/// detection still use every point.
+	/// @param mode The downsampling mode.
+	void SetDownsamplingMode(wxChartDownsamplingMode mode);
+
 private:
 	wxChartGridOptions m_gridOptions;
 	wxDouble m_dotRadius;
 	unsigned int m_dotStrokeWidth;
 	unsigned int m_lineWidth;
 	wxDouble m_hitDetectionRange;
+	wxChartDownsamplingMode m_downsamplingMode;
 };
 
 #endif
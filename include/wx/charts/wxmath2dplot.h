@@ -39,7 +39,12 @@
 #include "wxchart.h"
 #include "wxmath2dplotoptions.h"
 #include "wxchartgrid.h"
-#include "wxchartpoint.h"
+#include "wxchartpointseries.h"
+#include "wxchartelementcache.h"
+#include "wxchartxindex.h"
+#include "wxchartringbuffer.h"
+#include "wxchartslidingminmax.h"
+#include "wxchartminmaxpyramid.h"
 
 enum wxChartType
 {
@@ -116,44 +121,60 @@ public:
 
     virtual const wxMath2DPlotOptions& GetOptions() const wxOVERRIDE;
 
-    void Save(const wxString &filename, const wxBitmapType &type,
-        const wxSize &size);
-
     bool Scale(int coeff);
     void Shift(double dx,double dy);
 
+    /// Appends points at the end of a dataset. If a
+    /// capacity has been set the oldest points of the
+    /// dataset are discarded to make room for the new
+    /// ones. The axes follow the range of the points
+    /// currently in the datasets.
+    /// @param datasetIndex The index of the dataset.
+    /// @param values The points to append.
+    void AppendValues(size_t datasetIndex, const wxVector<wxPoint2DDouble> &values);
+    /// Gets the maximum number of points kept in each
+    /// dataset.
+    /// @return The capacity, 0 means there is no limit.
+    size_t GetCapacity() const;
+    /// Sets the maximum number of points kept in each
+    /// dataset. With a capacity the plot shows a sliding
+    /// window over the most recent points, like a scope
+    /// display. By default there is no limit.
+    /// @param capacity The maximum number of points, 0
+    /// means there is no limit.
+    void SetCapacity(size_t capacity);
+
 private:
     void Initialize(const wxMath2DPlotData &data);
     static wxDouble GetMinXValue(const wxVector<wxMath2DPlotDataset::ptr>& datasets);
     static wxDouble GetMaxXValue(const wxVector<wxMath2DPlotDataset::ptr>& datasets);
     static wxDouble GetMinYValue(const wxVector<wxMath2DPlotDataset::ptr>& datasets);
     static wxDouble GetMaxYValue(const wxVector<wxMath2DPlotDataset::ptr>& datasets);
+    void UpdateGrid();
+    size_t GetNumberOfValues() const;
 
     virtual void DoSetSize(const wxSize &size) wxOVERRIDE;
     virtual void DoFit() wxOVERRIDE;
     virtual void DoDraw(wxGraphicsContext &gc) wxOVERRIDE;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) wxOVERRIDE;
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) wxOVERRIDE;
+    const wxChartElement* GetActivePoint(size_t datasetIndex, size_t index);
 
 private:
-    class Point : public wxChartPoint
+    class Dataset;
+    class PositionLoop;
+
+    class TooltipProvider : public wxChartDatasetTooltipProvider
     {
     public:
-        typedef wxSharedPtr<Point> ptr;
+        TooltipProvider(const Dataset &dataset);
 
-        Point(wxPoint2DDouble value,
-            const wxChartTooltipProvider::ptr tooltipProvider,
-            wxDouble x, wxDouble y,wxDouble radius,
-            unsigned int strokeWidth, const wxColor &strokeColor,
-            const wxColor &fillColor, wxDouble hitDetectionRange);
-
-        virtual wxPoint2DDouble GetTooltipPosition() const;
-        virtual bool HitTest(const wxPoint &point) const;
-
-        wxPoint2DDouble GetValue() const;
+        virtual wxString GetTooltipTitle(size_t index) const;
+        virtual wxString GetTooltipText(size_t index) const;
+        virtual wxColor GetAssociatedColor(size_t index) const;
 
     private:
-        wxPoint2DDouble m_value;
-        wxDouble m_hitDetectionRange;
+        const Dataset &m_dataset;
     };
 
     class Dataset
@@ -161,31 +182,99 @@ private:
     public:
         typedef wxSharedPtr<Dataset> ptr;
 
-        Dataset(
-            bool showDots, bool showLine,
-            const wxColor &lineColor,
-            const wxChartType &chartType=wxCHARTTYPE_LINE);
+        Dataset(const wxMath2DPlotDataset &data,
+            wxDouble dotRadius, wxDouble hitDetectionRange,
+            const wxChartPointOptions &dotOptions);
 
         bool ShowDots() const;
         bool ShowLine() const;
         const wxColor& GetLineColor() const;
         const wxChartType& GetType() const;
 
-        const wxVector<Point::ptr>& GetPoints() const;
-        void AppendPoint(Point::ptr point);
+        const wxChartRingBuffer<wxPoint2DDouble>& GetValues() const;
+        void AppendValue(const wxPoint2DDouble &value);
+        void SetCapacity(size_t capacity);
+        const wxChartSlidingMinMax& GetXRange() const;
+        const wxChartSlidingMinMax& GetYRange() const;
+        const wxChartDatasetTooltipProvider::ptr& GetTooltipProvider() const;
+        const wxChartPointSeries& GetPoints() const;
+        wxChartPointSeries& GetPoints();
+        bool IsSorted() const;
+        void UpdateLine(const wxChartGridMapping &mapping,
+            wxChartDownsamplingMode mode, size_t threshold,
+            wxChartThreadPool *pool);
+        void UpdateVisibleLine(const wxChartGridMapping &mapping,
+            wxDouble minXValue, wxDouble maxXValue,
+            wxChartDownsamplingMode mode, size_t threshold,
+            wxChartThreadPool *pool);
+        const wxVector<wxPoint2DDouble>& GetLine() const;
+        const wxVector<size_t>& GetVisibleIndices() const;
+
+    private:
+        bool UsesPyramid(wxChartDownsamplingMode mode, size_t threshold) const;
+        void Downsample(const wxVector<wxPoint2DDouble> &positions,
+            wxChartDownsamplingMode mode, size_t threshold);
 
     private:
         bool m_showDots;
         bool m_showLine;
         wxColor m_lineColor;
         wxChartType m_type;
-        wxVector<Point::ptr> m_points;
+        wxChartRingBuffer<wxPoint2DDouble> m_values;
+        wxChartSlidingMinMax m_xRange;
+        wxChartSlidingMinMax m_yRange;
+        wxChartDatasetTooltipProvider::ptr m_tooltipProvider;
+        wxChartPointSeries m_points;
+        // The downsampled line, only used if m_downsampled
+        // is true
+        wxVector<wxPoint2DDouble> m_line;
+        bool m_downsampled;
+        // The indices of the points that have been positioned
+        // when the others are not visible, empty if all the
+        // points have been positioned
+        wxVector<size_t> m_visibleIndices;
+        // The positions of the points in m_visibleIndices
+        wxVector<wxPoint2DDouble> m_visibleLine;
+        // The number of points whose X value is lower than
+        // the one of the point before them. The pyramid can
+        // only be used when the points are sorted by X.
+        size_t m_unsortedCount;
+        wxChartMinMaxPyramid m_pyramid;
+        // The points of the line picked by the pyramid
+        wxVector<size_t> m_pyramidIndices;
+        // The number of points discarded from the start of
+        // m_values since the pyramid was cleared
+        size_t m_discardedCount;
+    };
+
+    // The element created on demand for an active point
+    class Point : public wxChartElement
+    {
+    public:
+        Point(const Dataset &dataset, size_t index);
+
+        virtual bool HitTest(const wxPoint &point) const;
+        virtual wxPoint2DDouble GetTooltipPosition() const;
+        virtual const wxChartTooltipProvider::ptr GetTooltipProvider() const;
+
+    private:
+        const Dataset &m_dataset;
+        size_t m_index;
     };
 
 private:
     wxMath2DPlotOptions m_options;
     wxChartGrid m_grid;
     wxVector<Dataset::ptr> m_datasets;
+    size_t m_capacity;
+    // Whether the range of the grid needs to be
+    // updated before the next draw
+    bool m_valuesChanged;
+    // One index per dataset
+    wxVector<wxChartXIndex> m_xIndices;
+    wxChartElementCache m_activePoints;
+    // Scratch buffer used by GetActiveElements
+    wxVector<size_t> m_hitPoints;
 };
 
 #endif
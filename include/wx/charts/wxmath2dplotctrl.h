@@ -64,6 +64,19 @@ public:
         const wxMath2DPlotOptions &options, const wxPoint &pos = wxDefaultPosition,
         const wxSize &size = wxDefaultSize, long style = 0);
 
+    /// Appends points at the end of a dataset and
+    /// refreshes the control.
+    /// @param datasetIndex The index of the dataset.
+    /// @param values The points to append.
+    /// @see wxMath2DPlot::AppendValues
+    void AppendValues(size_t datasetIndex, const wxVector<wxPoint2DDouble> &values);
+    /// Sets the maximum number of points kept in each
+    /// dataset.
+    /// @param capacity The maximum number of points, 0
+    /// means there is no limit.
+    /// @see wxMath2DPlot::SetCapacity
+    void SetCapacity(size_t capacity);
+
 private:
     virtual wxMath2DPlot& GetChart() wxOVERRIDE;
 
@@ -29,6 +29,7 @@
 #include "wxchartohlcdata.h"
 #include "wxohlcchartoptions.h"
 #include "wxchartgrid.h"
+#include "wxchartbatchrenderer.h"
 
 /// Data for the wxOHLCChartCtrl control.
 class wxOHLCChartData
@@ -72,9 +73,23 @@ private:
     virtual void DoSetSize(const wxSize &size) wxOVERRIDE;
     virtual void DoFit() wxOVERRIDE;
     virtual void DoDraw(wxGraphicsContext &gc) wxOVERRIDE;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) wxOVERRIDE;
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) wxOVERRIDE;
 
 private:
+    class TooltipProvider : public wxChartDatasetTooltipProvider
+    {
+    public:
+        TooltipProvider(const wxSharedPtr<wxOHLCChartData> data);
+
+        virtual wxString GetTooltipTitle(size_t index) const;
+        virtual wxString GetTooltipText(size_t index) const;
+        virtual wxColor GetAssociatedColor(size_t index) const;
+
+    private:
+        wxSharedPtr<wxOHLCChartData> m_data;
+    };
+
     class OHLDCLines : public wxChartElement
     {
     public:
@@ -83,19 +98,26 @@ private:
         OHLDCLines(const wxChartOHLCData &data, unsigned int lineWidth,
             const wxColor& upLineColor, const wxColor& downLineColor,
             unsigned int openLineLength, unsigned int closeLineLength,
-            const wxChartTooltipProvider::ptr tooltipProvider);
+            const wxChartDatasetTooltipProvider::ptr tooltipProvider,
+            size_t index);
 
         virtual bool HitTest(const wxPoint &point) const;
         virtual wxPoint2DDouble GetTooltipPosition() const;
+        virtual const wxChartTooltipProvider::ptr GetTooltipProvider() const;
 
+        /// Whether the close value is above the open value.
+        /// @return True if the value went up.
+        bool IsUp() const;
         /// Draws the OHLDC lines.
-        /// @param gc The graphics context.
-        void Draw(wxGraphicsContext &gc);
+        /// @param renderer The batch renderer.
+        void Draw(wxChartBatchRenderer &renderer) const;
 
         void Update(const wxChartGridMapping& mapping, size_t index);
 
     private:
         wxChartOHLCData m_data;
+        wxChartDatasetTooltipProvider::ptr m_tooltipProvider;
+        size_t m_index;
         wxPoint2DDouble m_lowPoint;
         wxPoint2DDouble m_highPoint;
         wxPoint2DDouble m_openPoint;
@@ -41,6 +41,7 @@
 #include "wxpolarareachartoptions.h"
 #include "wxchartradialgrid.h"
 #include "wxchartarc.h"
+#include "wxchartangularindex.h"
 
 /// Data for the wxPolarAreaChartCtrl control.
 class wxPolarAreaChartData
@@ -76,7 +77,8 @@ private:
     virtual void DoSetSize(const wxSize &size) wxOVERRIDE;
     virtual void DoFit() wxOVERRIDE;
     virtual void DoDraw(wxGraphicsContext &gc) wxOVERRIDE;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) wxOVERRIDE;
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) wxOVERRIDE;
 
 private:
     class SliceArc : public wxChartArc
@@ -99,6 +101,7 @@ private:
     wxPolarAreaChartOptions m_options;
     wxChartRadialGrid m_grid;
     wxVector<SliceArc::ptr> m_slices;
+    wxChartAngularIndex m_index;
 };
 
 #endif
@@ -28,7 +28,10 @@
 #include "wxchart.h"
 #include "wxscatterplotoptions.h"
 #include "wxchartgrid.h"
-#include "wxchartpoint.h"
+#include "wxchartpointseries.h"
+#include "wxchartmarkersprite.h"
+#include "wxchartelementcache.h"
+#include "wxchartspatialindex.h"
 
 class wxScatterPlotDataset
 {
@@ -88,26 +91,26 @@ private:
 
     virtual void DoSetSize(const wxSize &size) wxOVERRIDE;
     virtual void DoFit() wxOVERRIDE;
+    virtual wxChart::Layout* CreateLayout() wxOVERRIDE;
+    virtual void ApplyLayout(wxChart::Layout &layout) wxOVERRIDE;
     virtual void DoDraw(wxGraphicsContext &gc) wxOVERRIDE;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) wxOVERRIDE;
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) wxOVERRIDE;
+    const wxChartElement* GetActivePoint(size_t datasetIndex, size_t index);
+    size_t GetNumberOfPoints() const;
 
 private:
-    class Point : public wxChartPoint
+    class TooltipProvider : public wxChartDatasetTooltipProvider
     {
     public:
-        typedef wxSharedPtr<Point> ptr;
+        TooltipProvider(const wxScatterPlotDataset::ptr dataset);
 
-        Point(wxPoint2DDouble value,
-            const wxChartTooltipProvider::ptr tooltipProvider,
-            wxDouble x, wxDouble y,
-            const wxChartPointOptions &options);
-
-        virtual wxPoint2DDouble GetTooltipPosition() const;
-
-        wxPoint2DDouble GetValue() const;
+        virtual wxString GetTooltipTitle(size_t index) const;
+        virtual wxString GetTooltipText(size_t index) const;
+        virtual wxColor GetAssociatedColor(size_t index) const;
 
     private:
-        wxPoint2DDouble m_value;
+        wxScatterPlotDataset::ptr m_dataset;
     };
 
     class Dataset
@@ -115,19 +118,74 @@ private:
     public:
         typedef wxSharedPtr<Dataset> ptr;
 
-        Dataset();
+        Dataset(const wxScatterPlotDataset::ptr data,
+            const wxChartDatasetTooltipProvider::ptr tooltipProvider,
+            wxDouble dotRadius, wxDouble hitDetectionRange,
+            const wxChartPointOptions &dotOptions);
+
+        const wxVector<wxPoint2DDouble>& GetValues() const;
+        const wxChartDatasetTooltipProvider::ptr& GetTooltipProvider() const;
+        const wxChartPointSeries& GetPoints() const;
+        wxChartPointSeries& GetPoints();
+        wxChartMarkerSprite& GetMarkerSprite();
+
+    private:
+        wxScatterPlotDataset::ptr m_data;
+        wxChartDatasetTooltipProvider::ptr m_tooltipProvider;
+        wxChartPointSeries m_points;
+        wxChartMarkerSprite m_markerSprite;
+    };
+
+    class PositionLoop;
+
+    // The positions of the points and the index built
+    // from them
+    class Layout : public wxChart::Layout
+    {
+    public:
+        Layout(const wxChartGridMapping &mapping,
+            const wxVector<Dataset::ptr> &datasets,
+            wxChartThreadPool *pool);
+
+        virtual void Compute() wxOVERRIDE;
+
+        wxVector<wxPoint2DDouble>& GetPositions(size_t datasetIndex);
+        wxChartSpatialIndex& GetIndex();
+
+    private:
+        wxChartGridMapping m_mapping;
+        wxVector<Dataset::ptr> m_datasets;
+        // The pool used to compute the positions in
+        // parallel, may be 0
+        wxChartThreadPool *m_pool;
+        // One list per dataset
+        wxVector<wxVector<wxPoint2DDouble> > m_positions;
+        wxChartSpatialIndex m_index;
+    };
+
+    // The element created on demand for an active point
+    class Point : public wxChartElement
+    {
+    public:
+        Point(const Dataset &dataset, size_t index);
 
-        const wxVector<Point::ptr>& GetPoints() const;
-        void AppendPoint(Point::ptr point);
+        virtual bool HitTest(const wxPoint &point) const;
+        virtual wxPoint2DDouble GetTooltipPosition() const;
+        virtual const wxChartTooltipProvider::ptr GetTooltipProvider() const;
 
     private:
-        wxVector<Point::ptr> m_points;
+        const Dataset &m_dataset;
+        size_t m_index;
     };
 
 private:
     wxScatterPlotOptions m_options;
     wxChartGrid m_grid;
     wxVector<Dataset::ptr> m_datasets;
+    wxChartSpatialIndex m_index;
+    wxChartElementCache m_activePoints;
+    // Scratch buffer used by GetActiveElements
+    wxVector<size_t> m_hitPoints;
 };
 
 #endif
@@ -39,8 +39,24 @@ public:
 	/// @return The options for the grid.
 	const wxChartGridOptions& GetGridOptions() const;
 
+	/// Gets the number of points above which the points
+	/// of a dataset are drawn by stamping a marker that
+	/// was rendered once instead of drawing a circle for
+	/// each point.
+	/// @return The threshold, 0 means the points are
+	/// always drawn as circles.
+	size_t GetMarkerSpriteThreshold() const;
+	/// Sets the number of points above which the points
+	/// of a dataset are drawn by stamping a marker that
+	/// was rendered once instead of drawing a circle for
+	/// each point. The default is 10000.
+	/// @param threshold The threshold, 0 means the points
+	/// are always drawn as circles.
+	void SetMarkerSpriteThreshold(size_t threshold);
+
 private:
 	wxChartGridOptions m_gridOptions;
+	size_t m_markerSpriteThreshold;
 };
 
 #endif
@@ -47,8 +47,12 @@ private:
 
     virtual void DoSetSize(const wxSize &size) wxOVERRIDE;
     virtual void DoFit() wxOVERRIDE;
+    virtual wxChart::Layout* CreateLayout() wxOVERRIDE;
+    virtual void ApplyLayout(wxChart::Layout &layout) wxOVERRIDE;
     virtual void DoDraw(wxGraphicsContext &gc) wxOVERRIDE;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) wxOVERRIDE;
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) wxOVERRIDE;
+    size_t GetNumberOfBars() const;
 
 private:
     class Bar : public wxChartRectangle
@@ -84,6 +88,31 @@ private:
         wxVector<Bar::ptr> m_bars;
     };
 
+    class StackLoop;
+
+    // The areas covered by the bars
+    class Layout : public wxChart::Layout
+    {
+    public:
+        Layout(const wxChartGridMapping &mapping,
+            const wxVector<Dataset::ptr> &datasets, wxDouble spacing,
+            wxChartThreadPool *pool);
+
+        virtual void Compute() wxOVERRIDE;
+
+        // The bars of all the datasets, in order
+        const wxVector<wxRect2DDouble>& GetAreas() const;
+
+    private:
+        wxChartGridMapping m_mapping;
+        wxVector<Dataset::ptr> m_datasets;
+        wxDouble m_spacing;
+        // The pool used to compute the positions in
+        // parallel, may be 0
+        wxChartThreadPool *m_pool;
+        wxVector<wxRect2DDouble> m_areas;
+    };
+
 private:
     wxStackedBarChartOptions m_options;
     wxChartGrid m_grid;
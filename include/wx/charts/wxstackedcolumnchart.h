@@ -56,8 +56,12 @@ private:
 
     virtual void DoSetSize(const wxSize &size) wxOVERRIDE;
     virtual void DoFit() wxOVERRIDE;
+    virtual wxChart::Layout* CreateLayout() wxOVERRIDE;
+    virtual void ApplyLayout(wxChart::Layout &layout) wxOVERRIDE;
     virtual void DoDraw(wxGraphicsContext &gc) wxOVERRIDE;
-    virtual wxSharedPtr<wxVector<const wxChartElement*> > GetActiveElements(const wxPoint &point) wxOVERRIDE;
+    virtual void GetActiveElements(const wxPoint &point,
+        wxVector<const wxChartElement*> &activeElements) wxOVERRIDE;
+    size_t GetNumberOfColumns() const;
 
 private:
     class Column : public wxChartRectangle
@@ -93,6 +97,31 @@ private:
         wxVector<Column::ptr> m_columns;
     };
 
+    class StackLoop;
+
+    // The areas covered by the columns
+    class Layout : public wxChart::Layout
+    {
+    public:
+        Layout(const wxChartGridMapping &mapping,
+            const wxVector<Dataset::ptr> &datasets, wxDouble spacing,
+            wxChartThreadPool *pool);
+
+        virtual void Compute() wxOVERRIDE;
+
+        // The columns of all the datasets, in order
+        const wxVector<wxRect2DDouble>& GetAreas() const;
+
+    private:
+        wxChartGridMapping m_mapping;
+        wxVector<Dataset::ptr> m_datasets;
+        wxDouble m_spacing;
+        // The pool used to compute the positions in
+        // parallel, may be 0
+        wxChartThreadPool *m_pool;
+        wxVector<wxRect2DDouble> m_areas;
+    };
+
 private:
     wxStackedColumnChartOptions m_options;
     wxChartGrid m_grid;
@@ -0,0 +1,145 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "BatchExportApp.h"
+#include <wx/charts/wxcharts.h>
+#include <wx/filename.h>
+#include <wx/stopwatch.h>
+#include <wx/thread.h>
+#include <wx/image.h>
+#include <cstdlib>
+
+wxIMPLEMENT_APP(BatchExportApp);
+
+// Creates a line chart with 3 random datasets. The values
+// are drawn when the factory is created so that the
+// charts don't depend on the order they are exported in.
+class LineChartFactory : public wxChartBatchExporter::ChartFactory
+{
+public:
+	LineChartFactory()
+	{
+		for (size_t i = 0; i < 3 * 12; ++i)
+		{
+			m_values.push_back((rand() % 200) / 10.0 - 5);
+		}
+	}
+
+	virtual wxChart* CreateChart(const wxSize &size) const
+	{
+		wxVector<wxString> labels;
+		for (size_t i = 0; i < 12; ++i)
+		{
+			labels.push_back(wxString::Format("%d", (int)(i + 1)));
+		}
+		wxLineChartData chartData(labels);
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			wxVector<wxDouble> points;
+			for (size_t j = 0; j < labels.size(); ++j)
+			{
+				points.push_back(m_values[i * labels.size() + j]);
+			}
+			wxColor color(50 + 60 * i, 187, 205 - 60 * i);
+			wxLineChartDataset::ptr dataset(new wxLineChartDataset(
+				wxString::Format("Dataset %d", (int)i), color,
+				wxColor(255, 255, 255), wxColor(color.Red(), color.Green(), color.Blue(), 0x33),
+				points));
+			chartData.AddDataset(dataset);
+		}
+
+		return new wxLineChart(chartData, size);
+	}
+
+private:
+	wxVector<wxDouble> m_values;
+};
+
+bool BatchExportApp::OnInit()
+{
+	// The number of charts exported for each thread count
+	m_numberOfCharts = 400;
+	if ((argc > 1) && !argv[1].ToLong(&m_numberOfCharts))
+	{
+		wxPrintf("Usage: %s [number of charts]\n", argv[0]);
+		return false;
+	}
+
+	wxImage::AddHandler(new wxPNGHandler);
+	return true;
+}
+
+int BatchExportApp::OnRun()
+{
+	const wxSize size(800, 600);
+	wxString directory = wxFileName::GetTempDir() + wxFileName::GetPathSeparator() + "wxcharts-batchexport";
+	wxFileName::Mkdir(directory, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+
+	int numberOfCores = wxThread::GetCPUCount();
+	if (numberOfCores < 1)
+	{
+		numberOfCores = 1;
+	}
+	wxPrintf("Exporting %ld charts of %dx%d to %s, %d cores\n",
+		m_numberOfCharts, size.GetWidth(), size.GetHeight(), directory, numberOfCores);
+
+	double baseThroughput = 0;
+	for (int threads = 1; ; threads *= 2)
+	{
+		if (threads > numberOfCores)
+		{
+			threads = numberOfCores;
+		}
+
+		srand(1);
+		wxChartBatchExporter exporter(threads);
+		for (long i = 0; i < m_numberOfCharts; ++i)
+		{
+			wxString filename = wxString::Format("%s%cchart%ld.png", directory,
+				wxFileName::GetPathSeparator(), i);
+			exporter.Add(wxChartBatchExporter::ChartFactory::ptr(new LineChartFactory()),
+				size, filename, wxBITMAP_TYPE_PNG);
+		}
+
+		wxStopWatch stopWatch;
+		size_t exported = exporter.Run();
+		double seconds = stopWatch.Time() / 1000.0;
+
+		double throughput = (seconds > 0) ? (exported / seconds) : 0;
+		if (threads == 1)
+		{
+			baseThroughput = throughput;
+		}
+		wxPrintf("%2d threads: %6.2fs, %8.1f charts/s, speedup %5.2f, %lu failed\n",
+			threads, seconds, throughput,
+			(baseThroughput > 0) ? (throughput / baseThroughput) : 0,
+			(unsigned long)(m_numberOfCharts - exported));
+
+		if (threads == numberOfCores)
+		{
+			break;
+		}
+	}
+
+	return 0;
+}
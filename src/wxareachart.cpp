@@ -32,7 +32,6 @@
 */
 
 #include "wxareachart.h"
-#include <wx/dcmemory.h>
 #include <sstream>
 
 wxAreaChartDataset::wxAreaChartDataset(
@@ -82,47 +81,36 @@ const wxVector<wxAreaChartDataset::ptr>& wxAreaChartData::GetDatasets() const
     return m_datasets;
 }
 
-wxAreaChart::Point::Point(
-    wxPoint2DDouble value,
-    const wxChartTooltipProvider::ptr tooltipProvider,
-    wxDouble x,
-    wxDouble y,
-    wxDouble radius,
-    unsigned int strokeWidth,
-    const wxColor &fillColor,
-    wxDouble hitDetectionRange)
-    : wxChartPoint(x, y, radius, tooltipProvider, wxChartPointOptions(strokeWidth,fillColor,fillColor)),
-    m_value(value), m_hitDetectionRange(hitDetectionRange)
+wxAreaChart::TooltipProvider::TooltipProvider(const wxAreaChartDataset::ptr dataset)
+    : m_dataset(dataset)
 {
 }
 
-wxPoint2DDouble wxAreaChart::Point::GetTooltipPosition() const
+wxString wxAreaChart::TooltipProvider::GetTooltipTitle(size_t index) const
 {
-    wxPoint2DDouble position = wxChartPoint::GetTooltipPosition();
-    position.m_y -= 10;
-    return position;
+    return "";
 }
 
-bool wxAreaChart::Point::HitTest(const wxPoint &point) const
+wxString wxAreaChart::TooltipProvider::GetTooltipText(size_t index) const
 {
-    wxDouble distance = (point.x - GetPosition().m_x);
-    if (distance < 0)
-    {
-        distance = -distance;
-    }
-    return (distance < m_hitDetectionRange);
+    std::stringstream tooltip;
+    tooltip << "(" << m_dataset->GetData()[index].m_x << "," << m_dataset->GetData()[index].m_y << ")";
+    return tooltip.str();
 }
 
-wxPoint2DDouble wxAreaChart::Point::GetValue() const
+wxColor wxAreaChart::TooltipProvider::GetAssociatedColor(size_t index) const
 {
-    return m_value;
+    return m_dataset->GetLineColor();
 }
 
-wxAreaChart::Dataset::Dataset(bool showDots,
-    bool showLine,
-    const wxColor &lineColor)
-    : m_showDots(showDots), m_showLine(showLine),
-    m_lineColor(lineColor)
+wxAreaChart::Dataset::Dataset(const wxAreaChartDataset::ptr data,
+    const wxChartDatasetTooltipProvider::ptr tooltipProvider,
+    wxDouble dotRadius,
+    wxDouble hitDetectionRange,
+    const wxChartPointOptions &dotOptions)
+    : m_showDots(data->ShowDots()), m_showLine(data->ShowLine()), m_lineColor(data->GetLineColor()), m_data(data),
+    m_tooltipProvider(tooltipProvider),
+    m_points(data->GetData().size(), dotRadius, hitDetectionRange, dotOptions)
 {
 }
 
@@ -141,19 +129,57 @@ const wxColor& wxAreaChart::Dataset::GetLineColor() const
     return m_lineColor;
 }
 
-const wxVector<wxAreaChart::Point::ptr>& wxAreaChart::Dataset::GetPoints() const
+const wxVector<wxPoint2DDouble>& wxAreaChart::Dataset::GetValues() const
+{
+    return m_data->GetData();
+}
+
+const wxChartDatasetTooltipProvider::ptr& wxAreaChart::Dataset::GetTooltipProvider() const
+{
+    return m_tooltipProvider;
+}
+
+const wxChartPointSeries& wxAreaChart::Dataset::GetPoints() const
 {
     return m_points;
 }
 
-void wxAreaChart::Dataset::AppendPoint(Point::ptr point)
+wxChartPointSeries& wxAreaChart::Dataset::GetPoints()
+{
+    return m_points;
+}
+
+wxAreaChart::Point::Point(const Dataset &dataset,
+                          size_t index)
+    : m_dataset(dataset), m_index(index)
+{
+}
+
+bool wxAreaChart::Point::HitTest(const wxPoint &point) const
+{
+    wxDouble distance = (point.x - m_dataset.GetPoints().GetPosition(m_index).m_x);
+    if (distance < 0)
+    {
+        distance = -distance;
+    }
+    return (distance < m_dataset.GetPoints().GetHitDetectionRange());
+}
+
+wxPoint2DDouble wxAreaChart::Point::GetTooltipPosition() const
 {
-    m_points.push_back(point);
+    wxPoint2DDouble position = m_dataset.GetPoints().GetPosition(m_index);
+    position.m_y -= 10;
+    return position;
+}
+
+const wxChartTooltipProvider::ptr wxAreaChart::Point::GetTooltipProvider() const
+{
+    return wxChartTooltipProvider::ptr(new wxChartTooltipProviderDatasetItem(m_dataset.GetTooltipProvider(), m_index));
 }
 
 wxAreaChart::wxAreaChart(const wxAreaChartData &data,
                            const wxSize &size)
-    : m_grid(
+    : wxChart(size), m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size,
         GetMinXValue(data.GetDatasets()), GetMaxXValue(data.GetDatasets()),
@@ -166,7 +192,7 @@ wxAreaChart::wxAreaChart(const wxAreaChartData &data,
 wxAreaChart::wxAreaChart(const wxAreaChartData &data,
                              const wxAreaChartOptions &options,
                              const wxSize &size)
-    : m_options(options),
+    : wxChart(size), m_options(options),
     m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size,
@@ -182,46 +208,19 @@ const wxAreaChartOptions& wxAreaChart::GetOptions() const
     return m_options;
 }
 
-void wxAreaChart::Save(const wxString &filename,
-                       const wxBitmapType &type,
-                       const wxSize &size)
-{
-    wxBitmap bmp(size.GetWidth(), size.GetHeight());
-    wxMemoryDC mdc(bmp);
-    mdc.Clear();
-    wxGraphicsContext* gc = wxGraphicsContext::Create(mdc);
-    if (gc)
-    {
-        DoDraw(*gc);
-        bmp.SaveFile(filename, type);
-        delete gc;
-    }
-}
-
 void wxAreaChart::Initialize(const wxAreaChartData &data)
 {
     const wxVector<wxAreaChartDataset::ptr>& datasets = data.GetDatasets();
     for (size_t i = 0; i < datasets.size(); ++i)
     {
-        Dataset::ptr newDataset(new Dataset(datasets[i]->ShowDots(),datasets[i]->ShowLine(),
-            datasets[i]->GetLineColor()));
+        wxChartDatasetTooltipProvider::ptr tooltipProvider(
+            new TooltipProvider(datasets[i])
+            );
 
-        const wxVector<wxPoint2DDouble>& datasetData = datasets[i]->GetData();
-        for (size_t j = 0; j < datasetData.size(); ++j)
-        {
-            std::stringstream tooltip;
-            tooltip << "(" << datasetData[j].m_x << "," << datasetData[j].m_y << ")";
-            wxChartTooltipProvider::ptr tooltipProvider(
-                new wxChartTooltipProviderStatic("", tooltip.str(), datasets[i]->GetLineColor())
-                );
-
-            Point::ptr point(
-                new Point(datasetData[j], tooltipProvider, 20 + j * 10, 0,
-                    m_options.GetDotRadius(), m_options.GetDotStrokeWidth(),
-                    datasets[i]->GetDotColor(),m_options.GetHitDetectionRange()));
-
-            newDataset->AppendPoint(point);
-        }
+        Dataset::ptr newDataset(new Dataset(datasets[i], tooltipProvider,
+            m_options.GetDotRadius(), m_options.GetHitDetectionRange(),
+            wxChartPointOptions(m_options.GetDotStrokeWidth(),
+                datasets[i]->GetDotColor(), datasets[i]->GetDotColor())));
 
         m_datasets.push_back(newDataset);
     }
@@ -338,72 +337,80 @@ void wxAreaChart::DoSetSize(const wxSize &size)
 
 void wxAreaChart::DoFit()
 {
+    m_xIndices.resize(m_datasets.size());
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        m_xIndices[i].Clear();
+        const wxVector<wxPoint2DDouble>& values = m_datasets[i]->GetValues();
+        wxChartPointSeries& points = m_datasets[i]->GetPoints();
+        for (size_t j = 0; j < points.GetCount(); ++j)
         {
-            const Point::ptr& point = points[j];
-            point->SetPosition(m_grid.GetMapping().GetWindowPosition(point->GetValue().m_x, point->GetValue().m_y));
+            points.SetPosition(j, m_grid.GetMapping().GetWindowPosition(values[j].m_x, values[j].m_y));
+            m_xIndices[i].Add(points.GetPosition(j).m_x);
         }
     }
 }
 
 void wxAreaChart::DoDraw(wxGraphicsContext &gc)
 {
-    m_grid.Draw(gc);
+    m_grid.Draw(gc, GetGraphicsCache());
     Fit();
 
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
+        const wxChartPointSeries& points = m_datasets[i]->GetPoints();
 
         wxGraphicsPath path = gc.CreatePath();
 
-        if (points.size() > 0)
+        if (points.GetCount() > 0)
         {
-            auto value = points[0]->GetValue();
-            wxPoint2DDouble firstPosition = m_grid.GetMapping().GetWindowPosition(value.m_x,value.m_y );
+            wxPoint2DDouble firstPosition = points.GetPosition(0);
             path.MoveToPoint(firstPosition);
 
             wxPoint2DDouble lastPosition;
-            for (size_t j = 1; j < points.size(); ++j)
+            for (size_t j = 1; j < points.GetCount(); ++j)
             {
-                value = points[j]->GetValue();
-                lastPosition =  m_grid.GetMapping().GetWindowPosition(value.m_x,value.m_y );
+                lastPosition = points.GetPosition(j);
                 path.AddLineToPoint(lastPosition);
             }
             path.AddLineToPoint(firstPosition);
 
-            wxBrush brush(m_datasets[i]->GetLineColor());
-            gc.SetBrush(brush);
+            gc.SetBrush(GetGraphicsCache().GetBrush(gc, m_datasets[i]->GetLineColor()));
             gc.FillPath(path);
             gc.StrokePath(path);
         }
 
         if (m_datasets[i]->ShowDots())
         {
-            for (size_t j = 0; j < points.size(); ++j)
-            {
-                points[j]->Draw(gc);
-            }
+            wxChartBatchRenderer renderer(gc, GetGraphicsCache());
+            points.Draw(renderer);
         }
     }
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxAreaChart::GetActiveElements(const wxPoint &point)
+void wxAreaChart::GetActiveElements(const wxPoint &point,
+                                    wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
-    for (size_t i = 0; i < m_datasets.size(); ++i)
+    m_activePoints.StartPass();
+    for (size_t i = 0; i < m_xIndices.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        m_hitPoints.clear();
+        m_xIndices[i].Query(point.x, m_options.GetHitDetectionRange(), m_hitPoints);
+        for (size_t j = 0; j < m_hitPoints.size(); ++j)
         {
-            if (points[j]->HitTest(point))
-            {
-                activeElements->push_back(points[j].get());
-            }
+            activeElements.push_back(GetActivePoint(i, m_hitPoints[j]));
         }
     }
-    return activeElements;
+}
+
+const wxChartElement* wxAreaChart::GetActivePoint(size_t datasetIndex,
+                                                  size_t index)
+{
+    const wxChartElement *point = m_activePoints.Get(datasetIndex, index);
+    if (!point)
+    {
+        point = m_activePoints.Add(datasetIndex, index,
+            new Point(*m_datasets[datasetIndex], index));
+    }
+    return point;
 }
@@ -32,6 +32,8 @@
 */
 
 #include "wxbarchart.h"
+#include "wxchartthreadpool.h"
+#include <algorithm>
 #include <sstream>
 
 wxBarChart::Bar::Bar(wxDouble value,
@@ -67,7 +69,7 @@ void wxBarChart::Dataset::AppendBar(Bar::ptr bar)
 
 wxBarChart::wxBarChart(const wxBarChartData &data,
                        const wxSize &size)
-    : m_grid(
+    : wxChart(size), m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size, data.GetLabels(), GetMinValue(data.GetDatasets()),
         GetMaxValue(data.GetDatasets()), m_options.GetGridOptions()
@@ -79,7 +81,7 @@ wxBarChart::wxBarChart(const wxBarChartData &data,
 wxBarChart::wxBarChart(const wxBarChartData &data, 
                        const wxBarChartOptions &options,
                        const wxSize &size)
-    : m_options(options),
+    : wxChart(size), m_options(options),
     m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size, data.GetLabels(), GetMinValue(data.GetDatasets()),
@@ -171,6 +173,51 @@ wxDouble wxBarChart::GetMaxValue(const wxVector<wxBarChartDataset::ptr>& dataset
     return result;
 }
 
+// Positions the bars at a range of positions along
+// the Y axis
+class wxBarChart::BarLoop : public wxChartThreadPool::Loop
+{
+public:
+    BarLoop(const wxChartGridMapping &mapping,
+        const wxVector<Dataset::ptr> &datasets, wxDouble barHeight,
+        wxDouble barSpacing, wxDouble datasetSpacing)
+        : m_mapping(mapping), m_datasets(datasets), m_barHeight(barHeight),
+        m_barSpacing(barSpacing), m_datasetSpacing(datasetSpacing)
+    {
+    }
+
+    virtual void Run(size_t begin, size_t end) wxOVERRIDE
+    {
+        for (size_t i = 0; i < m_datasets.size(); ++i)
+        {
+            const wxVector<Bar::ptr>& bars = m_datasets[i]->GetBars();
+            for (size_t j = begin; (j < end) && (j < bars.size()); ++j)
+            {
+                Bar& bar = *(bars[j]);
+
+                wxPoint2DDouble upperLeftCornerPosition = m_mapping.GetXAxis().GetTickMarkPosition(j + 1);
+                upperLeftCornerPosition.m_y += m_barSpacing + (i * (m_barHeight + m_datasetSpacing));
+
+                wxPoint2DDouble bottomLeftCornerPosition = upperLeftCornerPosition;
+                bottomLeftCornerPosition.m_y += m_barHeight;
+
+                wxPoint2DDouble upperRightCornerPosition = m_mapping.GetWindowPositionAtTickMark(j + 1, bar.GetValue());
+
+                bar.SetPosition(upperLeftCornerPosition);
+                bar.SetSize(upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x,
+                    bottomLeftCornerPosition.m_y - upperLeftCornerPosition.m_y);
+            }
+        }
+    }
+
+private:
+    const wxChartGridMapping &m_mapping;
+    const wxVector<Dataset::ptr> &m_datasets;
+    wxDouble m_barHeight;
+    wxDouble m_barSpacing;
+    wxDouble m_datasetSpacing;
+};
+
 void wxBarChart::DoSetSize(const wxSize &size)
 {
     wxSize newSize(
@@ -182,50 +229,49 @@ void wxBarChart::DoSetSize(const wxSize &size)
 
 void wxBarChart::DoFit()
 {
-    wxDouble barHeight = GetBarHeight();
-
+    size_t count = 0;
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        Dataset& currentDataset = *m_datasets[i];
-        for (size_t j = 0; j < currentDataset.GetBars().size(); ++j)
-        {
-            Bar& bar = *(currentDataset.GetBars()[j]);
-
-            wxPoint2DDouble upperLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(j + 1);
-            upperLeftCornerPosition.m_y += m_options.GetBarSpacing() + (i * (barHeight + m_options.GetDatasetSpacing()));
-
-            wxPoint2DDouble bottomLeftCornerPosition = upperLeftCornerPosition;
-            bottomLeftCornerPosition.m_y += barHeight;
-
-            wxPoint2DDouble upperRightCornerPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(j + 1, bar.GetValue());
+        count = std::max(count, m_datasets[i]->GetBars().size());
+    }
 
-            bar.SetPosition(upperLeftCornerPosition);
-            bar.SetSize(upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x,
-                bottomLeftCornerPosition.m_y - upperLeftCornerPosition.m_y);
-        }
+    // Each bar is only written by the iteration
+    // for its position
+    BarLoop loop(m_grid.GetMapping(), m_datasets, GetBarHeight(),
+        m_options.GetBarSpacing(), m_options.GetDatasetSpacing());
+    wxChartThreadPool *pool = GetFitPool(GetNumberOfBars());
+    if (pool)
+    {
+        pool->RunLoop(loop, count);
+    }
+    else
+    {
+        loop.Run(0, count);
     }
 }
 
 void wxBarChart::DoDraw(wxGraphicsContext &gc)
 {
-    m_grid.Draw(gc);
+    m_grid.Draw(gc, GetGraphicsCache());
 
     Fit();
 
+    // The bars of a dataset share the same style and are
+    // drawn as one batch
+    wxChartBatchRenderer renderer(gc, GetGraphicsCache());
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
         Dataset& currentDataset = *m_datasets[i];
         for (size_t j = 0; j < currentDataset.GetBars().size(); ++j)
         {
-            currentDataset.GetBars()[j]->Draw(gc);
+            currentDataset.GetBars()[j]->Draw(renderer);
         }
     }
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxBarChart::GetActiveElements(const wxPoint &point)
+void wxBarChart::GetActiveElements(const wxPoint &point,
+                                   wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
-
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
         const wxVector<Bar::ptr>& bars = m_datasets[i]->GetBars();
@@ -235,13 +281,21 @@ wxSharedPtr<wxVector<const wxChartElement*> > wxBarChart::GetActiveElements(cons
             {
                 for (size_t k = 0; k < m_datasets.size(); ++k)
                 {
-                    activeElements->push_back(m_datasets[k]->GetBars()[j].get());
+                    activeElements.push_back(m_datasets[k]->GetBars()[j].get());
                 }
             }
         }
     }
+}
 
-    return activeElements;
+size_t wxBarChart::GetNumberOfBars() const
+{
+    size_t result = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        result += m_datasets[i]->GetBars().size();
+    }
+    return result;
 }
 
 wxDouble wxBarChart::GetBarHeight() const
@@ -23,6 +23,7 @@
 /// @file
 
 #include "wxbubblechart.h"
+#include "wxchartthreadpool.h"
 #include <sstream>
 #include <cmath>
 
@@ -84,16 +85,45 @@ const wxVector<wxBubbleChartDataset::ptr>& wxBubbleChartData::GetDatasets() cons
     return m_datasets;
 }
 
+wxBubbleChart::TooltipProvider::TooltipProvider(const wxBubbleChartDataset::ptr dataset)
+    : m_dataset(dataset)
+{
+}
+
+wxString wxBubbleChart::TooltipProvider::GetTooltipTitle(size_t index) const
+{
+    return "";
+}
+
+wxString wxBubbleChart::TooltipProvider::GetTooltipText(size_t index) const
+{
+    std::stringstream tooltip;
+    tooltip << "(" << m_dataset->GetData()[index].m_x << "," << m_dataset->GetData()[index].m_y << ")";
+    return tooltip.str();
+}
+
+wxColor wxBubbleChart::TooltipProvider::GetAssociatedColor(size_t index) const
+{
+    return m_dataset->GetFillColor();
+}
+
 wxBubbleChart::Circle::Circle(wxDoubleTriplet value,
     wxDouble x,
     wxDouble y,
     wxDouble radius,
-    const wxChartTooltipProvider::ptr tooltipProvider,
+    const wxChartDatasetTooltipProvider::ptr tooltipProvider,
+    size_t index,
     const wxChartCircleOptions &options)
-    : wxChartCircle(x, y, radius, tooltipProvider, options), m_value(value)
+    : wxChartCircle(x, y, radius, wxChartTooltipProvider::ptr(), options), m_value(value),
+    m_tooltipProvider(tooltipProvider), m_index(index)
 {
 }
 
+const wxChartTooltipProvider::ptr wxBubbleChart::Circle::GetTooltipProvider() const
+{
+    return wxChartTooltipProvider::ptr(new wxChartTooltipProviderDatasetItem(m_tooltipProvider, m_index));
+}
+
 wxDoubleTriplet wxBubbleChart::Circle::GetValue() const
 {
     return m_value;
@@ -125,9 +155,117 @@ unsigned int wxBubbleChart::Dataset::GetMaxRadius() const
     return m_maxRadius;
 }
 
+// Computes the centers and radii of the circles of
+// a dataset
+class wxBubbleChart::CircleLoop : public wxChartThreadPool::Loop
+{
+public:
+    CircleLoop(const wxChartGridMapping &mapping,
+        const wxVector<Circle::ptr> &circles, wxDouble minRadius,
+        wxDouble radiusFactor, wxDouble zFactor,
+        wxPoint2DDouble *centers, wxDouble *radii)
+        : m_mapping(mapping), m_circles(circles), m_minRadius(minRadius),
+        m_radiusFactor(radiusFactor), m_zFactor(zFactor),
+        m_centers(centers), m_radii(radii)
+    {
+    }
+
+    virtual void Run(size_t begin, size_t end) wxOVERRIDE
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            wxDoubleTriplet value = m_circles[i]->GetValue();
+            m_centers[i] = m_mapping.GetWindowPosition(value.m_x, value.m_y);
+            m_radii[i] = m_minRadius + (sqrt(value.m_z * m_zFactor) * m_radiusFactor);
+        }
+    }
+
+private:
+    const wxChartGridMapping &m_mapping;
+    const wxVector<Circle::ptr> &m_circles;
+    wxDouble m_minRadius;
+    wxDouble m_radiusFactor;
+    wxDouble m_zFactor;
+    wxPoint2DDouble *m_centers;
+    wxDouble *m_radii;
+};
+
+wxBubbleChart::Layout::Layout(const wxChartGridMapping &mapping,
+                              const wxVector<Dataset::ptr> &datasets,
+                              wxDouble minZValue,
+                              wxDouble maxZValue,
+                              wxChartThreadPool *pool)
+    : m_mapping(mapping), m_datasets(datasets),
+    m_minZValue(minZValue), m_maxZValue(maxZValue), m_pool(pool)
+{
+}
+
+void wxBubbleChart::Layout::Compute()
+{
+    wxDouble zFactor = 1 / (m_maxZValue - m_minZValue);
+
+    size_t numberOfCircles = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        numberOfCircles += m_datasets[i]->GetCircles().size();
+    }
+    m_centers.resize(numberOfCircles);
+    m_radii.resize(numberOfCircles);
+
+    // Each dataset writes to its own part of the lists
+    size_t offset = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        wxDouble minRadius = m_datasets[i]->GetMinRadius();
+        wxDouble maxRadius = m_datasets[i]->GetMaxRadius();
+        wxDouble radiusFactor = (maxRadius);
+        const wxVector<Circle::ptr>& circles = m_datasets[i]->GetCircles();
+        if (circles.empty())
+        {
+            continue;
+        }
+
+        CircleLoop loop(m_mapping, circles, minRadius, radiusFactor, zFactor,
+            &m_centers[offset], &m_radii[offset]);
+        if (m_pool)
+        {
+            m_pool->RunLoop(loop, circles.size());
+        }
+        else
+        {
+            loop.Run(0, circles.size());
+        }
+        offset += circles.size();
+    }
+
+    // The index is filled by a single thread so that
+    // the items are always added in the same order
+    m_index.Clear();
+    for (size_t i = 0; i < numberOfCircles; ++i)
+    {
+        m_index.Add(m_centers[i], m_radii[i]);
+    }
+    m_index.Build();
+}
+
+const wxVector<wxPoint2DDouble>& wxBubbleChart::Layout::GetCenters() const
+{
+    return m_centers;
+}
+
+const wxVector<wxDouble>& wxBubbleChart::Layout::GetRadii() const
+{
+    return m_radii;
+}
+
+wxChartSpatialIndex& wxBubbleChart::Layout::GetIndex()
+{
+    return m_index;
+}
+
 wxBubbleChart::wxBubbleChart(const wxBubbleChartData &data, 
                              const wxSize &size)
-    : m_grid(
+    : wxChart(size), m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size,
         GetMinXValue(data.GetDatasets()), GetMaxXValue(data.GetDatasets()),
@@ -151,17 +289,15 @@ void wxBubbleChart::Initialize(const wxBubbleChartData &data)
     {
         Dataset::ptr newDataset(new Dataset(datasets[i]->GetMinRadius(), datasets[i]->GetMaxRadius()));
 
+        wxChartDatasetTooltipProvider::ptr tooltipProvider(
+            new TooltipProvider(datasets[i])
+            );
+
         const wxVector<wxDoubleTriplet>& datasetData = datasets[i]->GetData();
         for (size_t j = 0; j < datasetData.size(); ++j)
         {
-            std::stringstream tooltip;
-            tooltip << "(" << datasetData[j].m_x << "," << datasetData[j].m_y << ")";
-            wxChartTooltipProvider::ptr tooltipProvider(
-                new wxChartTooltipProviderStatic("", tooltip.str(), datasets[i]->GetFillColor())
-                );
-
             Circle::ptr circle(
-                new Circle(datasetData[j], 0, 0, 1, tooltipProvider,
+                new Circle(datasetData[j], 0, 0, 1, tooltipProvider, j,
                     wxChartCircleOptions(datasets[i]->GetOutlineWidth(),
                         datasets[i]->GetOutlineColor(), datasets[i]->GetFillColor()))
                 );
@@ -325,36 +461,63 @@ wxDouble wxBubbleChart::GetMaxZValue(const wxVector<wxBubbleChartDataset::ptr>&
 
 void wxBubbleChart::DoFit()
 {
-    wxDouble zFactor = 1 / (m_maxZValue - m_minZValue);
+    Layout layout(m_grid.GetMapping(), m_datasets, m_minZValue, m_maxZValue,
+        GetFitPool(GetNumberOfCircles()));
+    layout.Compute();
+    ApplyLayout(layout);
+}
+
+wxChart::Layout* wxBubbleChart::CreateLayout()
+{
+    const size_t threshold = m_options.GetBackgroundFitThreshold();
+    const size_t numberOfCircles = GetNumberOfCircles();
+    if ((threshold == 0) || (numberOfCircles <= threshold))
+    {
+        return 0;
+    }
 
+    // The grid keeps updating its axes while the
+    // layout is computed
+    return new Layout(m_grid.GetMapping().Clone(), m_datasets,
+        m_minZValue, m_maxZValue, GetFitPool(numberOfCircles));
+}
+
+void wxBubbleChart::ApplyLayout(wxChart::Layout &layout)
+{
+    Layout &bubbleLayout = static_cast<Layout&>(layout);
+    const wxVector<wxPoint2DDouble>& centers = bubbleLayout.GetCenters();
+    const wxVector<wxDouble>& radii = bubbleLayout.GetRadii();
+
+    size_t k = 0;
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        wxDouble minRadius = m_datasets[i]->GetMinRadius();
-        wxDouble maxRadius = m_datasets[i]->GetMaxRadius();
-        wxDouble radiusFactor = (maxRadius);
         const wxVector<Circle::ptr>& circles = m_datasets[i]->GetCircles();
         for (size_t j = 0; j < circles.size(); ++j)
         {
-            const Circle::ptr& circle = circles[j];
-            circle->SetCenter(m_grid.GetMapping().GetWindowPosition(circle->GetValue().m_x, circle->GetValue().m_y));
-            circle->SetRadius(minRadius + (sqrt(circle->GetValue().m_z * zFactor) * radiusFactor));
+            circles[j]->SetCenter(centers[k]);
+            circles[j]->SetRadius(radii[k]);
+            ++k;
         }
     }
+    m_index.Swap(bubbleLayout.GetIndex());
 }
 
 void wxBubbleChart::DoDraw(wxGraphicsContext &gc)
 {
-    m_grid.Draw(gc);
+    m_grid.Draw(gc, GetGraphicsCache());
 
     Fit();
 
+    // The circles of a dataset share the same style and
+    // are drawn as one batch
+    wxChartBatchRenderer renderer(gc, GetGraphicsCache());
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
         const wxVector<Circle::ptr>& circles = m_datasets[i]->GetCircles();
         for (size_t j = 0; j < circles.size(); ++j)
         {
             const Circle::ptr& circle = circles[j];
-            circle->Draw(gc);
+            circle->Draw(renderer);
         }
     }
 }
@@ -364,21 +527,39 @@ void wxBubbleChart::DoSetSize(const wxSize &size)
     m_grid.Resize(size);
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxBubbleChart::GetActiveElements(const wxPoint &point)
+void wxBubbleChart::GetActiveElements(const wxPoint &point,
+                                      wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
-
-    for (size_t i = 0; i < m_datasets.size(); ++i)
+    m_hitCircles.clear();
+    m_index.Query(point, m_hitCircles);
+
+    // The items of the index are the circles of all the
+    // datasets, numbered in order. The query returns them
+    // in increasing order.
+    size_t datasetIndex = 0;
+    size_t firstItem = 0;
+    for (size_t i = 0; i < m_hitCircles.size(); ++i)
     {
-        const wxVector<Circle::ptr>& circles = m_datasets[i]->GetCircles();
-        for (size_t j = 0; j < circles.size(); ++j)
+        while (m_hitCircles[i] >= (firstItem + m_datasets[datasetIndex]->GetCircles().size()))
         {
-            if (circles[j]->HitTest(point))
-            {
-                activeElements->push_back(circles[j].get());
-            }
+            firstItem += m_datasets[datasetIndex]->GetCircles().size();
+            ++datasetIndex;
+        }
+
+        const Circle::ptr& circle = m_datasets[datasetIndex]->GetCircles()[m_hitCircles[i] - firstItem];
+        if (circle->HitTest(point))
+        {
+            activeElements.push_back(circle.get());
         }
     }
+}
 
-    return activeElements;
+size_t wxBubbleChart::GetNumberOfCircles() const
+{
+    size_t result = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        result += m_datasets[i]->GetCircles().size();
+    }
+    return result;
 }
@@ -23,6 +23,7 @@
 /// @file
 
 #include "wxcandlestickchart.h"
+#include "wxchartthreadpool.h"
 #include <wx/brush.h>
 #include <wx/pen.h>
 #include <sstream>
@@ -70,14 +71,41 @@ const wxVector<wxChartOHLCData>& wxCandlestickChartData::GetData() const
     return m_data;
 }
 
+wxCandlestickChart::TooltipProvider::TooltipProvider(const wxSharedPtr<wxCandlestickChartData> data)
+    : m_data(data)
+{
+}
+
+wxString wxCandlestickChart::TooltipProvider::GetTooltipTitle(size_t index) const
+{
+    return m_data->GetLabels()[index];
+}
+
+wxString wxCandlestickChart::TooltipProvider::GetTooltipText(size_t index) const
+{
+    std::stringstream tooltip;
+    tooltip << "O: " << m_data->GetData()[index].GetOpenValue()
+        << "\r\nH: " << m_data->GetData()[index].GetHighValue()
+        << "\r\nL: " << m_data->GetData()[index].GetLowValue()
+        << "\r\nC: " << m_data->GetData()[index].GetCloseValue();
+    return tooltip.str();
+}
+
+wxColor wxCandlestickChart::TooltipProvider::GetAssociatedColor(size_t index) const
+{
+    return *wxWHITE;
+}
+
 wxCandlestickChart::Candlestick::Candlestick(const wxChartOHLCData &data,
     const wxColor &lineColor,
     unsigned int lineWidth,
     const wxColor &upFillColor,
     const wxColor &downFillColor,
     unsigned int rectangleWidth,
-    const wxChartTooltipProvider::ptr tooltipProvider)
-    : wxChartElement(tooltipProvider), m_data(data), m_lowPoint(0, 0), m_highPoint(0, 0),
+    const wxChartDatasetTooltipProvider::ptr tooltipProvider,
+    size_t index)
+    : wxChartElement(wxChartTooltipProvider::ptr()), m_data(data),
+    m_tooltipProvider(tooltipProvider), m_index(index), m_lowPoint(0, 0), m_highPoint(0, 0),
     m_openPoint(0, 0), m_closePoint(0, 0), m_lineColor(lineColor), m_lineWidth(lineWidth),
     m_upFillColor(upFillColor), m_downFillColor(downFillColor), m_rectangleWidth(rectangleWidth)
 {
@@ -90,96 +118,127 @@ bool wxCandlestickChart::Candlestick::HitTest(const wxPoint &point) const
         (point.x <= (m_lowPoint.m_x + (m_rectangleWidth / 2))));
 }
 
+const wxChartTooltipProvider::ptr wxCandlestickChart::Candlestick::GetTooltipProvider() const
+{
+    return wxChartTooltipProvider::ptr(new wxChartTooltipProviderDatasetItem(m_tooltipProvider, m_index));
+}
+
 wxPoint2DDouble wxCandlestickChart::Candlestick::GetTooltipPosition() const
 {
     return wxPoint2DDouble(m_lowPoint.m_x, m_highPoint.m_y + (m_lowPoint.m_y - m_highPoint.m_y) / 2);
 }
 
-void wxCandlestickChart::Candlestick::Draw(wxGraphicsContext &gc)
+bool wxCandlestickChart::Candlestick::IsUp() const
 {
-    if (m_data.GetCloseValue() >= m_data.GetOpenValue())
-    {
-        wxGraphicsPath path = gc.CreatePath();
-        path.MoveToPoint(m_highPoint);
-        path.AddLineToPoint(m_closePoint);
-
-        wxDouble halfWidth = m_rectangleWidth / 2;
-        wxDouble rectangleHeight = m_openPoint.m_y - m_closePoint.m_y;
-        if (rectangleHeight < 2)
-        {
-            rectangleHeight = 2;
-        }
-        path.AddRectangle(m_closePoint.m_x - halfWidth, m_closePoint.m_y,
-            m_rectangleWidth, rectangleHeight);
+    return (m_data.GetCloseValue() >= m_data.GetOpenValue());
+}
 
-        path.MoveToPoint(m_openPoint);
-        path.AddLineToPoint(m_lowPoint);
+void wxCandlestickChart::Candlestick::Draw(wxChartBatchRenderer &renderer) const
+{
+    const bool up = IsUp();
+    const wxPoint2DDouble &top = up ? m_closePoint : m_openPoint;
+    const wxPoint2DDouble &bottom = up ? m_openPoint : m_closePoint;
 
-        wxBrush brush(m_upFillColor);
-        gc.SetBrush(brush);
-        gc.FillPath(path);
+    renderer.SetStyle(up ? m_upFillColor : m_downFillColor, m_lineColor, m_lineWidth);
 
-        wxPen pen(m_lineColor, m_lineWidth);
-        gc.SetPen(pen);
+    renderer.AddLine(m_highPoint, top);
 
-        gc.StrokePath(path);
+    wxDouble halfWidth = m_rectangleWidth / 2;
+    wxDouble rectangleHeight = bottom.m_y - top.m_y;
+    if (rectangleHeight < 2)
+    {
+        rectangleHeight = 2;
     }
-    else
+    renderer.AddRectangle(top.m_x - halfWidth, top.m_y,
+        m_rectangleWidth, rectangleHeight);
+
+    renderer.AddLine(bottom, m_lowPoint);
+}
+
+const wxChartOHLCData& wxCandlestickChart::Candlestick::GetData() const
+{
+    return m_data;
+}
+
+void wxCandlestickChart::Candlestick::SetPoints(const wxPoint2DDouble &lowPoint,
+                                                const wxPoint2DDouble &highPoint,
+                                                const wxPoint2DDouble &openPoint,
+                                                const wxPoint2DDouble &closePoint)
+{
+    m_lowPoint = lowPoint;
+    m_highPoint = highPoint;
+    m_openPoint = openPoint;
+    m_closePoint = closePoint;
+}
+
+// Computes the 4 points of each candlestick
+class wxCandlestickChart::CandlestickLoop : public wxChartThreadPool::Loop
+{
+public:
+    CandlestickLoop(const wxChartGridMapping &mapping,
+        const wxVector<Candlestick::ptr> &candlesticks,
+        wxVector<wxPoint2DDouble> &points)
+        : m_mapping(mapping), m_candlesticks(candlesticks), m_points(points)
     {
-        wxGraphicsPath path = gc.CreatePath();
-        path.MoveToPoint(m_highPoint);
-        path.AddLineToPoint(m_openPoint);
+    }
 
-        wxDouble halfWidth = m_rectangleWidth / 2;
-        wxDouble rectangleHeight = m_closePoint.m_y - m_openPoint.m_y;
-        if (rectangleHeight < 2)
+    virtual void Run(size_t begin, size_t end) wxOVERRIDE
+    {
+        for (size_t i = begin; i < end; ++i)
         {
-            rectangleHeight = 2;
+            const wxChartOHLCData &data = m_candlesticks[i]->GetData();
+            m_points[4 * i] = m_mapping.GetWindowPositionAtTickMark(i, data.GetLowValue());
+            m_points[(4 * i) + 1] = m_mapping.GetWindowPositionAtTickMark(i, data.GetHighValue());
+            m_points[(4 * i) + 2] = m_mapping.GetWindowPositionAtTickMark(i, data.GetOpenValue());
+            m_points[(4 * i) + 3] = m_mapping.GetWindowPositionAtTickMark(i, data.GetCloseValue());
         }
-        path.AddRectangle(m_openPoint.m_x - halfWidth, m_openPoint.m_y,
-            m_rectangleWidth, rectangleHeight);
-
-        path.MoveToPoint(m_closePoint);
-        path.AddLineToPoint(m_lowPoint);
+    }
 
-        wxBrush brush(m_downFillColor);
-        gc.SetBrush(brush);
-        gc.FillPath(path);
+private:
+    const wxChartGridMapping &m_mapping;
+    const wxVector<Candlestick::ptr> &m_candlesticks;
+    wxVector<wxPoint2DDouble> &m_points;
+};
 
-        wxPen pen(m_lineColor, m_lineWidth);
-        gc.SetPen(pen);
+wxCandlestickChart::Layout::Layout(const wxChartGridMapping &mapping,
+                                   const wxVector<Candlestick::ptr> &candlesticks,
+                                   wxChartThreadPool *pool)
+    : m_mapping(mapping), m_candlesticks(candlesticks), m_pool(pool)
+{
+}
 
-        gc.StrokePath(path);
+void wxCandlestickChart::Layout::Compute()
+{
+    m_points.resize(4 * m_candlesticks.size());
+    CandlestickLoop loop(m_mapping, m_candlesticks, m_points);
+    if (m_pool)
+    {
+        m_pool->RunLoop(loop, m_candlesticks.size());
+    }
+    else
+    {
+        loop.Run(0, m_candlesticks.size());
     }
 }
 
-void wxCandlestickChart::Candlestick::Update(const wxChartGridMapping& mapping,
-    size_t index)
+const wxVector<wxPoint2DDouble>& wxCandlestickChart::Layout::GetPoints() const
 {
-    m_lowPoint = mapping.GetWindowPositionAtTickMark(index, m_data.GetLowValue());
-    m_highPoint = mapping.GetWindowPositionAtTickMark(index, m_data.GetHighValue());
-    m_openPoint = mapping.GetWindowPositionAtTickMark(index, m_data.GetOpenValue());
-    m_closePoint = mapping.GetWindowPositionAtTickMark(index, m_data.GetCloseValue());
+    return m_points;
 }
 
 wxCandlestickChart::wxCandlestickChart(const wxCandlestickChartData &data,
                                        const wxSize &size)
-    : m_grid(
+    : wxChart(size), m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetTop()),
         size, data.GetLabels(), GetMinValue(data), GetMaxValue(data), m_options.GetGridOptions()
         )
 {
+    wxChartDatasetTooltipProvider::ptr tooltipProvider(
+        new TooltipProvider(wxSharedPtr<wxCandlestickChartData>(new wxCandlestickChartData(data)))
+        );
+
     for (size_t i = 0; i < data.GetData().size(); ++i)
     {
-        std::stringstream tooltip;
-        tooltip << "O: " << data.GetData()[i].GetOpenValue()
-            << "\r\nH: " << data.GetData()[i].GetHighValue()
-            << "\r\nL: " << data.GetData()[i].GetLowValue()
-            << "\r\nC: " << data.GetData()[i].GetCloseValue();
-        wxChartTooltipProvider::ptr tooltipProvider(
-            new wxChartTooltipProviderStatic(data.GetLabels()[i], tooltip.str(), *wxWHITE)
-            );
-
         Candlestick::ptr newCandlestick(new Candlestick(
             data.GetData()[i],
             data.GetLineColor(),
@@ -187,7 +246,8 @@ wxCandlestickChart::wxCandlestickChart(const wxCandlestickChartData &data,
             data.GetUpFillColor(),
             data.GetDownFillColor(),
             data.GetRectangleWidth(),
-            tooltipProvider
+            tooltipProvider,
+            i
             ));
         m_data.push_back(newCandlestick);
     }
@@ -251,33 +311,69 @@ void wxCandlestickChart::DoSetSize(const wxSize &size)
 
 void wxCandlestickChart::DoFit()
 {
+    Layout layout(m_grid.GetMapping(), m_data, GetFitPool(m_data.size()));
+    layout.Compute();
+    ApplyLayout(layout);
+}
+
+wxChart::Layout* wxCandlestickChart::CreateLayout()
+{
+    const size_t threshold = m_options.GetBackgroundFitThreshold();
+    if ((threshold == 0) || (m_data.size() <= threshold))
+    {
+        return 0;
+    }
+
+    // The grid keeps updating its axes while the
+    // layout is computed
+    return new Layout(m_grid.GetMapping().Clone(), m_data,
+        GetFitPool(m_data.size()));
+}
+
+void wxCandlestickChart::ApplyLayout(wxChart::Layout &layout)
+{
+    const wxVector<wxPoint2DDouble>& points = static_cast<Layout&>(layout).GetPoints();
     for (size_t i = 0; i < m_data.size(); ++i)
     {
-        m_data[i]->Update(m_grid.GetMapping(), i);
+        m_data[i]->SetPoints(points[4 * i], points[(4 * i) + 1],
+            points[(4 * i) + 2], points[(4 * i) + 3]);
     }
 }
 
 void wxCandlestickChart::DoDraw(wxGraphicsContext &gc)
 {
-    m_grid.Draw(gc);
+    m_grid.Draw(gc, GetGraphicsCache());
 
     Fit();
 
+    // The candlesticks don't overlap so all the rising ones
+    // are drawn first and then all the falling ones, which
+    // only takes two batches
+    wxChartBatchRenderer renderer(gc, GetGraphicsCache());
+    for (size_t i = 0; i < m_data.size(); ++i)
+    {
+        if (m_data[i]->IsUp())
+        {
+            m_data[i]->Draw(renderer);
+        }
+    }
     for (size_t i = 0; i < m_data.size(); ++i)
     {
-        m_data[i]->Draw(gc);
+        if (!m_data[i]->IsUp())
+        {
+            m_data[i]->Draw(renderer);
+        }
     }
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxCandlestickChart::GetActiveElements(const wxPoint &point)
+void wxCandlestickChart::GetActiveElements(const wxPoint &point,
+                                           wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
     for (size_t i = 0; i < m_data.size(); ++i)
     {
         if (m_data[i]->HitTest(point))
         {
-            activeElements->push_back(m_data[i].get());
+            activeElements.push_back(m_data[i].get());
         }
     }
-    return activeElements;
 }
@@ -23,28 +23,267 @@
 #include "wxchart.h"
 #include "wxcharttooltip.h"
 #include "wxchartmultitooltip.h"
+#include "wxchartthreadpool.h"
+#include <wx/module.h>
+
+wxDEFINE_EVENT(wxEVT_CHART_LAYOUT_READY, wxThreadEvent);
+
+// The pool shared by all the charts to compute their
+// positions in parallel. A pool per chart would start
+// one thread per processor for every chart.
+static wxChartThreadPool *fitPool = 0;
+static wxCriticalSection fitPoolLock;
+
+// Stops the threads of the fit pool before wxWidgets
+// is cleaned up
+class wxChartFitPoolModule : public wxModule
+{
+public:
+    virtual bool OnInit() wxOVERRIDE
+    {
+        return true;
+    }
+
+    virtual void OnExit() wxOVERRIDE
+    {
+        delete fitPool;
+        fitPool = 0;
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxChartFitPoolModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxChartFitPoolModule, wxModule);
+
+wxChart::Layout::~Layout()
+{
+}
+
+// Computes a layout on the pool of the chart and hands
+// it back to the chart
+class wxChart::LayoutTask : public wxChartThreadPool::Task
+{
+public:
+    LayoutTask(wxChart &chart, Layout *layout, wxEvtHandler &handler)
+        : m_chart(chart), m_layout(layout), m_handler(handler)
+    {
+    }
+
+    virtual void Run() wxOVERRIDE
+    {
+        m_layout->Compute();
+        m_chart.OnLayoutComputed(m_layout);
+        wxQueueEvent(&m_handler, new wxThreadEvent(wxEVT_CHART_LAYOUT_READY));
+    }
+
+private:
+    wxChart &m_chart;
+    Layout *m_layout;
+    wxEvtHandler &m_handler;
+};
 
 wxChart::wxChart()
-    : m_needsFit(true),
-    m_activeElements(new wxVector<const wxChartElement*>())
+    : m_size(wxDefaultSize), m_needsFit(true), m_revision(0),
+    m_fitted(false), m_layoutHandler(0), m_layoutPool(0),
+    m_layoutInProgress(false), m_layoutQueued(false),
+    m_layoutDiscarded(false), m_completedLayout(0)
 {
 }
 
+wxChart::wxChart(const wxSize &size)
+    : m_size(size), m_needsFit(true), m_revision(0),
+    m_fitted(false), m_layoutHandler(0), m_layoutPool(0),
+    m_layoutInProgress(false), m_layoutQueued(false),
+    m_layoutDiscarded(false), m_completedLayout(0)
+{
+}
+
+wxChart::~wxChart()
+{
+    // Deleting the pool waits for the layout being
+    // computed
+    delete m_layoutPool;
+    delete m_completedLayout;
+}
+
+const wxSize& wxChart::GetSize() const
+{
+    return m_size;
+}
+
 void wxChart::SetSize(const wxSize &size)
 {
+    m_size = size;
     DoSetSize(size);
-    m_needsFit = true;
+    Invalidate();
 }
 
 void wxChart::Draw(wxGraphicsContext &gc)
 {
-    DoDraw(gc);
+    DrawChart(gc);
     DrawTooltips(gc);
 }
 
-void wxChart::ActivateElementsAt(const wxPoint &point)
+void wxChart::DrawChart(wxGraphicsContext &gc)
+{
+    DoDraw(gc);
+}
+
+void wxChart::DrawChart(wxGraphicsContext &gc,
+                        wxEvtHandler &layoutHandler)
+{
+    m_layoutHandler = &layoutHandler;
+    DoDraw(gc);
+    m_layoutHandler = 0;
+}
+
+bool wxChart::ApplyBackgroundFit()
+{
+    Layout *layout = 0;
+    {
+        wxMutexLocker lock(m_layoutMutex);
+        layout = m_completedLayout;
+        m_completedLayout = 0;
+    }
+
+    if (!layout)
+    {
+        return false;
+    }
+
+    bool changed = false;
+    if (!m_layoutDiscarded)
+    {
+        ApplyLayout(*layout);
+        ++m_revision;
+        changed = true;
+    }
+    delete layout;
+
+    m_layoutInProgress = false;
+    m_layoutDiscarded = false;
+    if (m_layoutQueued)
+    {
+        // The chart was invalidated again while the layout
+        // was being computed, the next draw starts a new one.
+        // The revision must change too or a control would
+        // keep showing its cached drawing.
+        m_layoutQueued = false;
+        Invalidate();
+        changed = true;
+    }
+
+    return changed;
+}
+
+bool wxChart::ActivateElementsAt(const wxPoint &point)
+{
+    m_candidateElements.clear();
+    GetActiveElements(point, m_candidateElements);
+    if (m_candidateElements.size() == m_activeElements.size())
+    {
+        bool changed = false;
+        for (size_t i = 0; i < m_activeElements.size(); ++i)
+        {
+            if (m_candidateElements[i] != m_activeElements[i])
+            {
+                changed = true;
+                break;
+            }
+        }
+        if (!changed)
+        {
+            return false;
+        }
+    }
+
+    m_activeElements.swap(m_candidateElements);
+    return true;
+}
+
+unsigned int wxChart::GetRevision() const
+{
+    return m_revision;
+}
+
+wxImage wxChart::RenderToImage(const wxSize &size)
+{
+    wxImage image(size, false);
+    if (!image.IsOk())
+    {
+        return wxImage();
+    }
+    image.SetRGB(wxRect(size), 255, 255, 255);
+
+    wxSize previousSize = m_size;
+    if (size != previousSize)
+    {
+        SetSize(size);
+    }
+    ForceSynchronousFit();
+
+    wxGraphicsContext* gc = wxGraphicsContext::Create(image);
+    if (gc)
+    {
+        DrawChart(*gc);
+        // The image is only updated when the context
+        // is destroyed
+        delete gc;
+    }
+    else
+    {
+        image = wxImage();
+    }
+
+    if ((size != previousSize) && (previousSize != wxDefaultSize))
+    {
+        SetSize(previousSize);
+    }
+
+    return image;
+}
+
+bool wxChart::RenderToBuffer(const wxSize &size,
+                             unsigned char *rgba,
+                             size_t stride)
 {
-    m_activeElements = GetActiveElements(point);
+    if (stride < (4 * (size_t)size.GetWidth()))
+    {
+        return false;
+    }
+
+    wxImage image = RenderToImage(size);
+    if (!image.IsOk())
+    {
+        return false;
+    }
+
+    const unsigned char *rgb = image.GetData();
+    const unsigned char *alpha = image.HasAlpha() ? image.GetAlpha() : 0;
+    for (int y = 0; y < size.GetHeight(); ++y)
+    {
+        unsigned char *row = rgba + (y * stride);
+        for (int x = 0; x < size.GetWidth(); ++x)
+        {
+            row[0] = rgb[0];
+            row[1] = rgb[1];
+            row[2] = rgb[2];
+            row[3] = alpha ? *alpha++ : 255;
+            row += 4;
+            rgb += 3;
+        }
+    }
+
+    return true;
+}
+
+bool wxChart::Save(const wxString &filename,
+                   const wxBitmapType &type,
+                   const wxSize &size)
+{
+    wxImage image = RenderToImage(size);
+    return (image.IsOk() && image.SaveFile(filename, type));
 }
 
 void wxChart::Fit()
@@ -54,31 +293,122 @@ void wxChart::Fit()
         return;
     }
 
+    // The first fit is always done synchronously so
+    // that there is something to draw
+    if (m_layoutHandler && m_fitted)
+    {
+        if (m_layoutInProgress)
+        {
+            m_layoutQueued = true;
+            m_needsFit = false;
+            return;
+        }
+
+        Layout *layout = CreateLayout();
+        if (layout)
+        {
+            if (!m_layoutPool)
+            {
+                m_layoutPool = new wxChartThreadPool(1);
+            }
+            m_layoutInProgress = true;
+            m_layoutPool->Submit(new LayoutTask(*this, layout, *m_layoutHandler));
+            m_needsFit = false;
+            return;
+        }
+    }
+
     DoFit();
 
+    // The layout being computed, if any, is now out
+    // of date
+    m_layoutDiscarded = m_layoutInProgress;
+    m_layoutQueued = false;
+    m_fitted = true;
     m_needsFit = false;
 }
 
+wxChart::Layout* wxChart::CreateLayout()
+{
+    return 0;
+}
+
+void wxChart::ApplyLayout(Layout &WXUNUSED(layout))
+{
+}
+
+void wxChart::OnLayoutComputed(Layout *layout)
+{
+    wxMutexLocker lock(m_layoutMutex);
+    delete m_completedLayout;
+    m_completedLayout = layout;
+}
+
+void wxChart::ForceSynchronousFit()
+{
+    // The grid may already be laid out for the current
+    // size while the elements are still at the positions
+    // computed for the previous one
+    if (m_layoutInProgress)
+    {
+        m_needsFit = true;
+    }
+}
+
+void wxChart::Invalidate()
+{
+    m_needsFit = true;
+    ++m_revision;
+}
+
+void wxChart::ResetActiveElements()
+{
+    m_activeElements.clear();
+}
+
+wxChartGraphicsCache& wxChart::GetGraphicsCache()
+{
+    return m_graphicsCache;
+}
+
+wxChartThreadPool* wxChart::GetFitPool(size_t numberOfElements)
+{
+    const size_t threshold = GetOptions().GetParallelFitThreshold();
+    if ((threshold == 0) || (numberOfElements <= threshold) ||
+        (wxThread::GetCPUCount() <= 1))
+    {
+        return 0;
+    }
+
+    wxCriticalSectionLocker locker(fitPoolLock);
+    if (!fitPool)
+    {
+        fitPool = new wxChartThreadPool();
+    }
+    return fitPool;
+}
+
 void wxChart::DrawTooltips(wxGraphicsContext &gc)
 {
-    if (m_activeElements->size() == 1)
+    if (m_activeElements.size() == 1)
     {
         // If only one element is active draw a normal tooltip
-        wxChartTooltip tooltip((*m_activeElements)[0]->GetTooltipPosition(),
-            (*m_activeElements)[0]->GetTooltipProvider()->GetTooltipText());
-        tooltip.Draw(gc);
+        wxChartTooltip tooltip(m_activeElements[0]->GetTooltipPosition(),
+            m_activeElements[0]->GetTooltipProvider()->GetTooltipText(),
+            m_tooltipOptions);
+        tooltip.Draw(gc, GetGraphicsCache());
     }
-    else if (m_activeElements->size() > 1)
+    else if (m_activeElements.size() > 1)
     {
         // If more than one element is active draw a multi-tooltip
-        wxChartMultiTooltip multiTooltip((*m_activeElements)[0]->GetTooltipProvider()->GetTooltipTitle(),
+        wxChartMultiTooltip multiTooltip(m_activeElements[0]->GetTooltipProvider()->GetTooltipTitle(),
             GetOptions().GetMultiTooltipOptions());
-        for (size_t j = 0; j < m_activeElements->size(); ++j)
+        for (size_t j = 0; j < m_activeElements.size(); ++j)
         {
-            wxChartTooltip tooltip((*m_activeElements)[j]->GetTooltipPosition(),
-                (*m_activeElements)[j]->GetTooltipProvider());
+            wxChartTooltip tooltip(m_activeElements[j]->GetTooltipPosition(),
+                m_activeElements[j]->GetTooltipProvider());
             multiTooltip.AddTooltip(tooltip);
         }
-        multiTooltip.Draw(gc);
+        multiTooltip.Draw(gc, GetGraphicsCache());
     }
 }
@@ -0,0 +1,112 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartangularindex.h"
+#include <algorithm>
+#include <cmath>
+
+wxChartAngularIndex::wxChartAngularIndex()
+    : m_isSorted(true)
+{
+}
+
+void wxChartAngularIndex::Clear(const wxPoint2DDouble &center)
+{
+    m_center = center;
+    m_arcs.clear();
+    m_startAngles.clear();
+    m_endAngles.clear();
+    m_isSorted = true;
+}
+
+void wxChartAngularIndex::Add(const wxChartArc *arc,
+                              wxDouble startAngle,
+                              wxDouble endAngle)
+{
+    // Written so that a NaN also disables the binary search
+    if (!(endAngle >= startAngle) ||
+        (!m_arcs.empty() &&
+            (!(startAngle >= m_startAngles.back()) || !(endAngle >= m_endAngles.back()))))
+    {
+        m_isSorted = false;
+    }
+    m_arcs.push_back(arc);
+    m_startAngles.push_back(startAngle);
+    m_endAngles.push_back(endAngle);
+}
+
+void wxChartAngularIndex::Query(const wxPoint &point,
+                                wxVector<const wxChartElement*> &elements) const
+{
+    wxDouble distanceFromXCenter = point.x - m_center.m_x;
+    wxDouble distanceFromYCenter = point.y - m_center.m_y;
+    wxDouble radialDistanceFromCenter = sqrt((distanceFromXCenter * distanceFromXCenter) + (distanceFromYCenter * distanceFromYCenter));
+
+    wxDouble angle = atan2(distanceFromYCenter, distanceFromXCenter);
+    if (angle < 0)
+    {
+        angle += 2 * M_PI;
+    }
+
+    if (!m_isSorted)
+    {
+        for (size_t i = 0; i < m_arcs.size(); ++i)
+        {
+            if (m_arcs[i]->HitTest(angle, radialDistanceFromCenter))
+            {
+                elements.push_back(m_arcs[i]);
+            }
+        }
+        return;
+    }
+
+    // The angles of the arcs aren't normalized so the
+    // angle is also looked up one turn before and after
+    m_candidates.clear();
+    AddCandidates(angle - (2 * M_PI), m_candidates);
+    AddCandidates(angle, m_candidates);
+    AddCandidates(angle + (2 * M_PI), m_candidates);
+    std::sort(m_candidates.begin(), m_candidates.end());
+
+    for (size_t i = 0; i < m_candidates.size(); ++i)
+    {
+        if ((i > 0) && (m_candidates[i] == m_candidates[i - 1]))
+        {
+            continue;
+        }
+        const wxChartArc *arc = m_arcs[m_candidates[i]];
+        if (arc->HitTest(angle, radialDistanceFromCenter))
+        {
+            elements.push_back(arc);
+        }
+    }
+}
+
+void wxChartAngularIndex::AddCandidates(wxDouble angle,
+                                        wxVector<size_t> &candidates) const
+{
+    size_t i = std::lower_bound(m_endAngles.begin(), m_endAngles.end(), angle) - m_endAngles.begin();
+    for (; (i < m_arcs.size()) && (m_startAngles[i] <= angle); ++i)
+    {
+        candidates.push_back(i);
+    }
+}
@@ -32,8 +32,6 @@
 */
 
 #include "wxchartarc.h"
-#include <wx/pen.h>
-#include <wx/brush.h>
 
 wxChartArc::wxChartArc(wxDouble x,
 					   wxDouble y, 
@@ -70,6 +68,12 @@ bool wxChartArc::HitTest(const wxPoint &point) const
 		angle += 2 * M_PI;
 	}
 
+	return HitTest(angle, radialDistanceFromCenter);
+}
+
+bool wxChartArc::HitTest(wxDouble angle,
+						 wxDouble radialDistanceFromCenter) const
+{
 	// Calculate wether the angle is between the start and the end angle
     bool betweenAngles = false;
     if (m_startAngle <= m_endAngle)
@@ -103,28 +107,14 @@ wxPoint2DDouble wxChartArc::GetTooltipPosition() const
 
 void wxChartArc::Draw(wxGraphicsContext &gc)
 {
-	wxGraphicsPath path = gc.CreatePath();
-
-	if (m_innerRadius > 0)
-	{
-		path.AddArc(m_x, m_y, m_innerRadius, m_startAngle, m_endAngle, true);
-		path.AddArc(m_x, m_y, m_outerRadius, m_endAngle, m_startAngle, false);
-	}
-	else
-	{
-		path.AddArc(m_x, m_y, m_outerRadius, m_endAngle, m_startAngle, false);
-		path.AddLineToPoint(m_x, m_y);
-	}
-
-	path.CloseSubpath();
-
-	wxBrush brush(m_options.GetFillColor());
-	gc.SetBrush(brush);
-	gc.FillPath(path);
+	wxChartBatchRenderer renderer(gc);
+	Draw(renderer);
+}
 
-	wxPen pen(*wxWHITE, m_options.GetOutlineWidth());
-	gc.SetPen(pen);
-	gc.StrokePath(path);
+void wxChartArc::Draw(wxChartBatchRenderer &renderer) const
+{
+	renderer.SetStyle(m_options.GetFillColor(), *wxWHITE, m_options.GetOutlineWidth());
+	renderer.AddArc(m_x, m_y, m_startAngle, m_endAngle, m_outerRadius, m_innerRadius);
 }
 
 void wxChartArc::SetCenter(wxDouble x, wxDouble y)
@@ -133,6 +123,11 @@ void wxChartArc::SetCenter(wxDouble x, wxDouble y)
 	m_y = y;
 }
 
+wxPoint2DDouble wxChartArc::GetCenter() const
+{
+	return wxPoint2DDouble(m_x, m_y);
+}
+
 void wxChartArc::SetAngles(wxDouble startAngle, wxDouble endAngle)
 {
 	m_startAngle = startAngle;
@@ -67,10 +67,10 @@ wxPoint2DDouble wxChartAxis::GetTooltipPosition() const
 	return wxPoint2DDouble(0, 0);
 }
 
-void wxChartAxis::Draw(wxGraphicsContext &gc)
+void wxChartAxis::Draw(wxGraphicsContext &gc,
+					   wxChartGraphicsCache &cache)
 {
-	wxPen pen(m_options.GetLineColor(), m_options.GetLineWidth());
-	gc.SetPen(pen);
+	gc.SetPen(cache.GetPen(gc, m_options.GetLineColor(), m_options.GetLineWidth()));
 
 	// Draw the axis
 	wxGraphicsPath path = gc.CreatePath();
@@ -87,7 +87,7 @@ void wxChartAxis::Draw(wxGraphicsContext &gc)
 	gc.StrokePath(path);
 
 	DrawTickMarks(gc);	// Draw the little lines corresponding to the labels
-	m_labels.Draw(gc);
+	m_labels.Draw(gc, cache);
 }
 
 void wxChartAxis::Fit(wxPoint2DDouble startPoint,
@@ -122,7 +122,31 @@ const wxChartLabelGroup& wxChartAxis::GetLabels() const
 
 void wxChartAxis::SetLabels(const wxVector<wxChartLabel> &labels)
 {
-    m_labels.assign(labels.begin(), labels.end());
+    wxVector<wxChartLabel> newLabels(labels);
+
+    // When the axis is panned or the data scrolls the texts
+    // are the same but shifted so the search for a match
+    // resumes after the previous one
+    size_t next = 0;
+    for (size_t i = 0; i < newLabels.size(); ++i)
+    {
+        if (newLabels[i].GetSize().GetHeight() != 0)
+        {
+            continue;
+        }
+
+        for (size_t j = next; j < m_labels.size(); ++j)
+        {
+            if (m_labels[j].GetText() == newLabels[i].GetText())
+            {
+                newLabels[i].SetSize(m_labels[j].GetSize());
+                next = j + 1;
+                break;
+            }
+        }
+    }
+
+    m_labels.assign(newLabels.begin(), newLabels.end());
 }
 
 wxPoint2DDouble wxChartAxis::CalculateLabelPosition(size_t index)
@@ -42,12 +42,30 @@ void wxChartBackground::Draw(wxDouble x,
                              wxDouble width, 
                              wxDouble height,
                              wxGraphicsContext &gc)
+{
+    wxChartGraphicsCache cache;
+    Draw(x, y, width, height, gc, cache);
+}
+
+void wxChartBackground::Draw(const wxPoint2DDouble &position,
+                             const wxSize &size,
+                             wxGraphicsContext &gc,
+                             wxChartGraphicsCache &cache)
+{
+    Draw(position.m_x, position.m_y, size.GetWidth(), size.GetHeight(), gc, cache);
+}
+
+void wxChartBackground::Draw(wxDouble x,
+                             wxDouble y,
+                             wxDouble width,
+                             wxDouble height,
+                             wxGraphicsContext &gc,
+                             wxChartGraphicsCache &cache)
 {
     wxGraphicsPath path = gc.CreatePath();
 
     path.AddRoundedRectangle(x, y, width, height, m_options.GetCornerRadius());
 
-    wxBrush brush(m_options.GetColor());
-    gc.SetBrush(brush);
+    gc.SetBrush(cache.GetBrush(gc, m_options.GetColor()));
     gc.FillPath(path);
 }
@@ -0,0 +1,147 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartbatchexporter.h"
+#include "wxchartthreadpool.h"
+#include <algorithm>
+
+// Creates, renders and saves one chart and gives its
+// memory back to the exporter
+class wxChartBatchExporter::ExportTask : public wxChartThreadPool::Task
+{
+public:
+    ExportTask(wxChartBatchExporter &exporter, Job &job, size_t memory)
+        : m_exporter(exporter), m_job(job), m_memory(memory)
+    {
+    }
+
+    virtual void Run() wxOVERRIDE
+    {
+        wxChart *chart = m_job.m_factory->CreateChart(m_job.m_size);
+        if (chart)
+        {
+            m_job.m_succeeded = chart->Save(m_job.m_filename,
+                m_job.m_type, m_job.m_size);
+            delete chart;
+        }
+        m_exporter.ReleaseMemory(m_memory);
+    }
+
+private:
+    wxChartBatchExporter &m_exporter;
+    Job &m_job;
+    size_t m_memory;
+};
+
+wxChartBatchExporter::ChartFactory::~ChartFactory()
+{
+}
+
+wxChartBatchExporter::Job::Job(ChartFactory::ptr factory,
+                               const wxSize &size,
+                               const wxString &filename,
+                               const wxBitmapType &type)
+    : m_factory(factory), m_size(size), m_filename(filename),
+      m_type(type), m_succeeded(false)
+{
+}
+
+wxChartBatchExporter::wxChartBatchExporter(unsigned int numberOfThreads,
+                                           size_t memoryBudget)
+    : m_numberOfThreads(numberOfThreads), m_memoryBudget(memoryBudget),
+      m_memoryReleased(m_mutex), m_memoryInUse(0)
+{
+}
+
+void wxChartBatchExporter::Add(ChartFactory::ptr factory,
+                               const wxSize &size,
+                               const wxString &filename,
+                               const wxBitmapType &type)
+{
+    m_jobs.push_back(Job(factory, size, filename, type));
+}
+
+size_t wxChartBatchExporter::GetCount() const
+{
+    return m_jobs.size();
+}
+
+void wxChartBatchExporter::Clear()
+{
+    m_jobs.clear();
+}
+
+size_t wxChartBatchExporter::Run()
+{
+    {
+        wxChartThreadPool pool(m_numberOfThreads);
+        for (size_t i = 0; i < m_jobs.size(); ++i)
+        {
+            Job &job = m_jobs[i];
+            job.m_succeeded = false;
+
+            size_t memory = std::min(GetMemoryRequirement(job.m_size), m_memoryBudget);
+            ReserveMemory(memory);
+            pool.Submit(new ExportTask(*this, job, memory));
+        }
+        pool.Wait();
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < m_jobs.size(); ++i)
+    {
+        if (m_jobs[i].m_succeeded)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+bool wxChartBatchExporter::Succeeded(size_t index) const
+{
+    return m_jobs[index].m_succeeded;
+}
+
+size_t wxChartBatchExporter::GetMemoryRequirement(const wxSize &size)
+{
+    // 3 bytes per pixel for the wxImage and 4 for the
+    // surface of the graphics context
+    return (7 * (size_t)size.GetWidth() * (size_t)size.GetHeight());
+}
+
+void wxChartBatchExporter::ReserveMemory(size_t bytes)
+{
+    wxMutexLocker locker(m_mutex);
+    while ((m_memoryInUse != 0) && ((m_memoryInUse + bytes) > m_memoryBudget))
+    {
+        m_memoryReleased.Wait();
+    }
+    m_memoryInUse += bytes;
+}
+
+void wxChartBatchExporter::ReleaseMemory(size_t bytes)
+{
+    wxMutexLocker locker(m_mutex);
+    m_memoryInUse -= bytes;
+    m_memoryReleased.Broadcast();
+}
@@ -0,0 +1,370 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartbatchrenderer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Shapes that span more cells than this are not added
+    // to the grid but checked one by one
+    const wxDouble maxCellsPerShape = 64;
+    // Flush the batch when it holds this many shapes that
+    // are checked one by one
+    const size_t maxLargeShapes = 64;
+
+    struct CellRange
+    {
+        long m_left;
+        long m_top;
+        long m_right;
+        long m_bottom;
+    };
+
+    bool GetCellRange(const wxRect2DDouble &bounds, wxDouble cellSize,
+                      CellRange &range)
+    {
+        wxDouble left = floor(bounds.m_x / cellSize);
+        wxDouble top = floor(bounds.m_y / cellSize);
+        wxDouble right = floor((bounds.m_x + bounds.m_width) / cellSize);
+        wxDouble bottom = floor((bounds.m_y + bounds.m_height) / cellSize);
+        // This also rejects the coordinates that are too
+        // large to be converted to a cell index
+        if (!(((right - left + 1) * (bottom - top + 1)) <= maxCellsPerShape) ||
+            !(std::fabs(left) < 1e9) || !(std::fabs(top) < 1e9))
+        {
+            return false;
+        }
+
+        range.m_left = static_cast<long>(left);
+        range.m_top = static_cast<long>(top);
+        range.m_right = static_cast<long>(right);
+        range.m_bottom = static_cast<long>(bottom);
+        return true;
+    }
+
+    // Different cells may share a key, the bounds of the
+    // shapes are always compared so this is harmless
+    long GetCellKey(long column, long row)
+    {
+        return static_cast<long>((static_cast<unsigned long>(column) * 73856093UL) ^
+            (static_cast<unsigned long>(row) * 19349663UL));
+    }
+
+    bool Overlap(const wxRect2DDouble &bounds1, const wxRect2DDouble &bounds2)
+    {
+        return ((bounds1.m_x < (bounds2.m_x + bounds2.m_width)) &&
+            (bounds2.m_x < (bounds1.m_x + bounds1.m_width)) &&
+            (bounds1.m_y < (bounds2.m_y + bounds2.m_height)) &&
+            (bounds2.m_y < (bounds1.m_y + bounds1.m_height)));
+    }
+}
+
+wxChartBatchRenderer::wxChartBatchRenderer(wxGraphicsContext &gc)
+    : m_gc(gc), m_cache(m_ownCache), m_fillPath(gc.CreatePath()), m_strokePath(gc.CreatePath()),
+    m_isEmpty(true), m_hasStyle(false), m_filled(false), m_strokeWidth(0),
+    m_cellSize(1)
+{
+}
+
+wxChartBatchRenderer::wxChartBatchRenderer(wxGraphicsContext &gc,
+                                           wxChartGraphicsCache &cache)
+    : m_gc(gc), m_cache(cache), m_fillPath(gc.CreatePath()), m_strokePath(gc.CreatePath()),
+    m_isEmpty(true), m_hasStyle(false), m_filled(false), m_strokeWidth(0),
+    m_cellSize(1)
+{
+}
+
+wxChartBatchRenderer::~wxChartBatchRenderer()
+{
+    Flush();
+}
+
+wxGraphicsContext& wxChartBatchRenderer::GetGraphicsContext()
+{
+    return m_gc;
+}
+
+void wxChartBatchRenderer::SetStyle(const wxColor &fillColor,
+                                    const wxColor &strokeColor,
+                                    unsigned int strokeWidth)
+{
+    ChangeStyle(true, fillColor, strokeColor, strokeWidth);
+}
+
+void wxChartBatchRenderer::SetStrokeStyle(const wxColor &strokeColor,
+                                          unsigned int strokeWidth)
+{
+    ChangeStyle(false, m_fillColor, strokeColor, strokeWidth);
+}
+
+void wxChartBatchRenderer::AddCircle(wxDouble x,
+                                     wxDouble y,
+                                     wxDouble radius)
+{
+    AddBounds(x - radius, y - radius, 2 * radius, 2 * radius);
+    if (m_filled)
+    {
+        m_fillPath.AddCircle(x, y, radius);
+    }
+    m_strokePath.AddCircle(x, y, radius);
+    m_isEmpty = false;
+}
+
+void wxChartBatchRenderer::AddRectangle(wxDouble x,
+                                        wxDouble y,
+                                        wxDouble width,
+                                        wxDouble height,
+                                        int directions)
+{
+    AddBounds(x, y, width, height);
+    if (m_filled)
+    {
+        m_fillPath.AddRectangle(x, y, width, height);
+    }
+
+    if (directions == wxALL)
+    {
+        m_strokePath.AddRectangle(x, y, width, height);
+    }
+    else
+    {
+        if (directions & wxTOP)
+        {
+            StrokeLine(wxPoint2DDouble(x, y), wxPoint2DDouble(x + width, y));
+        }
+        if (directions & wxRIGHT)
+        {
+            StrokeLine(wxPoint2DDouble(x + width, y), wxPoint2DDouble(x + width, y + height));
+        }
+        if (directions & wxBOTTOM)
+        {
+            StrokeLine(wxPoint2DDouble(x, y + height), wxPoint2DDouble(x + width, y + height));
+        }
+        if (directions & wxLEFT)
+        {
+            StrokeLine(wxPoint2DDouble(x, y), wxPoint2DDouble(x, y + height));
+        }
+    }
+    m_isEmpty = false;
+}
+
+void wxChartBatchRenderer::AddArc(wxDouble x,
+                                  wxDouble y,
+                                  wxDouble startAngle,
+                                  wxDouble endAngle,
+                                  wxDouble outerRadius,
+                                  wxDouble innerRadius)
+{
+    // Each arc starts a new subpath, otherwise the path
+    // would be joined to the end of the previous shape
+    wxGraphicsPath path = m_gc.CreatePath();
+    if (innerRadius > 0)
+    {
+        path.MoveToPoint(x + (innerRadius * cos(startAngle)), y + (innerRadius * sin(startAngle)));
+        path.AddArc(x, y, innerRadius, startAngle, endAngle, true);
+        path.AddArc(x, y, outerRadius, endAngle, startAngle, false);
+    }
+    else
+    {
+        path.MoveToPoint(x + (outerRadius * cos(endAngle)), y + (outerRadius * sin(endAngle)));
+        path.AddArc(x, y, outerRadius, endAngle, startAngle, false);
+        path.AddLineToPoint(x, y);
+    }
+    path.CloseSubpath();
+
+    // The bounds of the whole circle are good enough
+    AddBounds(x - outerRadius, y - outerRadius, 2 * outerRadius, 2 * outerRadius);
+    if (m_filled)
+    {
+        m_fillPath.AddPath(path);
+    }
+    m_strokePath.AddPath(path);
+    m_isEmpty = false;
+}
+
+void wxChartBatchRenderer::AddLine(const wxPoint2DDouble &start,
+                                   const wxPoint2DDouble &end)
+{
+    StrokeLine(start, end);
+    m_isEmpty = false;
+}
+
+void wxChartBatchRenderer::Flush()
+{
+    if (m_isEmpty)
+    {
+        return;
+    }
+
+    if (m_filled)
+    {
+        m_gc.SetBrush(m_cache.GetBrush(m_gc, m_fillColor));
+        // The shapes of a batch may overlap, with the
+        // default rule the overlapping parts would be
+        // left empty
+        m_gc.FillPath(m_fillPath, wxWINDING_RULE);
+    }
+
+    m_gc.SetPen(m_cache.GetPen(m_gc, m_strokeColor, m_strokeWidth));
+    m_gc.StrokePath(m_strokePath);
+
+    m_fillPath = m_gc.CreatePath();
+    m_strokePath = m_gc.CreatePath();
+    m_isEmpty = true;
+    m_bounds.clear();
+    m_cells.clear();
+    m_largeBounds.clear();
+}
+
+void wxChartBatchRenderer::AddBounds(wxDouble x,
+                                     wxDouble y,
+                                     wxDouble width,
+                                     wxDouble height)
+{
+    // The outlines of a batch are drawn after all its
+    // fills so an outline would end up on top of the fill
+    // of a shape that was added after it. Overlapping
+    // translucent fills would also only be blended once.
+    if (!m_filled)
+    {
+        return;
+    }
+
+    wxDouble margin = m_strokeWidth / 2.0;
+    wxRect2DDouble bounds(x - margin, y - margin,
+        width + (2 * margin), height + (2 * margin));
+    if (Intersects(bounds))
+    {
+        Flush();
+    }
+
+    if (m_bounds.empty())
+    {
+        // Most shapes of a batch have about the same size
+        m_cellSize = std::max(std::max(bounds.m_width, bounds.m_height), 1.0);
+    }
+
+    CellRange range;
+    bool inGrid = GetCellRange(bounds, m_cellSize, range);
+    if (!inGrid && (m_largeBounds.size() >= maxLargeShapes))
+    {
+        Flush();
+    }
+
+    size_t index = m_bounds.size();
+    m_bounds.push_back(bounds);
+    if (inGrid)
+    {
+        for (long row = range.m_top; row <= range.m_bottom; ++row)
+        {
+            for (long column = range.m_left; column <= range.m_right; ++column)
+            {
+                m_cells[GetCellKey(column, row)].push_back(index);
+            }
+        }
+    }
+    else
+    {
+        m_largeBounds.push_back(index);
+    }
+}
+
+bool wxChartBatchRenderer::Intersects(const wxRect2DDouble &bounds) const
+{
+    if (m_bounds.empty())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < m_largeBounds.size(); ++i)
+    {
+        if (Overlap(bounds, m_bounds[m_largeBounds[i]]))
+        {
+            return true;
+        }
+    }
+
+    CellRange range;
+    if (!GetCellRange(bounds, m_cellSize, range))
+    {
+        for (size_t i = 0; i < m_bounds.size(); ++i)
+        {
+            if (Overlap(bounds, m_bounds[i]))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    for (long row = range.m_top; row <= range.m_bottom; ++row)
+    {
+        for (long column = range.m_left; column <= range.m_right; ++column)
+        {
+            CellMap::const_iterator it = m_cells.find(GetCellKey(column, row));
+            if (it == m_cells.end())
+            {
+                continue;
+            }
+
+            const wxVector<size_t> &indices = it->second;
+            for (size_t i = 0; i < indices.size(); ++i)
+            {
+                if (Overlap(bounds, m_bounds[indices[i]]))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+void wxChartBatchRenderer::StrokeLine(const wxPoint2DDouble &start,
+                                      const wxPoint2DDouble &end)
+{
+    m_strokePath.MoveToPoint(start);
+    m_strokePath.AddLineToPoint(end);
+}
+
+void wxChartBatchRenderer::ChangeStyle(bool filled,
+                                       const wxColor &fillColor,
+                                       const wxColor &strokeColor,
+                                       unsigned int strokeWidth)
+{
+    if (m_hasStyle && (filled == m_filled) &&
+        (!filled || (fillColor == m_fillColor)) &&
+        (strokeColor == m_strokeColor) && (strokeWidth == m_strokeWidth))
+    {
+        return;
+    }
+
+    Flush();
+    m_hasStyle = true;
+    m_filled = filled;
+    m_fillColor = fillColor;
+    m_strokeColor = strokeColor;
+    m_strokeWidth = strokeWidth;
+}
@@ -21,8 +21,6 @@
 */
 
 #include "wxchartcircle.h"
-#include <wx/pen.h>
-#include <wx/brush.h>
 
 wxChartCircle::wxChartCircle(wxDouble x, 
                              wxDouble y, 
@@ -50,17 +48,15 @@ wxPoint2DDouble wxChartCircle::GetTooltipPosition() const
 
 void wxChartCircle::Draw(wxGraphicsContext &gc)
 {
-    wxGraphicsPath path = gc.CreatePath();
-    
-    path.AddCircle(m_x, m_y, m_radius);
-        
-    wxBrush brush(m_options.GetFillColor());
-    gc.SetBrush(brush);
-    gc.FillPath(path);
+    wxChartBatchRenderer renderer(gc);
+    Draw(renderer);
+}
 
-    wxPen pen(m_options.GetOutlineColor(), m_options.GetOutlineWidth());
-    gc.SetPen(pen);
-    gc.StrokePath(path);
+void wxChartCircle::Draw(wxChartBatchRenderer &renderer) const
+{
+    renderer.SetStyle(m_options.GetFillColor(), m_options.GetOutlineColor(),
+        m_options.GetOutlineWidth());
+    renderer.AddCircle(m_x, m_y, m_radius);
 }
 
 void wxChartCircle::SetCenter(wxDouble x, wxDouble y)
@@ -79,3 +75,13 @@ void wxChartCircle::SetRadius(wxDouble radius)
 {
     m_radius = radius;
 }
+
+wxPoint2DDouble wxChartCircle::GetCenter() const
+{
+    return wxPoint2DDouble(m_x, m_y);
+}
+
+wxDouble wxChartCircle::GetRadius() const
+{
+    return m_radius;
+}
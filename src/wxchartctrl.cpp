@@ -22,27 +22,91 @@
 
 #include "wxchartctrl.h"
 #include <wx/dcbuffer.h>
+#include <wx/dcmemory.h>
 
 wxChartCtrl::wxChartCtrl(wxWindow *parent,
 						 wxWindowID id,
 						 const wxPoint &pos,
 						 const wxSize &size,
 						 long style)
-	: wxControl(parent, id, pos, size, style)
+	: wxControl(parent, id, pos, size, style),
+    m_chartLayerIsValid(false), m_chartLayerRevision(0)
 {
 	SetBackgroundStyle(wxBG_STYLE_PAINT);
 	SetBackgroundColour(*wxWHITE);
+
+    Bind(wxEVT_CHART_LAYOUT_READY, &wxChartCtrl::OnLayoutReady, this);
+}
+
+bool wxChartCtrl::IsChartLayerValid(const wxSize &size)
+{
+    return (m_chartLayerIsValid &&
+        (m_chartLayerRevision == GetChart().GetRevision()) &&
+        (m_chartLayer.GetWidth() == size.GetWidth()) &&
+        (m_chartLayer.GetHeight() == size.GetHeight()));
+}
+
+void wxChartCtrl::UpdateChartLayer(const wxSize &size)
+{
+    m_chartLayerIsValid = false;
+    if (!m_chartLayer.IsOk() ||
+        (m_chartLayer.GetWidth() != size.GetWidth()) ||
+        (m_chartLayer.GetHeight() != size.GetHeight()))
+    {
+        m_chartLayer = wxBitmap(size.GetWidth(), size.GetHeight());
+    }
+
+    wxMemoryDC mdc(m_chartLayer);
+    mdc.SetBackground(wxBrush(GetBackgroundColour()));
+    mdc.Clear();
+
+    wxGraphicsContext* gc = wxGraphicsContext::Create(mdc);
+    if (gc)
+    {
+        GetChart().DrawChart(*gc, *this);
+        delete gc;
+        m_chartLayerIsValid = true;
+    }
+    mdc.SelectObject(wxNullBitmap);
+
+    // Drawing may have fitted the chart so read the
+    // revision afterwards
+    m_chartLayerRevision = GetChart().GetRevision();
 }
 
 void wxChartCtrl::OnPaint(wxPaintEvent &evt)
 {
     wxAutoBufferedPaintDC dc(this);
-    dc.Clear();
+
+    wxSize size = GetClientSize();
+    if ((size.GetWidth() <= 0) || (size.GetHeight() <= 0))
+    {
+        dc.Clear();
+        return;
+    }
+
+    if (!IsChartLayerValid(size))
+    {
+        UpdateChartLayer(size);
+    }
+
+    if (m_chartLayerIsValid)
+    {
+        dc.DrawBitmap(m_chartLayer, 0, 0);
+    }
+    else
+    {
+        dc.Clear();
+    }
 
     wxGraphicsContext* gc = wxGraphicsContext::Create(dc);
     if (gc)
     {
-        GetChart().Draw(*gc);
+        if (!m_chartLayerIsValid)
+        {
+            GetChart().DrawChart(*gc, *this);
+        }
+        GetChart().DrawTooltips(*gc);
         delete gc;
     }
 }
@@ -56,12 +120,22 @@ void wxChartCtrl::OnSize(wxSizeEvent &evt)
 	}
 }
 
+void wxChartCtrl::OnLayoutReady(wxThreadEvent &evt)
+{
+    if (GetChart().ApplyBackgroundFit())
+    {
+        Refresh();
+    }
+}
+
 void wxChartCtrl::OnMouseOver(wxMouseEvent &evt)
 {
 	if (GetChart().GetOptions().ShowTooltips())
 	{
-		GetChart().ActivateElementsAt(evt.GetPosition());
-		Refresh();
+		if (GetChart().ActivateElementsAt(evt.GetPosition()))
+		{
+			Refresh();
+		}
 	}
 }
 
@@ -0,0 +1,177 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartdownsampling.h"
+#include <cmath>
+
+size_t wxChartDownsampling::GetThreshold(wxDouble width)
+{
+    // Two points per pixel column are enough for the
+    // line to look the same once rasterized
+    if (width < 1)
+    {
+        width = 1;
+    }
+    return (2 * static_cast<size_t>(std::ceil(width)));
+}
+
+void wxChartDownsampling::LargestTriangleThreeBuckets(const wxVector<wxPoint2DDouble> &points,
+                                                      size_t threshold,
+                                                      wxVector<wxPoint2DDouble> &result)
+{
+    result.clear();
+
+    const size_t count = points.size();
+    if ((threshold >= count) || (threshold < 3))
+    {
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            result.push_back(points[i]);
+        }
+        return;
+    }
+
+    result.reserve(threshold);
+
+    // The first and last points are kept, the other
+    // points are split between threshold - 2 buckets
+    const wxDouble bucketSize = static_cast<wxDouble>(count - 2) / (threshold - 2);
+
+    size_t selected = 0;
+    result.push_back(points[0]);
+
+    for (size_t i = 0; i < (threshold - 2); ++i)
+    {
+        // The average of the next bucket, the last point
+        // is used as the next bucket of the last bucket
+        size_t nextStart = static_cast<size_t>((i + 1) * bucketSize) + 1;
+        size_t nextEnd = static_cast<size_t>((i + 2) * bucketSize) + 1;
+        if (nextEnd > count)
+        {
+            nextEnd = count;
+        }
+        if (nextStart >= nextEnd)
+        {
+            nextStart = count - 1;
+            nextEnd = count;
+        }
+
+        wxDouble averageX = 0;
+        wxDouble averageY = 0;
+        for (size_t j = nextStart; j < nextEnd; ++j)
+        {
+            averageX += points[j].m_x;
+            averageY += points[j].m_y;
+        }
+        averageX /= (nextEnd - nextStart);
+        averageY /= (nextEnd - nextStart);
+
+        size_t start = static_cast<size_t>(i * bucketSize) + 1;
+        size_t end = static_cast<size_t>((i + 1) * bucketSize) + 1;
+        if (end > (count - 1))
+        {
+            end = count - 1;
+        }
+
+        const wxPoint2DDouble &a = points[selected];
+        wxDouble maxArea = -1;
+        size_t maxIndex = start;
+        for (size_t j = start; j < end; ++j)
+        {
+            // Twice the area of the triangle, the factor
+            // doesn't matter for the comparison
+            wxDouble area = std::fabs(
+                (a.m_x - averageX) * (points[j].m_y - a.m_y) -
+                (a.m_x - points[j].m_x) * (averageY - a.m_y)
+                );
+            if (area > maxArea)
+            {
+                maxArea = area;
+                maxIndex = j;
+            }
+        }
+
+        result.push_back(points[maxIndex]);
+        selected = maxIndex;
+    }
+
+    result.push_back(points[count - 1]);
+}
+
+void wxChartDownsampling::M4(const wxVector<wxPoint2DDouble> &points,
+                             wxVector<wxPoint2DDouble> &result)
+{
+    result.clear();
+
+    size_t start = 0;
+    while (start < points.size())
+    {
+        const wxDouble column = std::floor(points[start].m_x);
+
+        size_t minIndex = start;
+        size_t maxIndex = start;
+        size_t end = start + 1;
+        for (; end < points.size(); ++end)
+        {
+            if (std::floor(points[end].m_x) != column)
+            {
+                break;
+            }
+            if (points[end].m_y < points[minIndex].m_y)
+            {
+                minIndex = end;
+            }
+            if (points[end].m_y > points[maxIndex].m_y)
+            {
+                maxIndex = end;
+            }
+        }
+        const size_t last = end - 1;
+
+        // The points are added in their original order
+        // and each of them only once
+        size_t middle1 = minIndex;
+        size_t middle2 = maxIndex;
+        if (middle1 > middle2)
+        {
+            middle1 = maxIndex;
+            middle2 = minIndex;
+        }
+
+        result.push_back(points[start]);
+        if ((middle1 != start) && (middle1 != last))
+        {
+            result.push_back(points[middle1]);
+        }
+        if ((middle2 != start) && (middle2 != last) && (middle2 != middle1))
+        {
+            result.push_back(points[middle2]);
+        }
+        if (last != start)
+        {
+            result.push_back(points[last]);
+        }
+
+        start = end;
+    }
+}
@@ -22,8 +22,15 @@
 
 #include "wxchartelement.h"
 
+// Elements without a tooltip all share the same provider
+static const wxChartTooltipProvider::ptr& GetEmptyTooltipProvider()
+{
+	static const wxChartTooltipProvider::ptr provider(new wxChartTooltipProviderStatic("", "", *wxBLACK));
+	return provider;
+}
+
 wxChartElement::wxChartElement()
-	: m_tooltipProvider(wxChartTooltipProviderStatic::ptr(new wxChartTooltipProviderStatic("", "", *wxBLACK)))
+	: m_tooltipProvider(GetEmptyTooltipProvider())
 {
 }
 
@@ -0,0 +1,69 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartelementcache.h"
+
+wxChartElementCache::wxChartElementCache()
+{
+}
+
+void wxChartElementCache::StartPass()
+{
+    m_previous.swap(m_current);
+    m_current.clear();
+}
+
+const wxChartElement* wxChartElementCache::Get(size_t dataset,
+                                               size_t index)
+{
+    for (size_t i = 0; i < m_current.size(); ++i)
+    {
+        if ((m_current[i].dataset == dataset) && (m_current[i].index == index))
+        {
+            return m_current[i].element.get();
+        }
+    }
+
+    for (size_t i = 0; i < m_previous.size(); ++i)
+    {
+        if ((m_previous[i].dataset == dataset) && (m_previous[i].index == index))
+        {
+            // Keep the element alive for one more pass
+            m_current.push_back(m_previous[i]);
+            return m_current.back().element.get();
+        }
+    }
+
+    return 0;
+}
+
+const wxChartElement* wxChartElementCache::Add(size_t dataset,
+                                               size_t index,
+                                               wxChartElement *element)
+{
+    Entry entry;
+    entry.dataset = dataset;
+    entry.index = index;
+    entry.element = wxSharedPtr<wxChartElement>(element);
+    m_current.push_back(entry);
+    return element;
+}
@@ -34,9 +34,24 @@ wxChartFontOptions::wxChartFontOptions(wxFontFamily family,
 {
 }
 
-wxFont wxChartFontOptions::GetFont() const
+const wxFont& wxChartFontOptions::GetFont() const
 {
-	return wxFont(wxSize(0, m_size), m_family, m_style, m_weight);
+	// The settings can't change so the font never
+	// needs to be created again
+	if (!m_font.IsOk())
+	{
+		m_font = wxFont(wxSize(0, m_size), m_family, m_style, m_weight);
+	}
+	return m_font;
+}
+
+const wxString& wxChartFontOptions::GetFontDescription() const
+{
+	if (m_fontDescription.empty())
+	{
+		m_fontDescription = GetFont().GetNativeFontInfoDesc();
+	}
+	return m_fontDescription;
 }
 
 wxFontFamily wxChartFontOptions::GetFamily() const
@@ -0,0 +1,148 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartgraphicscache.h"
+#include <wx/pen.h>
+#include <wx/brush.h>
+
+// A chart only uses a handful of styles, this limit
+// only protects against styles that keep changing
+static const size_t MaxEntries = 64;
+
+wxChartGraphicsCache::Pen::Pen(const wxColor &color,
+                               unsigned int width,
+                               const wxGraphicsPen &pen)
+    : m_color(color), m_width(width), m_pen(pen)
+{
+}
+
+wxChartGraphicsCache::Brush::Brush(const wxColor &color,
+                                   const wxGraphicsBrush &brush)
+    : m_color(color), m_brush(brush)
+{
+}
+
+wxChartGraphicsCache::Font::Font(const wxChartFontOptions &options,
+                                 const wxGraphicsFont &font)
+    : m_options(options), m_font(font)
+{
+}
+
+wxChartGraphicsCache::wxChartGraphicsCache()
+    : m_renderer(0), m_dpiX(0), m_dpiY(0)
+{
+}
+
+wxGraphicsPen wxChartGraphicsCache::GetPen(wxGraphicsContext &gc,
+                                           const wxColor &color,
+                                           unsigned int width)
+{
+    CheckRenderer(gc);
+
+    for (size_t i = 0; i < m_pens.size(); ++i)
+    {
+        if ((m_pens[i].m_width == width) && (m_pens[i].m_color == color))
+        {
+            return m_pens[i].m_pen;
+        }
+    }
+
+    if (m_pens.size() >= MaxEntries)
+    {
+        m_pens.clear();
+    }
+    wxGraphicsPen pen = gc.CreatePen(wxPen(color, width));
+    m_pens.push_back(Pen(color, width, pen));
+    return pen;
+}
+
+wxGraphicsBrush wxChartGraphicsCache::GetBrush(wxGraphicsContext &gc,
+                                               const wxColor &color)
+{
+    CheckRenderer(gc);
+
+    for (size_t i = 0; i < m_brushes.size(); ++i)
+    {
+        if (m_brushes[i].m_color == color)
+        {
+            return m_brushes[i].m_brush;
+        }
+    }
+
+    if (m_brushes.size() >= MaxEntries)
+    {
+        m_brushes.clear();
+    }
+    wxGraphicsBrush brush = gc.CreateBrush(wxBrush(color));
+    m_brushes.push_back(Brush(color, brush));
+    return brush;
+}
+
+wxGraphicsFont wxChartGraphicsCache::GetFont(wxGraphicsContext &gc,
+                                             const wxChartFontOptions &options)
+{
+    CheckRenderer(gc);
+
+    for (size_t i = 0; i < m_fonts.size(); ++i)
+    {
+        const wxChartFontOptions &fontOptions = m_fonts[i].m_options;
+        if ((fontOptions.GetSize() == options.GetSize()) &&
+            (fontOptions.GetFamily() == options.GetFamily()) &&
+            (fontOptions.GetStyle() == options.GetStyle()) &&
+            (fontOptions.GetWeight() == options.GetWeight()) &&
+            (fontOptions.GetColor() == options.GetColor()))
+        {
+            return m_fonts[i].m_font;
+        }
+    }
+
+    if (m_fonts.size() >= MaxEntries)
+    {
+        m_fonts.clear();
+    }
+    wxGraphicsFont font = gc.CreateFont(options.GetFont(), options.GetColor());
+    m_fonts.push_back(Font(options, font));
+    return font;
+}
+
+void wxChartGraphicsCache::Clear()
+{
+    m_pens.clear();
+    m_brushes.clear();
+    m_fonts.clear();
+}
+
+void wxChartGraphicsCache::CheckRenderer(wxGraphicsContext &gc)
+{
+    // Fonts are created for the resolution of the
+    // context, see wxChartTextExtentCache
+    wxDouble dpiX = 0;
+    wxDouble dpiY = 0;
+    gc.GetDPI(&dpiX, &dpiY);
+    if ((gc.GetRenderer() != m_renderer) || (dpiX != m_dpiX) || (dpiY != m_dpiY))
+    {
+        Clear();
+        m_renderer = gc.GetRenderer();
+        m_dpiX = dpiX;
+        m_dpiY = dpiY;
+    }
+}
@@ -49,7 +49,8 @@ wxChartGrid::wxChartGrid(const wxPoint2DDouble &position,
       m_XAxis(new wxChartAxis(labels, options.GetXAxisOptions())),
       m_YAxis(CreateNumericalAxis(minYValue, maxYValue, options.GetYAxisOptions())),
       m_mapping(size, m_XAxis, m_YAxis),
-      m_needsFit(true)
+      m_needsFit(true), m_gridLinesValid(false),
+      m_gridLinesRenderer(0), m_viewportChanged(false)
 {
 }
 
@@ -64,9 +65,11 @@ wxChartGrid::wxChartGrid(const wxPoint2DDouble &position,
       m_XAxis(CreateNumericalAxis(minXValue, maxXValue, options.GetXAxisOptions())),
       m_YAxis(CreateNumericalAxis(minYValue, maxYValue, options.GetYAxisOptions())),
       m_mapping(size, m_XAxis, m_YAxis),
-      m_needsFit(true),
+      m_needsFit(true), m_gridLinesValid(false),
+      m_gridLinesRenderer(0),
       m_origAxisLimits(minXValue,maxXValue,minYValue,maxYValue),
-      m_curAxisLimits(minXValue,maxXValue,minYValue,maxYValue)
+      m_curAxisLimits(minXValue,maxXValue,minYValue,maxYValue),
+      m_viewportChanged(false)
 {
 
 }
@@ -81,7 +84,8 @@ wxPoint2DDouble wxChartGrid::GetTooltipPosition() const
     return wxPoint2DDouble(0, 0);
 }
 
-void wxChartGrid::Draw(wxGraphicsContext &gc)
+void wxChartGrid::Draw(wxGraphicsContext &gc,
+                       wxChartGraphicsCache &cache)
 {
     Fit(gc);
 
@@ -105,18 +109,45 @@ void wxChartGrid::Draw(wxGraphicsContext &gc)
         horizontalAxis = m_YAxis.get();
     }
 
+    // The grid lines only move when the grid is refitted so the
+    // paths are kept until then. A path belongs to the renderer
+    // that created it so they are also rebuilt if it changes.
+    if (!m_gridLinesValid || (m_gridLinesRenderer != gc.GetRenderer()))
+    {
+        m_gridLinesValid = true;
+        m_gridLinesRenderer = gc.GetRenderer();
+        m_horizontalMajorLines = gc.CreatePath();
+        m_horizontalMinorLines = gc.CreatePath();
+        m_verticalMajorLines = gc.CreatePath();
+        m_verticalMinorLines = gc.CreatePath();
+
+        if (m_options.GetHorizontalGridLineOptions().ShowGridLines())
+        {
+            AddHorizontalGridLines(*horizontalAxis, *verticalAxis, m_options.GetHorizontalGridLineOptions(),
+                m_horizontalMajorLines, m_horizontalMinorLines);
+        }
+
+        if (m_options.GetVerticalGridLineOptions().ShowGridLines())
+        {
+            AddVerticalGridLines(*horizontalAxis, *verticalAxis, m_options.GetVerticalGridLineOptions(),
+                m_verticalMajorLines, m_verticalMinorLines);
+        }
+    }
+
     if (m_options.GetHorizontalGridLineOptions().ShowGridLines())
     {
-        DrawHorizontalGridLines(*horizontalAxis, *verticalAxis, m_options.GetHorizontalGridLineOptions(), gc);
+        StrokeGridLines(m_options.GetHorizontalGridLineOptions(), m_horizontalMajorLines,
+            m_horizontalMinorLines, gc, cache);
     }
 
     if (m_options.GetVerticalGridLineOptions().ShowGridLines())
     {
-        DrawVerticalGridLines(*horizontalAxis, *verticalAxis, m_options.GetVerticalGridLineOptions(), gc);
+        StrokeGridLines(m_options.GetVerticalGridLineOptions(), m_verticalMajorLines,
+            m_verticalMinorLines, gc, cache);
     }
 
-    m_XAxis->Draw(gc);
-    m_YAxis->Draw(gc);
+    m_XAxis->Draw(gc, cache);
+    m_YAxis->Draw(gc, cache);
 }
 
 void wxChartGrid::Resize(const wxSize &size)
@@ -130,6 +161,54 @@ const wxChartGridMapping& wxChartGrid::GetMapping() const
     return m_mapping;
 }
 
+void wxChartGrid::SetXLabels(const wxVector<wxString> &labels)
+{
+    wxChartLabelOptions labelOptions(m_options.GetXAxisOptions().GetFontOptions(),
+        false, wxChartBackgroundOptions(*wxWHITE, 0));
+
+    wxVector<wxChartLabel> xLabels;
+    xLabels.reserve(labels.size());
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        xLabels.push_back(wxChartLabel(labels[i], labelOptions));
+    }
+    m_XAxis->SetLabels(xLabels);
+    m_needsFit = true;
+}
+
+bool wxChartGrid::SetYRange(wxDouble minYValue,
+                            wxDouble maxYValue)
+{
+    m_curAxisLimits.MinY = minYValue;
+    m_curAxisLimits.MaxY = maxYValue;
+    m_origAxisLimits.MinY = minYValue;
+    m_origAxisLimits.MaxY = maxYValue;
+
+    if (!UpdateNumericalAxis(*m_YAxis, minYValue, maxYValue, m_options.GetYAxisOptions()))
+    {
+        return false;
+    }
+
+    m_needsFit = true;
+    return true;
+}
+
+bool wxChartGrid::SetRange(wxDouble minXValue,
+                           wxDouble maxXValue,
+                           wxDouble minYValue,
+                           wxDouble maxYValue)
+{
+    m_origAxisLimits = AxisLimits(minXValue, maxXValue, minYValue, maxYValue);
+    // The viewport only follows the values until the
+    // user zooms or pans
+    if (m_viewportChanged)
+    {
+        return false;
+    }
+    m_curAxisLimits = m_origAxisLimits;
+    return Update();
+}
+
 bool wxChartGrid::Scale(int c)
 {
     if(c)
@@ -149,9 +228,13 @@ bool wxChartGrid::Scale(int c)
         m_curAxisLimits.MaxX-=deltaX;
         m_curAxisLimits.MinY+=deltaY;
         m_curAxisLimits.MaxY-=deltaY;
+        m_viewportChanged = true;
     }
     else
+    {
         m_curAxisLimits = m_origAxisLimits;
+        m_viewportChanged = false;
+    }
     Update();
     return true;
 }
@@ -165,18 +248,24 @@ void wxChartGrid::Shift(double dx,double dy)
     double deltaY = (m_curAxisLimits.MaxY-m_curAxisLimits.MinY)*dy;
     m_curAxisLimits.MinY+=deltaY;
     m_curAxisLimits.MaxY+=deltaY;
+    m_viewportChanged = true;
 
     Update();
 }
 
-void wxChartGrid::Update()
+bool wxChartGrid::Update()
 {
-    m_XAxis = CreateNumericalAxis(m_curAxisLimits.MinX,
-                                  m_curAxisLimits.MaxX,m_options.GetXAxisOptions());
-    m_YAxis = CreateNumericalAxis(m_curAxisLimits.MinY,
-                                  m_curAxisLimits.MaxY, m_options.GetYAxisOptions());
-    m_mapping = wxChartGridMapping(m_mapping.GetSize(), m_XAxis, m_YAxis);
+    bool xAxisChanged = UpdateNumericalAxis(*m_XAxis, m_curAxisLimits.MinX,
+        m_curAxisLimits.MaxX, m_options.GetXAxisOptions());
+    bool yAxisChanged = UpdateNumericalAxis(*m_YAxis, m_curAxisLimits.MinY,
+        m_curAxisLimits.MaxY, m_options.GetYAxisOptions());
+    if (!xAxisChanged && !yAxisChanged)
+    {
+        return false;
+    }
+
     m_needsFit = true;
+    return true;
 }
 
 wxChartAxis::ptr wxChartGrid::CreateNumericalAxis(wxDouble minValue,
@@ -186,24 +275,12 @@ wxChartAxis::ptr wxChartGrid::CreateNumericalAxis(wxDouble minValue,
     wxChartNumericalAxis* numericalAxis = new wxChartNumericalAxis(options);
     wxSharedPtr<wxChartAxis> axis(numericalAxis);
 
-    wxDouble effectiveMinXValue = minValue;
-    if (options.GetStartValueMode() == wxCHARTAXISVALUEMODE_EXPLICIT)
-    {
-        effectiveMinXValue = options.GetStartValue();
-    }
-    wxDouble effectiveMaxXValue = maxValue;
-    if (options.GetEndValueMode() == wxCHARTAXISVALUEMODE_EXPLICIT)
-    {
-        effectiveMaxXValue = options.GetEndValue();
-    }
-
     wxDouble graphMinXValue;
     wxDouble graphMaxXValue;
-    wxDouble xValueRange = 0;
     size_t steps = 0;
     wxDouble stepValue = 0;
-    wxChartUtilities::CalculateGridRange(effectiveMinXValue, effectiveMaxXValue,
-                                         graphMinXValue, graphMaxXValue, xValueRange, steps, stepValue);
+    CalculateAxisRange(minValue, maxValue, options,
+        graphMinXValue, graphMaxXValue, steps, stepValue);
 
     numericalAxis->SetMinValue(graphMinXValue);
     numericalAxis->SetMaxValue(graphMaxXValue);
@@ -220,6 +297,68 @@ wxChartAxis::ptr wxChartGrid::CreateNumericalAxis(wxDouble minValue,
     return axis;
 }
 
+void wxChartGrid::CalculateAxisRange(wxDouble minValue,
+                                     wxDouble maxValue,
+                                     const wxChartAxisOptions &options,
+                                     wxDouble &graphMinValue,
+                                     wxDouble &graphMaxValue,
+                                     size_t &steps,
+                                     wxDouble &stepValue)
+{
+    wxDouble effectiveMinValue = minValue;
+    if (options.GetStartValueMode() == wxCHARTAXISVALUEMODE_EXPLICIT)
+    {
+        effectiveMinValue = options.GetStartValue();
+    }
+    wxDouble effectiveMaxValue = maxValue;
+    if (options.GetEndValueMode() == wxCHARTAXISVALUEMODE_EXPLICIT)
+    {
+        effectiveMaxValue = options.GetEndValue();
+    }
+
+    wxDouble valueRange = 0;
+    wxChartUtilities::CalculateGridRange(effectiveMinValue, effectiveMaxValue,
+        graphMinValue, graphMaxValue, valueRange, steps, stepValue);
+}
+
+bool wxChartGrid::UpdateNumericalAxis(wxChartAxis &axis,
+                                      wxDouble minValue,
+                                      wxDouble maxValue,
+                                      const wxChartAxisOptions &options)
+{
+    wxDouble graphMinValue;
+    wxDouble graphMaxValue;
+    size_t steps = 0;
+    wxDouble stepValue = 0;
+    CalculateAxisRange(minValue, maxValue, options,
+        graphMinValue, graphMaxValue, steps, stepValue);
+
+    wxChartNumericalAxis &numericalAxis = static_cast<wxChartNumericalAxis&>(axis);
+    if ((graphMinValue == numericalAxis.GetMinValue()) &&
+        (graphMaxValue == numericalAxis.GetMaxValue()) &&
+        ((steps + 1) == numericalAxis.GetLabels().size()))
+    {
+        return false;
+    }
+
+    // The axis is updated in place so the mapping that
+    // refers to it stays valid. The labels that keep
+    // their text also keep their measured size.
+    numericalAxis.SetMinValue(graphMinValue);
+    numericalAxis.SetMaxValue(graphMaxValue);
+
+    wxVector<wxChartLabel> labels;
+    wxChartUtilities::BuildNumericalLabels(
+        graphMinValue,
+        steps,
+        stepValue,
+        wxChartLabelOptions(options.GetFontOptions(), false, wxChartBackgroundOptions(*wxWHITE, 0)),
+        labels);
+    numericalAxis.SetLabels(labels);
+
+    return true;
+}
+
 void wxChartGrid::Fit(wxGraphicsContext &gc)
 {
     if (!m_needsFit)
@@ -255,6 +394,8 @@ void wxChartGrid::Fit(wxGraphicsContext &gc)
     m_XAxis->UpdateLabelPositions();
     m_YAxis->UpdateLabelPositions();
 
+    m_gridLinesValid = false;
+
     m_needsFit = false;
 }
 
@@ -297,10 +438,11 @@ void wxChartGrid::CalculatePadding(const wxChartAxis &xAxis,
     }
 }
 
-void wxChartGrid::DrawHorizontalGridLines(const wxChartAxis &horizontalAxis,
-        const wxChartAxis &verticalAxis,
-        const wxChartGridLineOptions &options,
-        wxGraphicsContext &gc)
+void wxChartGrid::AddHorizontalGridLines(const wxChartAxis &horizontalAxis,
+                                         const wxChartAxis &verticalAxis,
+                                         const wxChartGridLineOptions &options,
+                                         wxGraphicsPath &majorLines,
+                                         wxGraphicsPath &minorLines)
 {
     for (size_t i = 1; i < verticalAxis.GetNumberOfTickMarks(); ++i)
     {
@@ -311,13 +453,8 @@ void wxChartGrid::DrawHorizontalGridLines(const wxChartAxis &horizontalAxis,
             lineEndPosition.m_x += horizontalAxis.GetDistanceBetweenTickMarks();
         }
 
-        wxGraphicsPath path = gc.CreatePath();
-        path.MoveToPoint(lineStartPosition);
-        path.AddLineToPoint(lineEndPosition.m_x + horizontalAxis.GetOptions().GetOverhang(), lineStartPosition.m_y);
-
-        wxPen pen1(options.GetMajorGridLineColor(), options.GetMajorGridLineWidth());
-        gc.SetPen(pen1);
-        gc.StrokePath(path);
+        majorLines.MoveToPoint(lineStartPosition);
+        majorLines.AddLineToPoint(lineEndPosition.m_x + horizontalAxis.GetOptions().GetOverhang(), lineStartPosition.m_y);
 
         unsigned int n = options.GetNumberOfMinorGridLinesBetweenTickMarks();
         if (n != 0)
@@ -326,13 +463,8 @@ void wxChartGrid::DrawHorizontalGridLines(const wxChartAxis &horizontalAxis,
             wxDouble currentSpacing = spacing;
             for (size_t j = 0; j < n; ++j)
             {
-                wxGraphicsPath path = gc.CreatePath();
-                path.MoveToPoint(lineStartPosition.m_x, lineStartPosition.m_y + currentSpacing);
-                path.AddLineToPoint(lineEndPosition.m_x + horizontalAxis.GetOptions().GetOverhang(), lineStartPosition.m_y + currentSpacing);
-
-                wxPen pen1(wxColor(0, 0, 0, 0x0C), 1);
-                gc.SetPen(pen1);
-                gc.StrokePath(path);
+                minorLines.MoveToPoint(lineStartPosition.m_x, lineStartPosition.m_y + currentSpacing);
+                minorLines.AddLineToPoint(lineEndPosition.m_x + horizontalAxis.GetOptions().GetOverhang(), lineStartPosition.m_y + currentSpacing);
 
                 currentSpacing += spacing;
             }
@@ -340,10 +472,11 @@ void wxChartGrid::DrawHorizontalGridLines(const wxChartAxis &horizontalAxis,
     }
 }
 
-void wxChartGrid::DrawVerticalGridLines(const wxChartAxis &horizontalAxis,
-                                        const wxChartAxis &verticalAxis,
-                                        const wxChartGridLineOptions &options,
-                                        wxGraphicsContext &gc)
+void wxChartGrid::AddVerticalGridLines(const wxChartAxis &horizontalAxis,
+                                       const wxChartAxis &verticalAxis,
+                                       const wxChartGridLineOptions &options,
+                                       wxGraphicsPath &majorLines,
+                                       wxGraphicsPath &minorLines)
 {
     size_t i = 1;
     if (horizontalAxis.GetOptions().GetStartMarginType() == wxCHARTAXISMARGINTYPE_TICKMARKOFFSET)
@@ -360,13 +493,8 @@ void wxChartGrid::DrawVerticalGridLines(const wxChartAxis &horizontalAxis,
         wxPoint2DDouble lineStartPosition = horizontalAxis.GetTickMarkPosition(i);
         wxPoint2DDouble lineEndPosition = verticalAxis.GetTickMarkPosition(verticalAxis.GetNumberOfTickMarks() - 1);
 
-        wxGraphicsPath path = gc.CreatePath();
-        path.MoveToPoint(lineStartPosition);
-        path.AddLineToPoint(lineStartPosition.m_x, lineEndPosition.m_y - verticalAxis.GetOptions().GetOverhang());
-
-        wxPen pen1(options.GetMajorGridLineColor(), options.GetMajorGridLineWidth());
-        gc.SetPen(pen1);
-        gc.StrokePath(path);
+        majorLines.MoveToPoint(lineStartPosition);
+        majorLines.AddLineToPoint(lineStartPosition.m_x, lineEndPosition.m_y - verticalAxis.GetOptions().GetOverhang());
 
         unsigned int n = options.GetNumberOfMinorGridLinesBetweenTickMarks();
         if (n != 0)
@@ -375,16 +503,27 @@ void wxChartGrid::DrawVerticalGridLines(const wxChartAxis &horizontalAxis,
             wxDouble currentSpacing = spacing;
             for (size_t j = 0; j < n; ++j)
             {
-                wxGraphicsPath path = gc.CreatePath();
-                path.MoveToPoint(lineStartPosition.m_x - currentSpacing, lineStartPosition.m_y);
-                path.AddLineToPoint(lineStartPosition.m_x - currentSpacing, lineEndPosition.m_y - verticalAxis.GetOptions().GetOverhang());
-
-                wxPen pen1(wxColor(0, 0, 0, 0x0C), 1);
-                gc.SetPen(pen1);
-                gc.StrokePath(path);
+                minorLines.MoveToPoint(lineStartPosition.m_x - currentSpacing, lineStartPosition.m_y);
+                minorLines.AddLineToPoint(lineStartPosition.m_x - currentSpacing, lineEndPosition.m_y - verticalAxis.GetOptions().GetOverhang());
 
                 currentSpacing += spacing;
             }
         }
     }
 }
+
+void wxChartGrid::StrokeGridLines(const wxChartGridLineOptions &options,
+                                  const wxGraphicsPath &majorLines,
+                                  const wxGraphicsPath &minorLines,
+                                  wxGraphicsContext &gc,
+                                  wxChartGraphicsCache &cache)
+{
+    gc.SetPen(cache.GetPen(gc, options.GetMajorGridLineColor(), options.GetMajorGridLineWidth()));
+    gc.StrokePath(majorLines);
+
+    if (options.GetNumberOfMinorGridLinesBetweenTickMarks() != 0)
+    {
+        gc.SetPen(cache.GetPen(gc, wxColor(0, 0, 0, 0x0C), 1));
+        gc.StrokePath(minorLines);
+    }
+}
@@ -33,6 +33,8 @@
 
 #include "wxchartgridmapping.h"
 #include "wxchartnumericalaxis.h"
+#include <algorithm>
+#include <cmath>
 
 wxChartGridMapping::wxChartGridMapping(const wxSize &size,
 									   const wxChartAxis::ptr xAxis,
@@ -41,6 +43,11 @@ wxChartGridMapping::wxChartGridMapping(const wxSize &size,
 {
 }
 
+wxChartGridMapping wxChartGridMapping::Clone() const
+{
+	return wxChartGridMapping(m_size, CloneAxis(*m_XAxis), CloneAxis(*m_YAxis));
+}
+
 const wxSize& wxChartGridMapping::GetSize() const
 {
 	return m_size;
@@ -104,6 +111,27 @@ wxPoint2DDouble wxChartGridMapping::GetWindowPositionAtTickMark(size_t index,
 	return wxPoint2DDouble(0, 0);
 }
 
+wxRect2DDouble wxChartGridMapping::GetPlotArea() const
+{
+	const wxChartNumericalAxis& numericalXAxis = static_cast<const wxChartNumericalAxis&>(*m_XAxis);
+	const wxChartNumericalAxis& numericalYAxis = static_cast<const wxChartNumericalAxis&>(*m_YAxis);
+
+	wxPoint2DDouble start = GetWindowPosition(numericalXAxis.GetMinValue(), numericalYAxis.GetMinValue());
+	wxPoint2DDouble end = GetWindowPosition(numericalXAxis.GetMaxValue(), numericalYAxis.GetMaxValue());
+	return wxRect2DDouble(std::min(start.m_x, end.m_x), std::min(start.m_y, end.m_y),
+		std::abs(end.m_x - start.m_x), std::abs(end.m_y - start.m_y));
+}
+
+wxChartAxis::ptr wxChartGridMapping::CloneAxis(const wxChartAxis &axis)
+{
+	if (axis.GetType() == wxCHARTAXISTYPE_NUMERICAL)
+	{
+		return wxChartAxis::ptr(new wxChartNumericalAxis(
+			static_cast<const wxChartNumericalAxis&>(axis)));
+	}
+	return wxChartAxis::ptr(new wxChartAxis(axis));
+}
+
 const wxChartAxis& wxChartGridMapping::GetXAxis() const
 {
 	return *m_XAxis;
@@ -51,6 +51,13 @@ wxPoint2DDouble wxChartLabel::GetTooltipPosition() const
 }
 
 void wxChartLabel::Draw(wxGraphicsContext &gc) const
+{
+    wxChartGraphicsCache cache;
+    Draw(gc, cache);
+}
+
+void wxChartLabel::Draw(wxGraphicsContext &gc,
+                        wxChartGraphicsCache &cache) const
 {
     if (m_options.HasBackground())
     {
@@ -59,11 +66,10 @@ void wxChartLabel::Draw(wxGraphicsContext &gc) const
         backgroundSize.y += (m_padding.GetTop() + m_padding.GetBottom());
 
         wxChartBackground background(m_options.GetBackgroundOptions());
-        background.Draw(m_position, backgroundSize, gc);
+        background.Draw(m_position, backgroundSize, gc, cache);
     }
 
-    wxFont font = m_options.GetFontOptions().GetFont();
-    gc.SetFont(font, m_options.GetFontOptions().GetColor());
+    gc.SetFont(cache.GetFont(gc, m_options.GetFontOptions()));
 	gc.DrawText(m_text, m_position.m_x, m_position.m_y);
 }
 
@@ -107,10 +113,10 @@ void wxChartLabel::SetSize(wxDouble width, wxDouble height)
 
 void wxChartLabel::UpdateSize(wxGraphicsContext &gc)
 {
-    wxFont font = m_options.GetFontOptions().GetFont();
     wxDouble width = 0;
     wxDouble height = 0;
-    wxChartUtilities::GetTextSize(gc, font, m_text, width, height);
+    wxChartUtilities::GetTextSize(gc, m_options.GetFontOptions(), m_text,
+        width, height);
     m_size.x = width;
     m_size.y = height;
 }
@@ -23,15 +23,16 @@
 #include "wxchartlabelgroup.h"
 
 wxChartLabelGroup::wxChartLabelGroup()
-    : m_maxWidth(0)
+    : m_maxWidth(0), m_renderer(0), m_dpiX(0), m_dpiY(0)
 {
 }
 
-void wxChartLabelGroup::Draw(wxGraphicsContext &gc)
+void wxChartLabelGroup::Draw(wxGraphicsContext &gc,
+                             wxChartGraphicsCache &cache)
 {
     for (size_t i = 0; i < size(); ++i)
     {
-        (*this)[i].Draw(gc);
+        (*this)[i].Draw(gc, cache);
     }
 }
 
@@ -39,9 +40,23 @@ void wxChartLabelGroup::UpdateSizes(wxGraphicsContext &gc)
 {
     m_maxWidth = 0;
 
+    // The same text doesn't have the same size with
+    // another renderer or at another resolution
+    wxDouble dpiX = 0;
+    wxDouble dpiY = 0;
+    gc.GetDPI(&dpiX, &dpiY);
+    const bool remeasure = ((gc.GetRenderer() != m_renderer) ||
+        (dpiX != m_dpiX) || (dpiY != m_dpiY));
+    m_renderer = gc.GetRenderer();
+    m_dpiX = dpiX;
+    m_dpiY = dpiY;
+
     for (size_t i = 0; i < size(); ++i)
     {
-        (*this)[i].UpdateSize(gc);
+        if (remeasure || ((*this)[i].GetSize().GetHeight() == 0))
+        {
+            (*this)[i].UpdateSize(gc);
+        }
 
         const wxSize size = (*this)[i].GetSize();
         if (size.GetWidth() > m_maxWidth)
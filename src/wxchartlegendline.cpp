@@ -46,21 +46,25 @@ wxPoint2DDouble wxChartLegendLine::GetTooltipPosition() const
 
 void wxChartLegendLine::Draw(wxGraphicsContext &gc)
 {
-	wxFont font = m_options.GetFontOptions().GetFont();
-	gc.SetFont(font, m_options.GetFontOptions().GetColor());
+	wxChartGraphicsCache cache;
+	Draw(gc, cache);
+}
+
+void wxChartLegendLine::Draw(wxGraphicsContext &gc,
+							 wxChartGraphicsCache &cache)
+{
+	gc.SetFont(cache.GetFont(gc, m_options.GetFontOptions()));
 
 	wxDouble fontSize = m_options.GetFontOptions().GetSize();
 
 	wxGraphicsPath backgroundPath = gc.CreatePath();
 	backgroundPath.AddRoundedRectangle(m_position.m_x, m_position.m_y, fontSize + 2, fontSize + 2, 3);
-	wxBrush backgroundBrush(*wxWHITE);
-	gc.SetBrush(backgroundBrush);
+	gc.SetBrush(cache.GetBrush(gc, *wxWHITE));
 	gc.FillPath(backgroundPath);
 
 	wxGraphicsPath path = gc.CreatePath();
 	path.AddRoundedRectangle(m_position.m_x, m_position.m_y, fontSize + 2, fontSize + 2, 3);
-	wxBrush brush(m_color);
-	gc.SetBrush(brush);
+	gc.SetBrush(cache.GetBrush(gc, m_color));
 	gc.FillPath(path);
 
 	gc.DrawText(m_text, m_position.m_x + 20, m_position.m_y);
@@ -86,7 +90,7 @@ void wxChartLegendLine::UpdateSize(wxGraphicsContext &gc)
 {
 	wxDouble width;
 	wxDouble height;
-	wxChartUtilities::GetTextSize(gc, m_options.GetFontOptions().GetFont(), m_text, width, height);
+	wxChartUtilities::GetTextSize(gc, m_options.GetFontOptions(), m_text, width, height);
 	m_size.x = width + 20;
 	m_size.y = height;
 }
@@ -0,0 +1,141 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartmarkersprite.h"
+#include "wxchartbatchrenderer.h"
+#include <cmath>
+#include <cstring>
+
+wxChartMarkerSprite::wxChartMarkerSprite(wxDouble radius,
+                                         const wxChartPointOptions &options)
+    : m_radius(radius), m_options(options), m_halfSize(0)
+{
+}
+
+void wxChartMarkerSprite::Draw(wxGraphicsContext &gc,
+                               const wxVector<wxPoint2DDouble> &positions)
+{
+    if (m_halfSize == 0)
+    {
+        Rasterize();
+    }
+
+    // The image is converted to the format of the
+    // renderer once for all the positions
+    wxGraphicsBitmap bitmap = gc.CreateBitmapFromImage(m_image);
+    const wxDouble size = 2 * m_halfSize;
+
+    // Duplicates are only tracked in the area that can
+    // be drawn on, expressed in the coordinates of the
+    // positions. A context may draw a translated part of
+    // the chart, like the tiles of wxChartTiledExporter.
+    wxDouble left = 0;
+    wxDouble top = 0;
+    wxDouble width = 0;
+    wxDouble height = 0;
+#if wxCHECK_VERSION(3, 1, 1)
+    gc.GetClipBox(&left, &top, &width, &height);
+#endif
+    if ((width <= 0) || (height <= 0))
+    {
+        // The size of the context is in device coordinates
+        // so it can only be used without a transform
+        left = 0;
+        top = 0;
+        width = 0;
+        height = 0;
+        if (gc.GetTransform().IsIdentity())
+        {
+            gc.GetSize(&width, &height);
+        }
+    }
+    // Markers whose center is within m_halfSize of the
+    // edges are partly visible
+    const long originX = static_cast<long>(floor(left)) - m_halfSize;
+    const long originY = static_cast<long>(floor(top)) - m_halfSize;
+    const long columns = static_cast<long>(ceil(width)) + 1 + (2 * m_halfSize);
+    const long rows = static_cast<long>(ceil(height)) + 1 + (2 * m_halfSize);
+    const bool cull = ((width > 0) && (height > 0));
+    // Stamping a translucent marker twice makes it darker,
+    // like drawing the shape twice does
+    const bool skipDuplicates = (cull &&
+        (m_options.GetFillColor().Alpha() == wxALPHA_OPAQUE) &&
+        (m_options.GetStrokeColor().Alpha() == wxALPHA_OPAQUE));
+    if (skipDuplicates)
+    {
+        m_stamped.assign(columns * rows, 0);
+    }
+
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        const long x = static_cast<long>(floor(positions[i].m_x + 0.5));
+        const long y = static_cast<long>(floor(positions[i].m_y + 0.5));
+
+        if (cull)
+        {
+            const long column = x - originX;
+            const long row = y - originY;
+            if ((column < 0) || (column >= columns) || (row < 0) || (row >= rows))
+            {
+                continue;
+            }
+            if (skipDuplicates)
+            {
+                unsigned char &stamped = m_stamped[(row * columns) + column];
+                if (stamped)
+                {
+                    continue;
+                }
+                stamped = 1;
+            }
+        }
+
+        gc.DrawBitmap(bitmap, x - m_halfSize, y - m_halfSize, size, size);
+    }
+}
+
+void wxChartMarkerSprite::Rasterize()
+{
+    // Leave a margin of one pixel for the antialiasing
+    m_halfSize = static_cast<int>(ceil(m_radius + (m_options.GetStrokeWidth() / 2.0))) + 1;
+    const int size = 2 * m_halfSize;
+
+    m_image = wxImage(size, size);
+    m_image.InitAlpha();
+    memset(m_image.GetAlpha(), 0, size * size);
+
+    wxGraphicsContext *gc = wxGraphicsContext::Create(m_image);
+    if (gc)
+    {
+        // The marker is drawn exactly like wxChartPointSeries
+        // draws it so the two modes look the same
+        {
+            wxChartBatchRenderer renderer(*gc);
+            renderer.SetStyle(m_options.GetFillColor(), m_options.GetStrokeColor(),
+                m_options.GetStrokeWidth());
+            renderer.AddCircle(m_halfSize, m_halfSize, m_radius);
+        }
+        // The drawing is only copied to the image when
+        // the context is destroyed
+        delete gc;
+    }
+}
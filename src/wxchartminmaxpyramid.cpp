@@ -0,0 +1,241 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartminmaxpyramid.h"
+#include <algorithm>
+
+// Smaller buckets aren't stored, the points are read
+// directly instead. This keeps the size of the pyramid
+// to a quarter of the number of points.
+static const size_t FirstLevel = 3;
+
+wxChartMinMaxPyramid::Bucket::Bucket()
+    : m_minIndex(0), m_maxIndex(0)
+{
+}
+
+wxChartMinMaxPyramid::Bucket::Bucket(size_t minIndex,
+                                     size_t maxIndex)
+    : m_minIndex(minIndex), m_maxIndex(maxIndex)
+{
+}
+
+wxChartMinMaxPyramid::Level::Level()
+    : m_first(0)
+{
+}
+
+wxChartMinMaxPyramid::wxChartMinMaxPyramid()
+    : m_begin(0), m_end(0)
+{
+}
+
+void wxChartMinMaxPyramid::Update(const wxChartRingBuffer<wxPoint2DDouble> &points,
+                                  size_t firstPosition)
+{
+    const size_t count = points.GetCount();
+    if ((count == 0) || (firstPosition < m_begin))
+    {
+        Clear();
+        if (count == 0)
+        {
+            return;
+        }
+    }
+
+    // The points that were already there at the last
+    // update haven't changed
+    const size_t changed = std::max(m_end, firstPosition);
+    const bool headChanged = (firstPosition != m_begin);
+    m_begin = firstPosition;
+    m_end = firstPosition + count;
+
+    size_t level = 0;
+    size_t firstBucket = 0;
+    size_t lastBucket = 0;
+    do
+    {
+        const size_t shift = level + FirstLevel;
+        firstBucket = (m_begin >> shift);
+        lastBucket = ((m_end - 1) >> shift);
+
+        if (level == m_levels.size())
+        {
+            m_levels.push_back(Level());
+        }
+        Level &current = m_levels[level];
+
+        // The bucket that contains the first changed point
+        // and all the ones after it need to be recomputed
+        size_t start = std::max(changed >> shift, firstBucket);
+        const size_t discarded = firstBucket - current.m_first;
+        if (current.m_buckets.empty() || (discarded >= current.m_buckets.size()))
+        {
+            current.m_buckets.clear();
+            current.m_first = firstBucket;
+            start = firstBucket;
+        }
+        else if ((2 * discarded) >= current.m_buckets.size())
+        {
+            current.m_buckets.erase(current.m_buckets.begin(),
+                current.m_buckets.begin() + discarded);
+            current.m_first = firstBucket;
+        }
+        current.m_buckets.resize(lastBucket + 1 - current.m_first);
+
+        // The first bucket may have lost some of its points
+        if (headChanged && (firstBucket < start))
+        {
+            UpdateBucket(points, level, firstBucket);
+        }
+        for (size_t b = start; b <= lastBucket; ++b)
+        {
+            UpdateBucket(points, level, b);
+        }
+
+        ++level;
+    } while (firstBucket != lastBucket);
+
+    m_levels.resize(level);
+}
+
+void wxChartMinMaxPyramid::Clear()
+{
+    m_levels.clear();
+    m_begin = 0;
+    m_end = 0;
+}
+
+void wxChartMinMaxPyramid::UpdateBucket(const wxChartRingBuffer<wxPoint2DDouble> &points,
+                                        size_t level,
+                                        size_t bucket)
+{
+    const size_t shift = level + FirstLevel;
+
+    Bucket result;
+    if (level == 0)
+    {
+        // The buckets at both ends may extend past the
+        // points in the list
+        size_t begin = std::max(bucket << shift, m_begin);
+        size_t end = std::min((bucket + 1) << shift, m_end);
+
+        result = Bucket(begin, begin);
+        for (size_t i = begin + 1; i < end; ++i)
+        {
+            if (points[i - m_begin].m_y < points[result.m_minIndex - m_begin].m_y)
+            {
+                result.m_minIndex = i;
+            }
+            if (points[i - m_begin].m_y > points[result.m_maxIndex - m_begin].m_y)
+            {
+                result.m_maxIndex = i;
+            }
+        }
+    }
+    else
+    {
+        const Level &children = m_levels[level - 1];
+        size_t begin = std::max(2 * bucket, m_begin >> (shift - 1));
+        size_t end = std::min(2 * bucket + 1, (m_end - 1) >> (shift - 1));
+
+        result = children.m_buckets[begin - children.m_first];
+        for (size_t c = begin + 1; c <= end; ++c)
+        {
+            const Bucket &child = children.m_buckets[c - children.m_first];
+            if (points[child.m_minIndex - m_begin].m_y < points[result.m_minIndex - m_begin].m_y)
+            {
+                result.m_minIndex = child.m_minIndex;
+            }
+            if (points[child.m_maxIndex - m_begin].m_y > points[result.m_maxIndex - m_begin].m_y)
+            {
+                result.m_maxIndex = child.m_maxIndex;
+            }
+        }
+    }
+
+    Level &current = m_levels[level];
+    current.m_buckets[bucket - current.m_first] = result;
+}
+
+void wxChartMinMaxPyramid::Select(size_t first,
+                                  size_t last,
+                                  size_t buckets,
+                                  wxVector<size_t> &indices) const
+{
+    if (first >= last)
+    {
+        return;
+    }
+
+    if (buckets == 0)
+    {
+        buckets = 1;
+    }
+
+    // The largest bucket size that is a power of two and
+    // gives at least the requested number of buckets
+    const size_t pointsPerBucket = (last - first) / buckets;
+    size_t shift = 0;
+    while (((shift + 1) < (FirstLevel + m_levels.size())) &&
+        (((size_t)2 << shift) <= pointsPerBucket))
+    {
+        ++shift;
+    }
+
+    if ((shift < FirstLevel) || m_levels.empty())
+    {
+        // There are only a few points per bucket,
+        // all of them are used
+        for (size_t i = first; i < last; ++i)
+        {
+            indices.push_back(i);
+        }
+        return;
+    }
+
+    const Level &level = m_levels[shift - FirstLevel];
+
+    indices.push_back(first);
+    const size_t lastBucket = ((m_begin + last - 1) >> shift);
+    for (size_t b = ((m_begin + first) >> shift); b <= lastBucket; ++b)
+    {
+        const Bucket &bucket = level.m_buckets[b - level.m_first];
+        size_t index1 = std::min(bucket.m_minIndex, bucket.m_maxIndex) - m_begin;
+        size_t index2 = std::max(bucket.m_minIndex, bucket.m_maxIndex) - m_begin;
+
+        // The buckets at both ends may extend past the
+        // range, their points outside of it are skipped
+        if ((index1 > indices.back()) && (index1 < (last - 1)))
+        {
+            indices.push_back(index1);
+        }
+        if ((index2 > indices.back()) && (index2 < (last - 1)))
+        {
+            indices.push_back(index2);
+        }
+    }
+    if ((last - 1) > indices.back())
+    {
+        indices.push_back(last - 1);
+    }
+}
@@ -47,20 +47,24 @@ wxChartMultiTooltip::wxChartMultiTooltip(const wxString &title,
 }
 
 void wxChartMultiTooltip::Draw(wxGraphicsContext &gc)
+{
+	wxChartGraphicsCache cache;
+	Draw(gc, cache);
+}
+
+void wxChartMultiTooltip::Draw(wxGraphicsContext &gc,
+							   wxChartGraphicsCache &cache)
 {
 	// First we will compute the size of each of the lines
 	// of the multi-tooltip and its total size.
 	/////
 
-	wxFont titleFont(m_options.GetTitleFontOptions().GetFont());
-	wxFont textFont(m_options.GetTextFontOptions().GetFont());
-
 	// Get the size of the title
 	wxDouble titleWidth = 0;
 	wxDouble titleHeight = 0;
     if (m_options.ShowTitle())
     {
-        wxChartUtilities::GetTextSize(gc, titleFont, m_title, titleWidth, titleHeight);
+        wxChartUtilities::GetTextSize(gc, m_options.GetTitleFontOptions(), m_title, titleWidth, titleHeight);
     }
 
 	// Update the size of each line to reflect the currently
@@ -173,21 +177,20 @@ void wxChartMultiTooltip::Draw(wxGraphicsContext &gc)
 	wxGraphicsPath path = gc.CreatePath();
 	path.AddRoundedRectangle(outerX, outerY, totalOuterWidth, totalOuterHeight,
 		m_options.GetCornerRadius());
-	wxBrush brush(m_options.GetBackgroundColor());
-	gc.SetBrush(brush);
+	gc.SetBrush(cache.GetBrush(gc, m_options.GetBackgroundColor()));
 	gc.FillPath(path);
 
     if (m_options.ShowTitle())
     {
         // Draw the title
-        gc.SetFont(titleFont, m_options.GetTitleFontOptions().GetColor());
+        gc.SetFont(cache.GetFont(gc, m_options.GetTitleFontOptions()));
         gc.DrawText(m_title, innerX, innerY);
     }
 
 	// Draw the lines
 	for (size_t i = 0; i < m_lines.size(); ++i)
 	{
-		m_lines[i].Draw(gc);
+		m_lines[i].Draw(gc, cache);
 	}
 }
 
@@ -23,7 +23,8 @@
 #include "wxchartoptions.h"
 
 wxChartOptions::wxChartOptions()
-	: m_responsive(true), m_showTooltips(true), m_enableSaveAsMenu(true)
+	: m_responsive(true), m_showTooltips(true), m_enableSaveAsMenu(true),
+	m_backgroundFitThreshold(100000), m_parallelFitThreshold(50000)
 {
 }
 
@@ -67,3 +68,23 @@ bool wxChartOptions::IsSaveAsMenuEnabled() const
 {
     return m_enableSaveAsMenu;
 }
+
+size_t wxChartOptions::GetBackgroundFitThreshold() const
+{
+    return m_backgroundFitThreshold;
+}
+
+void wxChartOptions::SetBackgroundFitThreshold(size_t threshold)
+{
+    m_backgroundFitThreshold = threshold;
+}
+
+size_t wxChartOptions::GetParallelFitThreshold() const
+{
+    return m_parallelFitThreshold;
+}
+
+void wxChartOptions::SetParallelFitThreshold(size_t threshold)
+{
+    m_parallelFitThreshold = threshold;
+}
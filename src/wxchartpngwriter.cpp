@@ -0,0 +1,170 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartpngwriter.h"
+
+// The compressed data is written in chunks of about
+// this size
+static const size_t ImageDataChunkSize = 64 * 1024;
+
+// The table used to compute the CRC of the chunks, it is
+// built before main() so it can be shared by the threads
+class CRCTable
+{
+public:
+    CRCTable()
+    {
+        for (wxUint32 i = 0; i < 256; ++i)
+        {
+            wxUint32 c = i;
+            for (int k = 0; k < 8; ++k)
+            {
+                c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+            }
+            m_values[i] = c;
+        }
+    }
+
+    wxUint32 Update(wxUint32 crc, const unsigned char *data, size_t size) const
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            crc = m_values[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+private:
+    wxUint32 m_values[256];
+};
+
+static const CRCTable crcTable;
+
+static void StoreUint32(unsigned char *buffer, wxUint32 value)
+{
+    buffer[0] = (value >> 24) & 0xFF;
+    buffer[1] = (value >> 16) & 0xFF;
+    buffer[2] = (value >> 8) & 0xFF;
+    buffer[3] = value & 0xFF;
+}
+
+size_t wxChartPNGWriter::DataBuffer::OnSysWrite(const void *buffer,
+                                                size_t size)
+{
+    const unsigned char *bytes = static_cast<const unsigned char*>(buffer);
+    m_data.insert(m_data.end(), bytes, bytes + size);
+    return size;
+}
+
+wxChartPNGWriter::wxChartPNGWriter(wxOutputStream &stream,
+                                   const wxSize &size)
+    : m_stream(stream), m_size(size), m_rowsWritten(0),
+      m_compressor(new wxZlibOutputStream(m_imageData, -1, wxZLIB_ZLIB)),
+      m_row(1 + (3 * size.GetWidth())), m_closed(false)
+{
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    m_stream.Write(signature, sizeof(signature));
+
+    unsigned char header[13];
+    StoreUint32(header, size.GetWidth());
+    StoreUint32(header + 4, size.GetHeight());
+    header[8] = 8;      // Bit depth
+    header[9] = 2;      // Color type: RGB
+    header[10] = 0;     // Compression method: deflate
+    header[11] = 0;     // Filter method: adaptive
+    header[12] = 0;     // No interlacing
+    WriteChunk("IHDR", header, sizeof(header));
+}
+
+wxChartPNGWriter::~wxChartPNGWriter()
+{
+    delete m_compressor;
+}
+
+void wxChartPNGWriter::WriteRows(const unsigned char *rgb,
+                                 size_t stride,
+                                 size_t numberOfRows)
+{
+    const size_t rowSize = 3 * m_size.GetWidth();
+    for (size_t i = 0; (i < numberOfRows) && (m_rowsWritten < (size_t)m_size.GetHeight()); ++i)
+    {
+        // The Sub filter stores the difference with the
+        // pixel on the left which compresses the flat
+        // areas of a chart very well
+        const unsigned char *row = rgb + (i * stride);
+        m_row[0] = 1;
+        for (size_t j = 0; j < rowSize; ++j)
+        {
+            m_row[j + 1] = (j < 3) ? row[j] : (unsigned char)(row[j] - row[j - 3]);
+        }
+        m_compressor->Write(&m_row[0], m_row.size());
+        ++m_rowsWritten;
+    }
+
+    WriteImageData(false);
+}
+
+bool wxChartPNGWriter::Close()
+{
+    if (m_closed)
+    {
+        return false;
+    }
+    m_closed = true;
+
+    m_compressor->Close();
+    WriteImageData(true);
+    WriteChunk("IEND", 0, 0);
+
+    return (m_stream.IsOk() && (m_rowsWritten == (size_t)m_size.GetHeight()));
+}
+
+void wxChartPNGWriter::WriteChunk(const char *type,
+                                  const unsigned char *data,
+                                  size_t size)
+{
+    unsigned char buffer[4];
+    StoreUint32(buffer, size);
+    m_stream.Write(buffer, 4);
+    m_stream.Write(type, 4);
+    if (size != 0)
+    {
+        m_stream.Write(data, size);
+    }
+
+    wxUint32 crc = crcTable.Update(0xFFFFFFFF, reinterpret_cast<const unsigned char*>(type), 4);
+    crc = crcTable.Update(crc, data, size) ^ 0xFFFFFFFF;
+    StoreUint32(buffer, crc);
+    m_stream.Write(buffer, 4);
+}
+
+void wxChartPNGWriter::WriteImageData(bool force)
+{
+    wxVector<unsigned char> &data = m_imageData.m_data;
+    if (data.empty() || (!force && (data.size() < ImageDataChunkSize)))
+    {
+        return;
+    }
+
+    WriteChunk("IDAT", &data[0], data.size());
+    data.clear();
+}
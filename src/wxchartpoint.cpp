@@ -32,8 +32,6 @@
 */
 
 #include "wxchartpoint.h"
-#include <wx/pen.h>
-#include <wx/brush.h>
 
 wxChartPoint::wxChartPoint(wxDouble x,
 						   wxDouble y, 
@@ -73,17 +71,15 @@ wxPoint2DDouble wxChartPoint::GetTooltipPosition() const
 
 void wxChartPoint::Draw(wxGraphicsContext &gc)
 {
-	wxGraphicsPath path = gc.CreatePath();
-	path.AddArc(m_position.m_x, m_position.m_y, m_radius, 0, 2 * M_PI, false);
-	path.CloseSubpath();
-
-	wxBrush brush(m_options.GetFillColor());
-	gc.SetBrush(brush);
-	gc.FillPath(path);
+	wxChartBatchRenderer renderer(gc);
+	Draw(renderer);
+}
 
-	wxPen pen(m_options.GetStrokeColor(), m_options.GetStrokeWidth());
-	gc.SetPen(pen);
-	gc.StrokePath(path);
+void wxChartPoint::Draw(wxChartBatchRenderer &renderer) const
+{
+	renderer.SetStyle(m_options.GetFillColor(), m_options.GetStrokeColor(),
+		m_options.GetStrokeWidth());
+	renderer.AddCircle(m_position.m_x, m_position.m_y, m_radius);
 }
 
 const wxPoint2DDouble& wxChartPoint::GetPosition() const
@@ -101,3 +97,8 @@ void wxChartPoint::SetPosition(wxPoint2DDouble position)
 {
 	m_position = position;
 }
+
+wxDouble wxChartPoint::GetHitDetectionRange() const
+{
+	return m_hitDetectionRange;
+}
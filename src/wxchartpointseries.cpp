@@ -0,0 +1,148 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartpointseries.h"
+
+wxChartPointSeries::wxChartPointSeries(size_t count,
+                                       wxDouble radius,
+                                       wxDouble hitDetectionRange,
+                                       const wxChartPointOptions &options)
+    : m_positions(count, wxPoint2DDouble(0, 0)), m_radius(radius),
+    m_hitDetectionRange(hitDetectionRange), m_options(options)
+{
+}
+
+size_t wxChartPointSeries::GetCount() const
+{
+    return m_positions.size();
+}
+
+void wxChartPointSeries::SetCount(size_t count)
+{
+    m_positions.resize(count, wxPoint2DDouble(0, 0));
+}
+
+const wxPoint2DDouble& wxChartPointSeries::GetPosition(size_t index) const
+{
+    return m_positions[index];
+}
+
+const wxVector<wxPoint2DDouble>& wxChartPointSeries::GetPositions() const
+{
+    return m_positions;
+}
+
+void wxChartPointSeries::SetPosition(size_t index,
+                                     const wxPoint2DDouble &position)
+{
+    m_positions[index] = position;
+}
+
+void wxChartPointSeries::SwapPositions(wxVector<wxPoint2DDouble> &positions)
+{
+    wxASSERT(positions.size() == m_positions.size());
+    m_positions.swap(positions);
+}
+
+wxDouble wxChartPointSeries::GetRadius() const
+{
+    return m_radius;
+}
+
+wxDouble wxChartPointSeries::GetHitDetectionRange() const
+{
+    return m_hitDetectionRange;
+}
+
+const wxChartPointOptions& wxChartPointSeries::GetOptions() const
+{
+    return m_options;
+}
+
+bool wxChartPointSeries::HitTest(size_t index,
+                                 const wxPoint &point) const
+{
+    wxDouble distanceFromXCenterSquared = point.x - m_positions[index].m_x;
+    distanceFromXCenterSquared *= distanceFromXCenterSquared;
+    wxDouble distanceFromYCenterSquared = point.y - m_positions[index].m_y;
+    distanceFromYCenterSquared *= distanceFromYCenterSquared;
+
+    return ((distanceFromXCenterSquared + distanceFromYCenterSquared) <= (m_hitDetectionRange * m_hitDetectionRange));
+}
+
+void wxChartPointSeries::Draw(wxChartBatchRenderer &renderer) const
+{
+    // All the points use the same pen and brush so they
+    // are drawn as one batch
+    renderer.SetStyle(m_options.GetFillColor(), m_options.GetStrokeColor(),
+        m_options.GetStrokeWidth());
+    for (size_t i = 0; i < m_positions.size(); ++i)
+    {
+        renderer.AddCircle(m_positions[i].m_x, m_positions[i].m_y, m_radius);
+    }
+}
+
+// Whether any part of a point centered on position
+// can be inside the clip area
+static bool IsVisible(const wxPoint2DDouble &position,
+                      const wxRect2DDouble &clip,
+                      wxDouble margin)
+{
+    return ((position.m_x >= (clip.GetLeft() - margin)) &&
+        (position.m_x <= (clip.GetRight() + margin)) &&
+        (position.m_y >= (clip.GetTop() - margin)) &&
+        (position.m_y <= (clip.GetBottom() + margin)));
+}
+
+void wxChartPointSeries::Draw(wxChartBatchRenderer &renderer,
+                              const wxRect2DDouble &clip) const
+{
+    renderer.SetStyle(m_options.GetFillColor(), m_options.GetStrokeColor(),
+        m_options.GetStrokeWidth());
+    const wxDouble margin = m_radius + m_options.GetStrokeWidth();
+
+    for (size_t i = 0; i < m_positions.size(); ++i)
+    {
+        if (IsVisible(m_positions[i], clip, margin))
+        {
+            renderer.AddCircle(m_positions[i].m_x, m_positions[i].m_y, m_radius);
+        }
+    }
+}
+
+void wxChartPointSeries::Draw(wxChartBatchRenderer &renderer,
+                              const wxVector<size_t> &indices,
+                              const wxRect2DDouble &clip) const
+{
+    renderer.SetStyle(m_options.GetFillColor(), m_options.GetStrokeColor(),
+        m_options.GetStrokeWidth());
+    const wxDouble margin = m_radius + m_options.GetStrokeWidth();
+
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        const wxPoint2DDouble &position = m_positions[indices[i]];
+        if (IsVisible(position, clip, margin))
+        {
+            renderer.AddCircle(position.m_x, position.m_y, m_radius);
+        }
+    }
+}
@@ -66,18 +66,19 @@ wxPoint2DDouble wxChartRadialGrid::GetTooltipPosition() const
 	return wxPoint2DDouble(0, 0);
 }
 
-void wxChartRadialGrid::Draw(wxGraphicsContext &gc)
+void wxChartRadialGrid::Draw(wxGraphicsContext &gc,
+                             wxChartGraphicsCache &cache)
 {
     Fit(gc);
 
 	switch (m_options.GetStyle())
 	{
 	case wxCHARTRADIALGRIDSTYLE_CIRCULAR:
-		DrawCircular(gc);
+		DrawCircular(gc, cache);
 		break;
 
 	case wxCHARTRADIALGRIDSTYLE_POLYGONAL:
-		DrawPolygonal(gc);
+		DrawPolygonal(gc, cache);
 		break;
 	}
 }
@@ -106,8 +107,11 @@ void wxChartRadialGrid::Fit(wxGraphicsContext &gc)
     m_needsFit = false;
 }
 
-void wxChartRadialGrid::DrawCircular(wxGraphicsContext &gc)
+void wxChartRadialGrid::DrawCircular(wxGraphicsContext &gc,
+                                     wxChartGraphicsCache &cache)
 {
+	const wxGraphicsPen pen = cache.GetPen(gc, m_options.GetLineColor(), m_options.GetLineWidth());
+
 	for (size_t i = 0; i < m_labels.size(); ++i)
 	{
 		wxDouble yCenterOffset = (i + 1) * (m_drawingArea / m_steps);
@@ -117,7 +121,6 @@ void wxChartRadialGrid::DrawCircular(wxGraphicsContext &gc)
 		path.AddArc(m_center.m_x, m_center.m_y, yCenterOffset, 0, 2 * M_PI, true);
 		path.CloseSubpath();
 
-		wxPen pen(m_options.GetLineColor(), m_options.GetLineWidth());
 		gc.SetPen(pen);
 		gc.StrokePath(path);
 
@@ -132,12 +135,15 @@ void wxChartRadialGrid::DrawCircular(wxGraphicsContext &gc)
 
     if (m_options.ShowLabels())
     {
-        m_labels.Draw(gc);
+        m_labels.Draw(gc, cache);
     }
 }
 
-void wxChartRadialGrid::DrawPolygonal(wxGraphicsContext &gc)
+void wxChartRadialGrid::DrawPolygonal(wxGraphicsContext &gc,
+                                      wxChartGraphicsCache &cache)
 {
+	const wxGraphicsPen pen = cache.GetPen(gc, m_options.GetLineColor(), m_options.GetLineWidth());
+
 	// Don't draw a centre value so start from 1
 	for (size_t i = 1; i < m_labels.size(); ++i)
 	{
@@ -152,7 +158,6 @@ void wxChartRadialGrid::DrawPolygonal(wxGraphicsContext &gc)
 		}
 		path.CloseSubpath();
 
-		wxPen pen(m_options.GetLineColor(), m_options.GetLineWidth());
 		gc.SetPen(pen);
 		gc.StrokePath(path);
 	}
@@ -32,8 +32,6 @@
 */
 
 #include "wxchartrectangle.h"
-#include <wx/pen.h>
-#include <wx/brush.h>
 
 wxChartRectangle::wxChartRectangle(wxDouble x,
 								   wxDouble y,
@@ -59,46 +57,15 @@ wxPoint2DDouble wxChartRectangle::GetTooltipPosition() const
 
 void wxChartRectangle::Draw(wxGraphicsContext &gc) const
 {
-	wxGraphicsPath path = gc.CreatePath();
-
-	path.AddRectangle(m_position.m_x, m_position.m_y, m_width, m_height);
-
-	wxBrush brush(m_options.GetFillColor());
-	gc.SetBrush(brush);
-	gc.FillPath(path);
-
-	if (m_options.GetDirections() == wxALL)
-	{
-		wxPen pen(m_options.GetStrokeColor(), 2);
-		gc.SetPen(pen);
-		gc.StrokePath(path);
-	}
-	else
-	{
-		wxPen pen(m_options.GetStrokeColor(), 2);
-		gc.SetPen(pen);
-
-		if (m_options.GetDirections() & wxTOP)
-		{
-			gc.StrokeLine(m_position.m_x, m_position.m_y, 
-				m_position.m_x + m_width, m_position.m_y);
-		}
-		if (m_options.GetDirections() & wxRIGHT)
-		{
-			gc.StrokeLine(m_position.m_x + m_width, m_position.m_y, 
-				m_position.m_x + m_width, m_position.m_y + m_height);
-		}
-		if (m_options.GetDirections() & wxBOTTOM)
-		{
-			gc.StrokeLine(m_position.m_x, m_position.m_y + m_height,
-				m_position.m_x + m_width, m_position.m_y + m_height);
-		}
-		if (m_options.GetDirections() & wxLEFT)
-		{
-			gc.StrokeLine(m_position.m_x, m_position.m_y,
-				m_position.m_x, m_position.m_y + m_height);
-		}
-	}
+	wxChartBatchRenderer renderer(gc);
+	Draw(renderer);
+}
+
+void wxChartRectangle::Draw(wxChartBatchRenderer &renderer) const
+{
+	renderer.SetStyle(m_options.GetFillColor(), m_options.GetStrokeColor(), 2);
+	renderer.AddRectangle(m_position.m_x, m_position.m_y, m_width, m_height,
+		m_options.GetDirections());
 }
 
 const wxPoint2DDouble& wxChartRectangle::GetPosition() const
@@ -0,0 +1,144 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartslidingminmax.h"
+
+wxChartSlidingMinMax::Entry::Entry(size_t position,
+                                   wxDouble value)
+    : m_position(position), m_value(value)
+{
+}
+
+wxChartSlidingMinMax::Queue::Queue()
+    : m_first(0)
+{
+}
+
+bool wxChartSlidingMinMax::Queue::IsEmpty() const
+{
+    return (m_first == m_entries.size());
+}
+
+const wxChartSlidingMinMax::Entry& wxChartSlidingMinMax::Queue::GetFront() const
+{
+    return m_entries[m_first];
+}
+
+const wxChartSlidingMinMax::Entry& wxChartSlidingMinMax::Queue::GetBack() const
+{
+    return m_entries.back();
+}
+
+void wxChartSlidingMinMax::Queue::PushBack(const Entry &entry)
+{
+    m_entries.push_back(entry);
+}
+
+void wxChartSlidingMinMax::Queue::PopFront()
+{
+    ++m_first;
+    if (m_first == m_entries.size())
+    {
+        Clear();
+    }
+    else if ((2 * m_first) >= m_entries.size())
+    {
+        m_entries.erase(m_entries.begin(), m_entries.begin() + m_first);
+        m_first = 0;
+    }
+}
+
+void wxChartSlidingMinMax::Queue::PopBack()
+{
+    m_entries.pop_back();
+    if (m_first == m_entries.size())
+    {
+        Clear();
+    }
+}
+
+void wxChartSlidingMinMax::Queue::Clear()
+{
+    m_entries.clear();
+    m_first = 0;
+}
+
+wxChartSlidingMinMax::wxChartSlidingMinMax()
+    : m_pushed(0), m_popped(0)
+{
+}
+
+void wxChartSlidingMinMax::Push(wxDouble value)
+{
+    // A value that is older and not smaller than the new
+    // one can never be the minimum again, and conversely
+    // for the maximum
+    while (!m_min.IsEmpty() && (m_min.GetBack().m_value >= value))
+    {
+        m_min.PopBack();
+    }
+    m_min.PushBack(Entry(m_pushed, value));
+
+    while (!m_max.IsEmpty() && (m_max.GetBack().m_value <= value))
+    {
+        m_max.PopBack();
+    }
+    m_max.PushBack(Entry(m_pushed, value));
+
+    ++m_pushed;
+}
+
+void wxChartSlidingMinMax::Pop()
+{
+    if (m_min.GetFront().m_position == m_popped)
+    {
+        m_min.PopFront();
+    }
+    if (m_max.GetFront().m_position == m_popped)
+    {
+        m_max.PopFront();
+    }
+    ++m_popped;
+}
+
+void wxChartSlidingMinMax::Clear()
+{
+    m_min.Clear();
+    m_max.Clear();
+    m_pushed = 0;
+    m_popped = 0;
+}
+
+bool wxChartSlidingMinMax::IsEmpty() const
+{
+    return (m_pushed == m_popped);
+}
+
+wxDouble wxChartSlidingMinMax::GetMin() const
+{
+    return m_min.GetFront().m_value;
+}
+
+wxDouble wxChartSlidingMinMax::GetMax() const
+{
+    return m_max.GetFront().m_value;
+}
@@ -0,0 +1,217 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartspatialindex.h"
+#include <algorithm>
+#include <cmath>
+
+// Cells are never smaller than this, in pixels
+static const wxDouble MinCellSize = 8;
+
+wxChartSpatialIndex::wxChartSpatialIndex()
+    : m_originX(0), m_originY(0), m_cellSize(MinCellSize),
+    m_columns(0), m_rows(0), m_count(0)
+{
+}
+
+void wxChartSpatialIndex::Clear()
+{
+    m_pending.clear();
+    m_columns = 0;
+    m_rows = 0;
+    m_count = 0;
+    m_cellStarts.clear();
+    m_items.clear();
+}
+
+void wxChartSpatialIndex::Add(const wxPoint2DDouble &position,
+                              wxDouble extent)
+{
+    size_t item = m_count++;
+
+    // Items that couldn't be mapped to the window can't
+    // be hit and would break the computation of the bounds
+    if (!std::isfinite(position.m_x) || !std::isfinite(position.m_y) ||
+        !std::isfinite(extent))
+    {
+        return;
+    }
+
+    Entry entry;
+    entry.item = item;
+    entry.x = position.m_x;
+    entry.y = position.m_y;
+    entry.extent = (extent > 0) ? extent : 0;
+    m_pending.push_back(entry);
+}
+
+void wxChartSpatialIndex::Build()
+{
+    m_columns = 0;
+    m_rows = 0;
+    m_cellStarts.clear();
+    m_items.clear();
+
+    if (m_pending.empty())
+    {
+        return;
+    }
+
+    wxDouble minX = m_pending[0].x - m_pending[0].extent;
+    wxDouble minY = m_pending[0].y - m_pending[0].extent;
+    wxDouble maxX = m_pending[0].x + m_pending[0].extent;
+    wxDouble maxY = m_pending[0].y + m_pending[0].extent;
+    wxDouble totalExtent = 0;
+    for (size_t i = 0; i < m_pending.size(); ++i)
+    {
+        const Entry &entry = m_pending[i];
+        minX = std::min(minX, entry.x - entry.extent);
+        minY = std::min(minY, entry.y - entry.extent);
+        maxX = std::max(maxX, entry.x + entry.extent);
+        maxY = std::max(maxY, entry.y + entry.extent);
+        totalExtent += entry.extent;
+    }
+
+    // Cells about the size of a typical hit detection area
+    // keep the number of cells an item is registered in
+    // low. The number of cells is then limited so that the
+    // grid never uses much more memory than the items.
+    m_cellSize = std::max(MinCellSize, 2 * totalExtent / m_pending.size());
+    const wxDouble maxCells = std::max<wxDouble>(1024, 4 * m_pending.size());
+    while (((std::floor((maxX - minX) / m_cellSize) + 1) *
+        (std::floor((maxY - minY) / m_cellSize) + 1)) > maxCells)
+    {
+        m_cellSize *= 2;
+    }
+
+    m_originX = minX;
+    m_originY = minY;
+    m_columns = static_cast<size_t>(std::floor((maxX - minX) / m_cellSize)) + 1;
+    m_rows = static_cast<size_t>(std::floor((maxY - minY) / m_cellSize)) + 1;
+
+    // Count the items in each cell and then fill the
+    // cells in the order the items were added
+    m_cellStarts.resize((m_columns * m_rows) + 1, 0);
+    for (size_t i = 0; i < m_pending.size(); ++i)
+    {
+        const Entry &entry = m_pending[i];
+        size_t firstColumn, firstRow, lastColumn, lastRow;
+        if (GetCellRange(entry.x - entry.extent, entry.y - entry.extent,
+            entry.x + entry.extent, entry.y + entry.extent,
+            firstColumn, firstRow, lastColumn, lastRow))
+        {
+            for (size_t row = firstRow; row <= lastRow; ++row)
+            {
+                for (size_t column = firstColumn; column <= lastColumn; ++column)
+                {
+                    ++m_cellStarts[(row * m_columns) + column + 1];
+                }
+            }
+        }
+    }
+
+    for (size_t i = 1; i < m_cellStarts.size(); ++i)
+    {
+        m_cellStarts[i] += m_cellStarts[i - 1];
+    }
+
+    wxVector<size_t> cursors(m_cellStarts);
+    m_items.resize(m_cellStarts.back(), 0);
+    for (size_t i = 0; i < m_pending.size(); ++i)
+    {
+        const Entry &entry = m_pending[i];
+        size_t firstColumn, firstRow, lastColumn, lastRow;
+        if (GetCellRange(entry.x - entry.extent, entry.y - entry.extent,
+            entry.x + entry.extent, entry.y + entry.extent,
+            firstColumn, firstRow, lastColumn, lastRow))
+        {
+            for (size_t row = firstRow; row <= lastRow; ++row)
+            {
+                for (size_t column = firstColumn; column <= lastColumn; ++column)
+                {
+                    m_items[cursors[(row * m_columns) + column]++] = entry.item;
+                }
+            }
+        }
+    }
+
+    // The pending list can be large so release its memory
+    wxVector<Entry> empty;
+    m_pending.swap(empty);
+}
+
+void wxChartSpatialIndex::Swap(wxChartSpatialIndex &other)
+{
+    m_pending.swap(other.m_pending);
+    std::swap(m_originX, other.m_originX);
+    std::swap(m_originY, other.m_originY);
+    std::swap(m_cellSize, other.m_cellSize);
+    std::swap(m_columns, other.m_columns);
+    std::swap(m_rows, other.m_rows);
+    std::swap(m_count, other.m_count);
+    m_cellStarts.swap(other.m_cellStarts);
+    m_items.swap(other.m_items);
+}
+
+void wxChartSpatialIndex::Query(const wxPoint &point,
+                                wxVector<size_t> &items) const
+{
+    size_t firstColumn, firstRow, lastColumn, lastRow;
+    if ((m_columns == 0) ||
+        !GetCellRange(point.x, point.y, point.x, point.y,
+            firstColumn, firstRow, lastColumn, lastRow))
+    {
+        return;
+    }
+
+    size_t cell = (firstRow * m_columns) + firstColumn;
+    for (size_t i = m_cellStarts[cell]; i < m_cellStarts[cell + 1]; ++i)
+    {
+        items.push_back(m_items[i]);
+    }
+}
+
+bool wxChartSpatialIndex::GetCellRange(wxDouble minX,
+                                       wxDouble minY,
+                                       wxDouble maxX,
+                                       wxDouble maxY,
+                                       size_t &firstColumn,
+                                       size_t &firstRow,
+                                       size_t &lastColumn,
+                                       size_t &lastRow) const
+{
+    wxDouble left = std::floor((minX - m_originX) / m_cellSize);
+    wxDouble top = std::floor((minY - m_originY) / m_cellSize);
+    wxDouble right = std::floor((maxX - m_originX) / m_cellSize);
+    wxDouble bottom = std::floor((maxY - m_originY) / m_cellSize);
+    if ((right < 0) || (bottom < 0) ||
+        (left >= m_columns) || (top >= m_rows))
+    {
+        return false;
+    }
+
+    firstColumn = (left < 0) ? 0 : static_cast<size_t>(left);
+    firstRow = (top < 0) ? 0 : static_cast<size_t>(top);
+    lastColumn = (right >= m_columns) ? (m_columns - 1) : static_cast<size_t>(right);
+    lastRow = (bottom >= m_rows) ? (m_rows - 1) : static_cast<size_t>(bottom);
+    return true;
+}
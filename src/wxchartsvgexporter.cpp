@@ -0,0 +1,1568 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartsvgexporter.h"
+#include <wx/graphics.h>
+#include <wx/wfstream.h>
+#include <wx/mstream.h>
+#include <wx/base64.h>
+#include <wx/image.h>
+#include <wx/region.h>
+#include <wx/icon.h>
+#include <algorithm>
+#include <set>
+#include <map>
+#include <string>
+#include <cmath>
+#include <cstdio>
+
+// Appends a number with at most 2 decimals, independently
+// of the locale
+static void AppendNumber(std::string &output, wxDouble value)
+{
+    long long scaled = (long long)floor((value * 100) + 0.5);
+    if (scaled < 0)
+    {
+        output += '-';
+        scaled = -scaled;
+    }
+
+    char buffer[32];
+    long long integral = scaled / 100;
+    int fraction = (int)(scaled % 100);
+    if (fraction == 0)
+    {
+        sprintf(buffer, "%lld", integral);
+    }
+    else if ((fraction % 10) == 0)
+    {
+        sprintf(buffer, "%lld.%d", integral, fraction / 10);
+    }
+    else
+    {
+        sprintf(buffer, "%lld.%02d", integral, fraction);
+    }
+    output += buffer;
+}
+
+static void AppendPoint(std::string &output, wxDouble x, wxDouble y)
+{
+    AppendNumber(output, x);
+    output += ' ';
+    AppendNumber(output, y);
+}
+
+static void AppendColour(std::string &output, const char *property,
+                         const wxColour &colour)
+{
+    char buffer[16];
+    sprintf(buffer, "#%02x%02x%02x", colour.Red(), colour.Green(), colour.Blue());
+    output += property;
+    output += ':';
+    output += buffer;
+    if (colour.Alpha() != wxALPHA_OPAQUE)
+    {
+        output += ';';
+        output += property;
+        output += "-opacity:";
+        AppendNumber(output, colour.Alpha() / 255.0);
+    }
+}
+
+static void AppendEscaped(std::string &output, const wxString &text)
+{
+    const wxScopedCharBuffer utf8 = text.utf8_str();
+    for (const char *c = utf8.data(); *c != 0; ++c)
+    {
+        switch (*c)
+        {
+        case '&':
+            output += "&amp;";
+            break;
+
+        case '<':
+            output += "&lt;";
+            break;
+
+        case '>':
+            output += "&gt;";
+            break;
+
+        case '"':
+            output += "&quot;";
+            break;
+
+        default:
+            output += *c;
+            break;
+        }
+    }
+}
+
+// An affine transformation, with the same conventions
+// as wxGraphicsMatrix
+struct SVGTransform
+{
+    SVGTransform()
+        : m_a(1), m_b(0), m_c(0), m_d(1), m_tx(0), m_ty(0)
+    {
+    }
+
+    SVGTransform(wxDouble a, wxDouble b, wxDouble c, wxDouble d,
+        wxDouble tx, wxDouble ty)
+        : m_a(a), m_b(b), m_c(c), m_d(d), m_tx(tx), m_ty(ty)
+    {
+    }
+
+    bool IsIdentity() const
+    {
+        return ((m_a == 1) && (m_b == 0) && (m_c == 0) &&
+            (m_d == 1) && (m_tx == 0) && (m_ty == 0));
+    }
+
+    // Applies t before this transformation
+    void Concat(const SVGTransform &t)
+    {
+        SVGTransform result(m_a * t.m_a + m_c * t.m_b,
+            m_b * t.m_a + m_d * t.m_b,
+            m_a * t.m_c + m_c * t.m_d,
+            m_b * t.m_c + m_d * t.m_d,
+            m_a * t.m_tx + m_c * t.m_ty + m_tx,
+            m_b * t.m_tx + m_d * t.m_ty + m_ty);
+        *this = result;
+    }
+
+    bool Invert()
+    {
+        wxDouble determinant = m_a * m_d - m_b * m_c;
+        if (determinant == 0)
+        {
+            return false;
+        }
+        SVGTransform result(m_d / determinant, -m_b / determinant,
+            -m_c / determinant, m_a / determinant,
+            (m_c * m_ty - m_d * m_tx) / determinant,
+            (m_b * m_tx - m_a * m_ty) / determinant);
+        *this = result;
+        return true;
+    }
+
+    // Appends the transform attribute of an element
+    void Append(std::string &output) const
+    {
+        if (IsIdentity())
+        {
+            return;
+        }
+
+        output += " transform=\"matrix(";
+        AppendPoint(output, m_a, m_b);
+        output += ' ';
+        AppendPoint(output, m_c, m_d);
+        output += ' ';
+        AppendPoint(output, m_tx, m_ty);
+        output += ")\"";
+    }
+
+    wxDouble m_a;
+    wxDouble m_b;
+    wxDouble m_c;
+    wxDouble m_d;
+    wxDouble m_tx;
+    wxDouble m_ty;
+};
+
+// Writes the document to the stream and keeps track of
+// the shared definitions
+class SVGDocument
+{
+public:
+    SVGDocument(wxOutputStream &stream)
+        : m_stream(stream), m_numberOfClipPaths(0), m_numberOfImages(0)
+    {
+    }
+
+    void Write(const std::string &text)
+    {
+        m_stream.Write(text.data(), text.size());
+    }
+
+    // Gets the CSS class of a style, the style is
+    // defined the first time it is used
+    const std::string& GetClass(const std::string &style)
+    {
+        std::map<std::string, std::string>::const_iterator it = m_classes.find(style);
+        if (it != m_classes.end())
+        {
+            return it->second;
+        }
+
+        char name[32];
+        sprintf(name, "s%lu", (unsigned long)m_classes.size());
+        Write(std::string("<style>.") + name + '{' + style + "}</style>\n");
+        return (m_classes[style] = name);
+    }
+
+    std::string AddClipPath(const std::string &shape)
+    {
+        char id[32];
+        sprintf(id, "c%lu", (unsigned long)m_numberOfClipPaths++);
+        Write(std::string("<clipPath id=\"") + id + "\">" + shape + "</clipPath>\n");
+        return id;
+    }
+
+    // Returns an empty string if the image can't be encoded
+    std::string AddImage(const wxImage &image)
+    {
+        wxMemoryOutputStream png;
+        if (!image.IsOk() || !wxImage::FindHandler(wxBITMAP_TYPE_PNG) ||
+            !image.SaveFile(png, wxBITMAP_TYPE_PNG) || (png.GetLength() == 0))
+        {
+            return std::string();
+        }
+        wxVector<char> data(png.GetLength());
+        png.CopyTo(&data[0], data.size());
+
+        char id[32];
+        sprintf(id, "i%lu", (unsigned long)m_numberOfImages++);
+        std::string element("<defs><image id=\"");
+        element += id;
+        element += "\" width=\"";
+        AppendNumber(element, image.GetWidth());
+        element += "\" height=\"";
+        AppendNumber(element, image.GetHeight());
+        element += "\" xlink:href=\"data:image/png;base64,";
+        element += wxBase64Encode(&data[0], data.size()).ToStdString();
+        element += "\"/></defs>\n";
+        Write(element);
+        return id;
+    }
+
+private:
+    wxOutputStream &m_stream;
+    std::map<std::string, std::string> m_classes;
+    size_t m_numberOfClipPaths;
+    size_t m_numberOfImages;
+};
+
+class SVGPenData : public wxGraphicsObjectRefData
+{
+public:
+    SVGPenData(wxGraphicsRenderer *renderer, const wxColour &colour,
+        wxDouble width, wxPenStyle style, wxPenCap cap, wxPenJoin join)
+        : wxGraphicsObjectRefData(renderer)
+    {
+        if ((style == wxPENSTYLE_TRANSPARENT) || (colour.Alpha() == wxALPHA_TRANSPARENT))
+        {
+            return;
+        }
+
+        m_style = "fill:none;";
+        AppendColour(m_style, "stroke", colour);
+        m_style += ";stroke-width:";
+        AppendNumber(m_style, (width > 0) ? width : 1);
+        m_style += (cap == wxCAP_BUTT) ? ";stroke-linecap:butt" :
+            ((cap == wxCAP_PROJECTING) ? ";stroke-linecap:square" : ";stroke-linecap:round");
+        m_style += (join == wxJOIN_MITER) ? ";stroke-linejoin:miter" :
+            ((join == wxJOIN_BEVEL) ? ";stroke-linejoin:bevel" : ";stroke-linejoin:round");
+    }
+
+    // Empty if nothing should be drawn
+    const std::string& GetStyle() const
+    {
+        return m_style;
+    }
+
+private:
+    std::string m_style;
+};
+
+class SVGBrushData : public wxGraphicsObjectRefData
+{
+public:
+    SVGBrushData(wxGraphicsRenderer *renderer, const wxColour &colour)
+        : wxGraphicsObjectRefData(renderer)
+    {
+        if (colour.Alpha() != wxALPHA_TRANSPARENT)
+        {
+            AppendColour(m_style, "fill", colour);
+            m_style += ";stroke:none";
+        }
+    }
+
+    // Empty if nothing should be drawn
+    const std::string& GetStyle() const
+    {
+        return m_style;
+    }
+
+private:
+    std::string m_style;
+};
+
+class SVGFontData : public wxGraphicsObjectRefData
+{
+public:
+    SVGFontData(wxGraphicsRenderer *renderer, const wxFont &font,
+        const wxColour &colour)
+        : wxGraphicsObjectRefData(renderer), m_font(font), m_colour(colour)
+    {
+        wxString faceName = font.GetFaceName();
+        faceName.Replace("'", "");
+        m_style = "font-family:";
+        if (!faceName.empty())
+        {
+            m_style += '\'';
+            AppendEscaped(m_style, faceName);
+            m_style += "',";
+        }
+        m_style += "sans-serif;font-size:";
+        int pixelSize = font.GetPixelSize().GetHeight();
+        AppendNumber(m_style, (pixelSize > 0) ? pixelSize : (font.GetPointSize() * 96.0 / 72));
+        m_style += "px";
+        if (font.GetWeight() == wxFONTWEIGHT_BOLD)
+        {
+            m_style += ";font-weight:bold";
+        }
+        if (font.GetStyle() == wxFONTSTYLE_ITALIC)
+        {
+            m_style += ";font-style:italic";
+        }
+        m_style += ';';
+        AppendColour(m_style, "fill", colour);
+    }
+
+    const wxFont& GetFont() const
+    {
+        return m_font;
+    }
+
+    const wxColour& GetColour() const
+    {
+        return m_colour;
+    }
+
+    const std::string& GetStyle() const
+    {
+        return m_style;
+    }
+
+private:
+    wxFont m_font;
+    wxColour m_colour;
+    std::string m_style;
+};
+
+class SVGBitmapData : public wxGraphicsBitmapData
+{
+public:
+    SVGBitmapData(wxGraphicsRenderer *renderer, const wxImage &image)
+        : wxGraphicsBitmapData(renderer), m_image(image), m_document(0)
+    {
+    }
+
+    virtual void* GetNativeBitmap() const wxOVERRIDE
+    {
+        return 0;
+    }
+
+    const wxImage& GetImage() const
+    {
+        return m_image;
+    }
+
+    // The image is written to a document the first
+    // time it is drawn on it
+    const std::string& GetId(SVGDocument &document) const
+    {
+        if (m_document != &document)
+        {
+            m_id = document.AddImage(m_image);
+            m_document = &document;
+        }
+        return m_id;
+    }
+
+private:
+    wxImage m_image;
+    mutable SVGDocument *m_document;
+    mutable std::string m_id;
+};
+
+class SVGMatrixData : public wxGraphicsMatrixData
+{
+public:
+    SVGMatrixData(wxGraphicsRenderer *renderer)
+        : wxGraphicsMatrixData(renderer)
+    {
+    }
+
+    virtual wxGraphicsObjectRefData* Clone() const wxOVERRIDE
+    {
+        SVGMatrixData *data = new SVGMatrixData(GetRenderer());
+        data->m_transform = m_transform;
+        return data;
+    }
+
+    virtual void Concat(const wxGraphicsMatrixData *t) wxOVERRIDE
+    {
+        m_transform.Concat(static_cast<const SVGMatrixData*>(t)->m_transform);
+    }
+
+    virtual void Set(wxDouble a, wxDouble b, wxDouble c, wxDouble d,
+        wxDouble tx, wxDouble ty) wxOVERRIDE
+    {
+        m_transform = SVGTransform(a, b, c, d, tx, ty);
+    }
+
+    virtual void Get(wxDouble *a, wxDouble *b, wxDouble *c, wxDouble *d,
+        wxDouble *tx, wxDouble *ty) const wxOVERRIDE
+    {
+        if (a) *a = m_transform.m_a;
+        if (b) *b = m_transform.m_b;
+        if (c) *c = m_transform.m_c;
+        if (d) *d = m_transform.m_d;
+        if (tx) *tx = m_transform.m_tx;
+        if (ty) *ty = m_transform.m_ty;
+    }
+
+    virtual void Invert() wxOVERRIDE
+    {
+        m_transform.Invert();
+    }
+
+    virtual bool IsEqual(const wxGraphicsMatrixData *t) const wxOVERRIDE
+    {
+        const SVGTransform &other = static_cast<const SVGMatrixData*>(t)->m_transform;
+        return ((m_transform.m_a == other.m_a) && (m_transform.m_b == other.m_b) &&
+            (m_transform.m_c == other.m_c) && (m_transform.m_d == other.m_d) &&
+            (m_transform.m_tx == other.m_tx) && (m_transform.m_ty == other.m_ty));
+    }
+
+    virtual bool IsIdentity() const wxOVERRIDE
+    {
+        return m_transform.IsIdentity();
+    }
+
+    virtual void Translate(wxDouble dx, wxDouble dy) wxOVERRIDE
+    {
+        m_transform.Concat(SVGTransform(1, 0, 0, 1, dx, dy));
+    }
+
+    virtual void Scale(wxDouble xScale, wxDouble yScale) wxOVERRIDE
+    {
+        m_transform.Concat(SVGTransform(xScale, 0, 0, yScale, 0, 0));
+    }
+
+    virtual void Rotate(wxDouble angle) wxOVERRIDE
+    {
+        m_transform.Concat(SVGTransform(cos(angle), sin(angle), -sin(angle), cos(angle), 0, 0));
+    }
+
+    virtual void TransformPoint(wxDouble *x, wxDouble *y) const wxOVERRIDE
+    {
+        wxDouble px = *x;
+        *x = m_transform.m_a * px + m_transform.m_c * (*y) + m_transform.m_tx;
+        *y = m_transform.m_b * px + m_transform.m_d * (*y) + m_transform.m_ty;
+    }
+
+    virtual void TransformDistance(wxDouble *dx, wxDouble *dy) const wxOVERRIDE
+    {
+        wxDouble px = *dx;
+        *dx = m_transform.m_a * px + m_transform.m_c * (*dy);
+        *dy = m_transform.m_b * px + m_transform.m_d * (*dy);
+    }
+
+    virtual void* GetNativeMatrix() const wxOVERRIDE
+    {
+        return const_cast<SVGTransform*>(&m_transform);
+    }
+
+    const SVGTransform& GetTransform() const
+    {
+        return m_transform;
+    }
+
+private:
+    SVGTransform m_transform;
+};
+
+// Builds the path data of a path element
+class SVGPathData : public wxGraphicsPathData
+{
+public:
+    SVGPathData(wxGraphicsRenderer *renderer)
+        : wxGraphicsPathData(renderer), m_hasCurrentPoint(false),
+          m_currentX(0), m_currentY(0), m_startX(0), m_startY(0),
+          m_minX(0), m_minY(0), m_maxX(0), m_maxY(0), m_empty(true),
+          m_runColumn(0), m_runLength(0), m_runMinIndex(0), m_runMaxIndex(0)
+    {
+    }
+
+    virtual wxGraphicsObjectRefData* Clone() const wxOVERRIDE
+    {
+        return new SVGPathData(*this);
+    }
+
+    virtual void MoveToPoint(wxDouble x, wxDouble y) wxOVERRIDE
+    {
+        FlushRun();
+        m_data += 'M';
+        AppendPoint(m_data, x, y);
+        StartRun(x, y);
+        m_startX = x;
+        m_startY = y;
+    }
+
+    virtual void AddLineToPoint(wxDouble x, wxDouble y) wxOVERRIDE
+    {
+        if (!m_hasCurrentPoint)
+        {
+            MoveToPoint(x, y);
+            return;
+        }
+
+        if ((m_runLength > 0) && (floor(x) == m_runColumn))
+        {
+            if (y < m_runMin.m_y)
+            {
+                m_runMin = wxPoint2DDouble(x, y);
+                m_runMinIndex = m_runLength;
+            }
+            if (y > m_runMax.m_y)
+            {
+                m_runMax = wxPoint2DDouble(x, y);
+                m_runMaxIndex = m_runLength;
+            }
+            ++m_runLength;
+            m_currentX = x;
+            m_currentY = y;
+            ExtendBox(x, y);
+            return;
+        }
+
+        FlushRun();
+        m_data += 'L';
+        AppendPoint(m_data, x, y);
+        StartRun(x, y);
+    }
+
+    virtual void AddCurveToPoint(wxDouble cx1, wxDouble cy1,
+        wxDouble cx2, wxDouble cy2, wxDouble x, wxDouble y) wxOVERRIDE
+    {
+        if (!m_hasCurrentPoint)
+        {
+            MoveToPoint(cx1, cy1);
+        }
+        FlushRun();
+        m_data += 'C';
+        AppendPoint(m_data, cx1, cy1);
+        m_data += ' ';
+        AppendPoint(m_data, cx2, cy2);
+        m_data += ' ';
+        AppendPoint(m_data, x, y);
+        ExtendBox(cx1, cy1);
+        ExtendBox(cx2, cy2);
+        SetCurrentPoint(x, y);
+    }
+
+    virtual void AddPath(const wxGraphicsPathData *path) wxOVERRIDE
+    {
+        const SVGPathData *other = static_cast<const SVGPathData*>(path);
+        FlushRun();
+        m_data += other->GetData();
+        if (!other->m_empty)
+        {
+            ExtendBox(other->m_minX, other->m_minY);
+            ExtendBox(other->m_maxX, other->m_maxY);
+        }
+        m_hasCurrentPoint = other->m_hasCurrentPoint;
+        m_currentX = other->m_currentX;
+        m_currentY = other->m_currentY;
+        m_startX = other->m_startX;
+        m_startY = other->m_startY;
+    }
+
+    virtual void CloseSubpath() wxOVERRIDE
+    {
+        if (m_hasCurrentPoint)
+        {
+            FlushRun();
+            m_data += 'Z';
+            m_currentX = m_startX;
+            m_currentY = m_startY;
+        }
+    }
+
+    virtual void GetCurrentPoint(wxDouble *x, wxDouble *y) const wxOVERRIDE
+    {
+        *x = m_currentX;
+        *y = m_currentY;
+    }
+
+    virtual void AddArc(wxDouble x, wxDouble y, wxDouble r,
+        wxDouble startAngle, wxDouble endAngle, bool clockwise) wxOVERRIDE
+    {
+        wxDouble startX = x + r * cos(startAngle);
+        wxDouble startY = y + r * sin(startAngle);
+        if (m_hasCurrentPoint)
+        {
+            AddLineToPoint(startX, startY);
+        }
+        else
+        {
+            MoveToPoint(startX, startY);
+        }
+        FlushRun();
+
+        wxDouble sweep = clockwise ? (endAngle - startAngle) : (startAngle - endAngle);
+        if (sweep >= (2 * M_PI))
+        {
+            // A full circle needs two arcs
+            AppendArc(r, false, clockwise, x - (startX - x), y - (startY - y));
+            AppendArc(r, false, clockwise, startX, startY);
+        }
+        else
+        {
+            while (sweep < 0)
+            {
+                sweep += 2 * M_PI;
+            }
+            AppendArc(r, sweep > M_PI, clockwise, x + r * cos(endAngle),
+                y + r * sin(endAngle));
+        }
+        ExtendBox(x - r, y - r);
+        ExtendBox(x + r, y + r);
+    }
+
+    virtual void AddArcToPoint(wxDouble x1, wxDouble y1,
+        wxDouble x2, wxDouble y2, wxDouble r) wxOVERRIDE
+    {
+        if (!m_hasCurrentPoint)
+        {
+            MoveToPoint(x1, y1);
+        }
+
+        // The arc is tangent to the line from the current
+        // point to (x1, y1) and to the line from (x1, y1)
+        // to (x2, y2)
+        wxDouble v1x = m_currentX - x1;
+        wxDouble v1y = m_currentY - y1;
+        wxDouble v2x = x2 - x1;
+        wxDouble v2y = y2 - y1;
+        wxDouble length1 = sqrt(v1x * v1x + v1y * v1y);
+        wxDouble length2 = sqrt(v2x * v2x + v2y * v2y);
+        wxDouble cross = (v1x * v2y) - (v1y * v2x);
+        if ((length1 == 0) || (length2 == 0) || (cross == 0) || (r == 0))
+        {
+            AddLineToPoint(x1, y1);
+            return;
+        }
+        v1x /= length1;
+        v1y /= length1;
+        v2x /= length2;
+        v2y /= length2;
+
+        wxDouble angle = acos(v1x * v2x + v1y * v2y);
+        wxDouble distance = r / tan(angle / 2);
+        AddLineToPoint(x1 + v1x * distance, y1 + v1y * distance);
+        FlushRun();
+        AppendArc(r, false, cross < 0, x1 + v2x * distance, y1 + v2y * distance);
+    }
+
+    virtual void AddCircle(wxDouble x, wxDouble y, wxDouble r) wxOVERRIDE
+    {
+        // The points of a series are often added to the
+        // same path, only one circle is written per pixel
+        // and radius
+        CircleKey key = { (long)floor(x + 0.5), (long)floor(y + 0.5), (long)floor(r * 2 + 0.5) };
+        if (!m_circles.insert(key).second)
+        {
+            return;
+        }
+
+        FlushRun();
+        m_data += 'M';
+        AppendPoint(m_data, x + r, y);
+        m_data += 'A';
+        AppendPoint(m_data, r, r);
+        m_data += " 0 1 1 ";
+        AppendPoint(m_data, x - r, y);
+        m_data += 'A';
+        AppendPoint(m_data, r, r);
+        m_data += " 0 1 1 ";
+        AppendPoint(m_data, x + r, y);
+        m_data += 'Z';
+        ExtendBox(x - r, y - r);
+        ExtendBox(x + r, y + r);
+        SetCurrentPoint(x + r, y);
+        m_startX = x + r;
+        m_startY = y;
+    }
+
+    virtual void AddRectangle(wxDouble x, wxDouble y, wxDouble w, wxDouble h) wxOVERRIDE
+    {
+        FlushRun();
+        m_data += 'M';
+        AppendPoint(m_data, x, y);
+        m_data += 'h';
+        AppendNumber(m_data, w);
+        m_data += 'v';
+        AppendNumber(m_data, h);
+        m_data += 'h';
+        AppendNumber(m_data, -w);
+        m_data += 'Z';
+        ExtendBox(x + w, y + h);
+        SetCurrentPoint(x, y);
+        m_startX = x;
+        m_startY = y;
+    }
+
+    virtual void* GetNativePath() const wxOVERRIDE
+    {
+        return 0;
+    }
+
+    virtual void UnGetNativePath(void *WXUNUSED(p)) const wxOVERRIDE
+    {
+    }
+
+    virtual void Transform(const wxGraphicsMatrixData *matrix) wxOVERRIDE
+    {
+        // The path data isn't rewritten, the transform is
+        // written with the path element instead
+        SVGTransform transform = static_cast<const SVGMatrixData*>(matrix)->GetTransform();
+        transform.Concat(m_transform);
+        m_transform = transform;
+    }
+
+    virtual void GetBox(wxDouble *x, wxDouble *y, wxDouble *w, wxDouble *h) const wxOVERRIDE
+    {
+        *x = m_minX;
+        *y = m_minY;
+        *w = m_maxX - m_minX;
+        *h = m_maxY - m_minY;
+    }
+
+    virtual bool Contains(wxDouble x, wxDouble y,
+        wxPolygonFillMode WXUNUSED(fillStyle)) const wxOVERRIDE
+    {
+        // Only the bounding box is known
+        return (!m_empty && (x >= m_minX) && (x <= m_maxX) &&
+            (y >= m_minY) && (y <= m_maxY));
+    }
+
+    const std::string& GetData() const
+    {
+        FlushRun();
+        return m_data;
+    }
+
+    const SVGTransform& GetTransform() const
+    {
+        return m_transform;
+    }
+
+private:
+    struct CircleKey
+    {
+        long m_x;
+        long m_y;
+        long m_diameter;
+
+        bool operator<(const CircleKey &other) const
+        {
+            if (m_x != other.m_x)
+            {
+                return (m_x < other.m_x);
+            }
+            if (m_y != other.m_y)
+            {
+                return (m_y < other.m_y);
+            }
+            return (m_diameter < other.m_diameter);
+        }
+    };
+
+    void SetCurrentPoint(wxDouble x, wxDouble y)
+    {
+        m_hasCurrentPoint = true;
+        m_currentX = x;
+        m_currentY = y;
+        ExtendBox(x, y);
+    }
+
+    // Starts a run with a point that has just been
+    // written
+    void StartRun(wxDouble x, wxDouble y)
+    {
+        SetCurrentPoint(x, y);
+        m_runColumn = floor(x);
+        m_runLength = 1;
+        m_runMin = m_runMax = wxPoint2DDouble(x, y);
+        m_runMinIndex = m_runMaxIndex = 0;
+    }
+
+    // Writes the points of the run that were held back,
+    // this is the same selection as the one made by
+    // wxChartDownsampling::M4()
+    void FlushRun() const
+    {
+        if (m_runLength > 1)
+        {
+            const size_t last = m_runLength - 1;
+            size_t middle1 = m_runMinIndex;
+            size_t middle2 = m_runMaxIndex;
+            wxPoint2DDouble point1 = m_runMin;
+            wxPoint2DDouble point2 = m_runMax;
+            if (middle1 > middle2)
+            {
+                std::swap(middle1, middle2);
+                std::swap(point1, point2);
+            }
+
+            if ((middle1 != 0) && (middle1 != last))
+            {
+                m_data += 'L';
+                AppendPoint(m_data, point1.m_x, point1.m_y);
+            }
+            if ((middle2 != 0) && (middle2 != last) && (middle2 != middle1))
+            {
+                m_data += 'L';
+                AppendPoint(m_data, point2.m_x, point2.m_y);
+            }
+            m_data += 'L';
+            AppendPoint(m_data, m_currentX, m_currentY);
+        }
+        m_runLength = 0;
+    }
+
+    void AppendArc(wxDouble r, bool largeArc, bool clockwise,
+        wxDouble x, wxDouble y)
+    {
+        m_data += 'A';
+        AppendPoint(m_data, r, r);
+        m_data += largeArc ? " 0 1 " : " 0 0 ";
+        m_data += clockwise ? "1 " : "0 ";
+        AppendPoint(m_data, x, y);
+        SetCurrentPoint(x, y);
+    }
+
+    void ExtendBox(wxDouble x, wxDouble y)
+    {
+        if (m_empty)
+        {
+            m_minX = m_maxX = x;
+            m_minY = m_maxY = y;
+            m_empty = false;
+            return;
+        }
+        m_minX = std::min(m_minX, x);
+        m_minY = std::min(m_minY, y);
+        m_maxX = std::max(m_maxX, x);
+        m_maxY = std::max(m_maxY, y);
+    }
+
+private:
+    // The remaining points of a run are written when
+    // the data is read, hence mutable
+    mutable std::string m_data;
+    bool m_hasCurrentPoint;
+    wxDouble m_currentX;
+    wxDouble m_currentY;
+    wxDouble m_startX;
+    wxDouble m_startY;
+    wxDouble m_minX;
+    wxDouble m_minY;
+    wxDouble m_maxX;
+    wxDouble m_maxY;
+    bool m_empty;
+    std::set<CircleKey> m_circles;
+    SVGTransform m_transform;
+    // The consecutive lines that end in the same pixel
+    // column form a run. Only the first, lowest, highest
+    // and last points of a run are written, which draws
+    // the same pixels as all the points, so the size of
+    // the data depends on the width of the line rather
+    // than on its number of points.
+    wxDouble m_runColumn;
+    mutable size_t m_runLength;
+    wxPoint2DDouble m_runMin;
+    size_t m_runMinIndex;
+    wxPoint2DDouble m_runMax;
+    size_t m_runMaxIndex;
+};
+
+class SVGRenderer : public wxGraphicsRenderer
+{
+public:
+    virtual wxGraphicsContext* CreateContext(const wxWindowDC& WXUNUSED(dc)) wxOVERRIDE
+    {
+        return 0;
+    }
+
+    virtual wxGraphicsContext* CreateContext(const wxMemoryDC& WXUNUSED(dc)) wxOVERRIDE
+    {
+        return 0;
+    }
+
+#if wxUSE_PRINTING_ARCHITECTURE
+    virtual wxGraphicsContext* CreateContext(const wxPrinterDC& WXUNUSED(dc)) wxOVERRIDE
+    {
+        return 0;
+    }
+#endif
+
+#if defined(__WXMSW__) && wxUSE_ENH_METAFILE
+    virtual wxGraphicsContext* CreateContext(const wxEnhMetaFileDC& WXUNUSED(dc)) wxOVERRIDE
+    {
+        return 0;
+    }
+#endif
+
+    virtual wxGraphicsContext* CreateContextFromNativeContext(void* WXUNUSED(context)) wxOVERRIDE
+    {
+        return 0;
+    }
+
+    virtual wxGraphicsContext* CreateContextFromNativeWindow(void* WXUNUSED(window)) wxOVERRIDE
+    {
+        return 0;
+    }
+
+#if defined(__WXMSW__) && wxCHECK_VERSION(3, 1, 1)
+    virtual wxGraphicsContext* CreateContextFromNativeHDC(WXHDC WXUNUSED(dc)) wxOVERRIDE
+    {
+        return 0;
+    }
+#endif
+
+    virtual wxGraphicsContext* CreateContext(wxWindow* WXUNUSED(window)) wxOVERRIDE
+    {
+        return 0;
+    }
+
+    virtual wxGraphicsContext* CreateContextFromImage(wxImage& WXUNUSED(image)) wxOVERRIDE
+    {
+        return 0;
+    }
+
+    virtual wxGraphicsContext* CreateMeasuringContext() wxOVERRIDE
+    {
+        return wxGraphicsRenderer::GetDefaultRenderer()->CreateMeasuringContext();
+    }
+
+    virtual wxGraphicsPath CreatePath() wxOVERRIDE
+    {
+        wxGraphicsPath path;
+        path.SetRefData(new SVGPathData(this));
+        return path;
+    }
+
+    virtual wxGraphicsMatrix CreateMatrix(wxDouble a, wxDouble b, wxDouble c,
+        wxDouble d, wxDouble tx, wxDouble ty) wxOVERRIDE
+    {
+        SVGMatrixData *data = new SVGMatrixData(this);
+        data->Set(a, b, c, d, tx, ty);
+        wxGraphicsMatrix matrix;
+        matrix.SetRefData(data);
+        return matrix;
+    }
+
+#if wxCHECK_VERSION(3, 1, 1)
+    virtual wxGraphicsPen CreatePen(const wxGraphicsPenInfo &info) wxOVERRIDE
+    {
+        wxGraphicsPen pen;
+        pen.SetRefData(new SVGPenData(this, info.GetColour(), info.GetWidth(),
+            info.GetStyle(), info.GetCap(), info.GetJoin()));
+        return pen;
+    }
+#else
+    virtual wxGraphicsPen CreatePen(const wxPen &pen) wxOVERRIDE
+    {
+        if (!pen.IsOk())
+        {
+            return wxNullGraphicsPen;
+        }
+        wxGraphicsPen graphicsPen;
+        graphicsPen.SetRefData(new SVGPenData(this, pen.GetColour(), pen.GetWidth(),
+            pen.GetStyle(), pen.GetCap(), pen.GetJoin()));
+        return graphicsPen;
+    }
+#endif
+
+    virtual wxGraphicsBrush CreateBrush(const wxBrush &brush) wxOVERRIDE
+    {
+        if (!brush.IsOk() || brush.IsTransparent())
+        {
+            return wxNullGraphicsBrush;
+        }
+        return CreateSolidBrush(brush.GetColour());
+    }
+
+    // The gradients are drawn with their first color
+#if wxCHECK_VERSION(3, 1, 3)
+    virtual wxGraphicsBrush CreateLinearGradientBrush(wxDouble WXUNUSED(x1),
+        wxDouble WXUNUSED(y1), wxDouble WXUNUSED(x2), wxDouble WXUNUSED(y2),
+        const wxGraphicsGradientStops &stops,
+        const wxGraphicsMatrix& WXUNUSED(matrix)) wxOVERRIDE
+    {
+        return CreateSolidBrush(stops.GetStartColour());
+    }
+
+    virtual wxGraphicsBrush CreateRadialGradientBrush(wxDouble WXUNUSED(startX),
+        wxDouble WXUNUSED(startY), wxDouble WXUNUSED(endX), wxDouble WXUNUSED(endY),
+        wxDouble WXUNUSED(radius), const wxGraphicsGradientStops &stops,
+        const wxGraphicsMatrix& WXUNUSED(matrix)) wxOVERRIDE
+    {
+        return CreateSolidBrush(stops.GetStartColour());
+    }
+#else
+    virtual wxGraphicsBrush CreateLinearGradientBrush(wxDouble WXUNUSED(x1),
+        wxDouble WXUNUSED(y1), wxDouble WXUNUSED(x2), wxDouble WXUNUSED(y2),
+        const wxGraphicsGradientStops &stops) wxOVERRIDE
+    {
+        return CreateSolidBrush(stops.GetStartColour());
+    }
+
+    virtual wxGraphicsBrush CreateRadialGradientBrush(wxDouble WXUNUSED(xo),
+        wxDouble WXUNUSED(yo), wxDouble WXUNUSED(xc), wxDouble WXUNUSED(yc),
+        wxDouble WXUNUSED(radius), const wxGraphicsGradientStops &stops) wxOVERRIDE
+    {
+        return CreateSolidBrush(stops.GetStartColour());
+    }
+#endif
+
+    virtual wxGraphicsFont CreateFont(const wxFont &font, const wxColour &col) wxOVERRIDE
+    {
+        if (!font.IsOk())
+        {
+            return wxNullGraphicsFont;
+        }
+        wxGraphicsFont graphicsFont;
+        graphicsFont.SetRefData(new SVGFontData(this, font, col));
+        return graphicsFont;
+    }
+
+    virtual wxGraphicsFont CreateFont(double sizeInPixels, const wxString &facename,
+        int flags, const wxColour &col) wxOVERRIDE
+    {
+        wxFont font(wxSize(0, (int)floor(sizeInPixels + 0.5)), wxFONTFAMILY_DEFAULT,
+            (flags & wxFONTFLAG_ITALIC) ? wxFONTSTYLE_ITALIC : wxFONTSTYLE_NORMAL,
+            (flags & wxFONTFLAG_BOLD) ? wxFONTWEIGHT_BOLD : wxFONTWEIGHT_NORMAL,
+            false, facename);
+        return CreateFont(font, col);
+    }
+
+#if wxCHECK_VERSION(3, 1, 3)
+    virtual wxGraphicsFont CreateFontAtDPI(const wxFont &font,
+        const wxRealPoint& WXUNUSED(dpi), const wxColour &col) wxOVERRIDE
+    {
+        return CreateFont(font, col);
+    }
+#endif
+
+    virtual wxGraphicsBitmap CreateBitmap(const wxBitmap &bitmap) wxOVERRIDE
+    {
+        if (!bitmap.IsOk())
+        {
+            return wxNullGraphicsBitmap;
+        }
+        return CreateBitmapFromImage(bitmap.ConvertToImage());
+    }
+
+    virtual wxGraphicsBitmap CreateBitmapFromImage(const wxImage &image) wxOVERRIDE
+    {
+        wxGraphicsBitmap bitmap;
+        bitmap.SetRefData(new SVGBitmapData(this, image));
+        return bitmap;
+    }
+
+    virtual wxImage CreateImageFromBitmap(const wxGraphicsBitmap &bitmap) wxOVERRIDE
+    {
+        const SVGBitmapData *data = static_cast<const SVGBitmapData*>(bitmap.GetRefData());
+        return data ? data->GetImage() : wxImage();
+    }
+
+    virtual wxGraphicsBitmap CreateBitmapFromNativeBitmap(void* WXUNUSED(bitmap)) wxOVERRIDE
+    {
+        return wxNullGraphicsBitmap;
+    }
+
+    virtual wxGraphicsBitmap CreateSubBitmap(const wxGraphicsBitmap &bitmap,
+        wxDouble x, wxDouble y, wxDouble w, wxDouble h) wxOVERRIDE
+    {
+        const SVGBitmapData *data = static_cast<const SVGBitmapData*>(bitmap.GetRefData());
+        if (!data)
+        {
+            return wxNullGraphicsBitmap;
+        }
+        return CreateBitmapFromImage(data->GetImage().GetSubImage(wxRect((int)x, (int)y, (int)w, (int)h)));
+    }
+
+#if wxCHECK_VERSION(3, 1, 0)
+    virtual wxString GetName() const wxOVERRIDE
+    {
+        return "svg";
+    }
+
+    virtual void GetVersion(int *major, int *minor, int *micro) const wxOVERRIDE
+    {
+        if (major) *major = 1;
+        if (minor) *minor = 0;
+        if (micro) *micro = 0;
+    }
+#endif
+
+private:
+    wxGraphicsBrush CreateSolidBrush(const wxColour &colour)
+    {
+        wxGraphicsBrush brush;
+        brush.SetRefData(new SVGBrushData(this, colour));
+        return brush;
+    }
+};
+
+// Created before main() so it can be shared by the
+// threads, like the renderers of wxWidgets it is never
+// destroyed while objects may refer to it
+static SVGRenderer svgRenderer;
+
+// A graphics context that writes what is drawn on it
+// to an SVG document
+class SVGContext : public wxGraphicsContext
+{
+public:
+    SVGContext(SVGDocument &document, const wxSize &size)
+        : wxGraphicsContext(&svgRenderer), m_document(document),
+          m_size(size), m_measuringContext(svgRenderer.CreateMeasuringContext())
+    {
+    }
+
+    virtual ~SVGContext()
+    {
+        CloseGroups(0);
+        delete m_measuringContext;
+    }
+
+    virtual void Clip(const wxRegion &region) wxOVERRIDE
+    {
+        // Only the bounding box of the region is used
+        wxRect box = region.GetBox();
+        Clip(box.x, box.y, box.width, box.height);
+    }
+
+    virtual void Clip(wxDouble x, wxDouble y, wxDouble w, wxDouble h) wxOVERRIDE
+    {
+        std::string shape("<rect x=\"");
+        AppendNumber(shape, x);
+        shape += "\" y=\"";
+        AppendNumber(shape, y);
+        shape += "\" width=\"";
+        AppendNumber(shape, w);
+        shape += "\" height=\"";
+        AppendNumber(shape, h);
+        shape += '"';
+        m_transform.Append(shape);
+        shape += "/>";
+
+        std::string id = m_document.AddClipPath(shape);
+        m_document.Write("<g clip-path=\"url(#" + id + ")\">\n");
+        m_groups.push_back(ClipGroup);
+    }
+
+    virtual void ResetClip() wxOVERRIDE
+    {
+        // The clipping set before the last PushState()
+        // can't be removed
+        size_t start = m_states.empty() ? 0 : m_states.back().m_numberOfGroups;
+        while ((m_groups.size() > start) && (m_groups.back() == ClipGroup))
+        {
+            m_document.Write("</g>\n");
+            m_groups.pop_back();
+        }
+    }
+
+#if wxCHECK_VERSION(3, 1, 1)
+    virtual void GetClipBox(wxDouble *x, wxDouble *y, wxDouble *w, wxDouble *h) wxOVERRIDE
+    {
+        if (x) *x = 0;
+        if (y) *y = 0;
+        if (w) *w = m_size.GetWidth();
+        if (h) *h = m_size.GetHeight();
+    }
+#endif
+
+    virtual void* GetNativeContext() wxOVERRIDE
+    {
+        return 0;
+    }
+
+    virtual bool SetAntialiasMode(wxAntialiasMode antialias) wxOVERRIDE
+    {
+        m_antialias = antialias;
+        return true;
+    }
+
+    virtual bool SetInterpolationQuality(wxInterpolationQuality interpolation) wxOVERRIDE
+    {
+        m_interpolation = interpolation;
+        return true;
+    }
+
+    virtual bool SetCompositionMode(wxCompositionMode op) wxOVERRIDE
+    {
+        m_composition = op;
+        return true;
+    }
+
+    virtual void BeginLayer(wxDouble opacity) wxOVERRIDE
+    {
+        std::string group("<g opacity=\"");
+        AppendNumber(group, opacity);
+        group += "\">\n";
+        m_document.Write(group);
+        m_groups.push_back(LayerGroup);
+    }
+
+    virtual void EndLayer() wxOVERRIDE
+    {
+        while (!m_groups.empty())
+        {
+            int group = m_groups.back();
+            m_document.Write("</g>\n");
+            m_groups.pop_back();
+            if (group == LayerGroup)
+            {
+                break;
+            }
+        }
+    }
+
+    virtual void Translate(wxDouble dx, wxDouble dy) wxOVERRIDE
+    {
+        m_transform.Concat(SVGTransform(1, 0, 0, 1, dx, dy));
+    }
+
+    virtual void Scale(wxDouble xScale, wxDouble yScale) wxOVERRIDE
+    {
+        m_transform.Concat(SVGTransform(xScale, 0, 0, yScale, 0, 0));
+    }
+
+    virtual void Rotate(wxDouble angle) wxOVERRIDE
+    {
+        m_transform.Concat(SVGTransform(cos(angle), sin(angle), -sin(angle), cos(angle), 0, 0));
+    }
+
+    virtual void ConcatTransform(const wxGraphicsMatrix &matrix) wxOVERRIDE
+    {
+        SVGTransform transform;
+        matrix.Get(&transform.m_a, &transform.m_b, &transform.m_c,
+            &transform.m_d, &transform.m_tx, &transform.m_ty);
+        m_transform.Concat(transform);
+    }
+
+    virtual void SetTransform(const wxGraphicsMatrix &matrix) wxOVERRIDE
+    {
+        matrix.Get(&m_transform.m_a, &m_transform.m_b, &m_transform.m_c,
+            &m_transform.m_d, &m_transform.m_tx, &m_transform.m_ty);
+    }
+
+    virtual wxGraphicsMatrix GetTransform() const wxOVERRIDE
+    {
+        return svgRenderer.CreateMatrix(m_transform.m_a, m_transform.m_b,
+            m_transform.m_c, m_transform.m_d, m_transform.m_tx, m_transform.m_ty);
+    }
+
+    virtual void StrokePath(const wxGraphicsPath &path) wxOVERRIDE
+    {
+        if (!m_pen.IsNull() && (m_pen.GetRenderer() == &svgRenderer))
+        {
+            WritePath(path, static_cast<const SVGPenData*>(m_pen.GetRefData())->GetStyle());
+        }
+    }
+
+    virtual void FillPath(const wxGraphicsPath &path, wxPolygonFillMode fillStyle) wxOVERRIDE
+    {
+        if (!m_brush.IsNull() && (m_brush.GetRenderer() == &svgRenderer))
+        {
+            const std::string &style = static_cast<const SVGBrushData*>(m_brush.GetRefData())->GetStyle();
+            if (!style.empty())
+            {
+                WritePath(path, style + ((fillStyle == wxWINDING_RULE) ?
+                    ";fill-rule:nonzero" : ";fill-rule:evenodd"));
+            }
+        }
+    }
+
+    virtual void DrawBitmap(const wxGraphicsBitmap &bmp, wxDouble x, wxDouble y,
+        wxDouble w, wxDouble h) wxOVERRIDE
+    {
+        if (bmp.IsNull() || (bmp.GetRenderer() != &svgRenderer))
+        {
+            return;
+        }
+
+        const SVGBitmapData *data = static_cast<const SVGBitmapData*>(bmp.GetRefData());
+        const std::string &id = data->GetId(m_document);
+        if (id.empty() || (data->GetImage().GetWidth() == 0) || (data->GetImage().GetHeight() == 0))
+        {
+            return;
+        }
+
+        SVGTransform transform(m_transform);
+        transform.Concat(SVGTransform(w / data->GetImage().GetWidth(), 0, 0,
+            h / data->GetImage().GetHeight(), x, y));
+        std::string element("<use xlink:href=\"#");
+        element += id;
+        element += '"';
+        if ((transform.m_a == 1) && (transform.m_b == 0) &&
+            (transform.m_c == 0) && (transform.m_d == 1))
+        {
+            element += " x=\"";
+            AppendNumber(element, transform.m_tx);
+            element += "\" y=\"";
+            AppendNumber(element, transform.m_ty);
+            element += '"';
+        }
+        else
+        {
+            transform.Append(element);
+        }
+        element += "/>\n";
+        m_document.Write(element);
+    }
+
+    virtual void DrawBitmap(const wxBitmap &bmp, wxDouble x, wxDouble y,
+        wxDouble w, wxDouble h) wxOVERRIDE
+    {
+        DrawBitmap(svgRenderer.CreateBitmap(bmp), x, y, w, h);
+    }
+
+    virtual void DrawIcon(const wxIcon &icon, wxDouble x, wxDouble y,
+        wxDouble w, wxDouble h) wxOVERRIDE
+    {
+        wxBitmap bitmap;
+        bitmap.CopyFromIcon(icon);
+        DrawBitmap(bitmap, x, y, w, h);
+    }
+
+    virtual void GetTextExtent(const wxString &text, wxDouble *width,
+        wxDouble *height, wxDouble *descent,
+        wxDouble *externalLeading) const wxOVERRIDE
+    {
+        const SVGFontData *font = GetFontData();
+        if (!font || !m_measuringContext)
+        {
+            if (width) *width = 0;
+            if (height) *height = 0;
+            if (descent) *descent = 0;
+            if (externalLeading) *externalLeading = 0;
+            return;
+        }
+
+        m_measuringContext->SetFont(font->GetFont(), font->GetColour());
+        m_measuringContext->GetTextExtent(text, width, height, descent, externalLeading);
+    }
+
+    virtual void GetPartialTextExtents(const wxString &text,
+        wxArrayDouble &widths) const wxOVERRIDE
+    {
+        const SVGFontData *font = GetFontData();
+        if (!font || !m_measuringContext)
+        {
+            widths.assign(text.length(), 0);
+            return;
+        }
+
+        m_measuringContext->SetFont(font->GetFont(), font->GetColour());
+        m_measuringContext->GetPartialTextExtents(text, widths);
+    }
+
+    virtual void PushState() wxOVERRIDE
+    {
+        State state;
+        state.m_transform = m_transform;
+        state.m_numberOfGroups = m_groups.size();
+        m_states.push_back(state);
+    }
+
+    virtual void PopState() wxOVERRIDE
+    {
+        if (m_states.empty())
+        {
+            return;
+        }
+
+        CloseGroups(m_states.back().m_numberOfGroups);
+        m_transform = m_states.back().m_transform;
+        m_states.pop_back();
+    }
+
+protected:
+    virtual void DoDrawText(const wxString &str, wxDouble x, wxDouble y) wxOVERRIDE
+    {
+        const SVGFontData *font = GetFontData();
+        if (!font || str.empty())
+        {
+            return;
+        }
+
+        // SVG positions the text by its baseline
+        wxDouble width = 0;
+        wxDouble height = 0;
+        wxDouble descent = 0;
+        wxDouble externalLeading = 0;
+        GetTextExtent(str, &width, &height, &descent, &externalLeading);
+
+        std::string element("<text class=\"");
+        element += m_document.GetClass(font->GetStyle());
+        element += "\" x=\"";
+        AppendNumber(element, x);
+        element += "\" y=\"";
+        AppendNumber(element, y + height - descent);
+        element += '"';
+        m_transform.Append(element);
+        element += " xml:space=\"preserve\">";
+        AppendEscaped(element, str);
+        element += "</text>\n";
+        m_document.Write(element);
+    }
+
+private:
+    enum
+    {
+        ClipGroup,
+        LayerGroup
+    };
+
+    struct State
+    {
+        SVGTransform m_transform;
+        size_t m_numberOfGroups;
+    };
+
+    const SVGFontData* GetFontData() const
+    {
+        if (m_font.IsNull() || (m_font.GetRenderer() != &svgRenderer))
+        {
+            return 0;
+        }
+        return static_cast<const SVGFontData*>(m_font.GetRefData());
+    }
+
+    void WritePath(const wxGraphicsPath &path, const std::string &style)
+    {
+        if (style.empty() || path.IsNull() || (path.GetRenderer() != &svgRenderer))
+        {
+            return;
+        }
+
+        const SVGPathData *data = static_cast<const SVGPathData*>(path.GetRefData());
+        std::string element("<path class=\"");
+        element += m_document.GetClass(style);
+        element += "\" d=\"";
+        element += data->GetData();
+        element += '"';
+        SVGTransform transform(m_transform);
+        transform.Concat(data->GetTransform());
+        transform.Append(element);
+        element += "/>\n";
+        m_document.Write(element);
+    }
+
+    void CloseGroups(size_t numberOfGroups)
+    {
+        while (m_groups.size() > numberOfGroups)
+        {
+            m_document.Write("</g>\n");
+            m_groups.pop_back();
+        }
+    }
+
+private:
+    SVGDocument &m_document;
+    wxSize m_size;
+    wxGraphicsContext *m_measuringContext;
+    SVGTransform m_transform;
+    // The kind of each <g> element that is open
+    wxVector<int> m_groups;
+    wxVector<State> m_states;
+};
+
+wxChartSVGExporter::wxChartSVGExporter()
+{
+}
+
+bool wxChartSVGExporter::Save(wxChart &chart,
+                              const wxSize &size,
+                              const wxString &filename)
+{
+    wxFileOutputStream file(filename);
+    if (!file.IsOk())
+    {
+        return false;
+    }
+    wxBufferedOutputStream stream(file);
+    return (Save(chart, size, stream) && stream.Close() && file.Close());
+}
+
+bool wxChartSVGExporter::Save(wxChart &chart,
+                              const wxSize &size,
+                              wxOutputStream &stream)
+{
+    if ((size.GetWidth() <= 0) || (size.GetHeight() <= 0))
+    {
+        return false;
+    }
+
+    wxSize previousSize = chart.GetSize();
+    if (size != previousSize)
+    {
+        chart.SetSize(size);
+    }
+    chart.ForceSynchronousFit();
+
+    SVGDocument document(stream);
+    std::string header("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<svg xmlns=\"http://www.w3.org/2000/svg\" "
+        "xmlns:xlink=\"http://www.w3.org/1999/xlink\" width=\"");
+    AppendNumber(header, size.GetWidth());
+    header += "\" height=\"";
+    AppendNumber(header, size.GetHeight());
+    header += "\" viewBox=\"0 0 ";
+    AppendPoint(header, size.GetWidth(), size.GetHeight());
+    header += "\">\n<rect width=\"100%\" height=\"100%\" fill=\"#ffffff\"/>\n";
+    document.Write(header);
+    {
+        SVGContext gc(document, size);
+        chart.DrawChart(gc);
+    }
+    document.Write("</svg>\n");
+
+    if ((size != previousSize) && (previousSize != wxDefaultSize))
+    {
+        chart.SetSize(previousSize);
+    }
+
+    return stream.IsOk();
+}
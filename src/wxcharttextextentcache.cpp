@@ -0,0 +1,179 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxcharttextextentcache.h"
+#include <wx/colour.h>
+#include <sstream>
+
+wxChartTextExtentCache::Entry::Entry(const wxString &key,
+                                     wxDouble width,
+                                     wxDouble height)
+    : m_key(key), m_width(width), m_height(height)
+{
+}
+
+wxChartTextExtentCache::wxChartTextExtentCache(size_t capacity)
+    : m_capacity(capacity), m_hits(0), m_misses(0),
+    m_contextRenderer(0), m_contextDPIX(0), m_contextDPIY(0)
+{
+}
+
+// Constructed before main() rather than on first use, a
+// function-local static isn't initialized in a thread-safe
+// way by all the supported compilers and the cache can
+// first be used from worker threads
+static wxChartTextExtentCache sharedCache;
+
+wxChartTextExtentCache& wxChartTextExtentCache::Get()
+{
+    return sharedCache;
+}
+
+void wxChartTextExtentCache::GetTextSize(wxGraphicsContext &gc,
+                                         const wxFont &font,
+                                         const wxString &string,
+                                         wxDouble &width,
+                                         wxDouble &height)
+{
+    DoGetTextSize(gc, font, font.GetNativeFontInfoDesc(), string,
+        width, height);
+}
+
+void wxChartTextExtentCache::GetTextSize(wxGraphicsContext &gc,
+                                         const wxChartFontOptions &fontOptions,
+                                         const wxString &string,
+                                         wxDouble &width,
+                                         wxDouble &height)
+{
+    DoGetTextSize(gc, fontOptions.GetFont(),
+        fontOptions.GetFontDescription(), string, width, height);
+}
+
+void wxChartTextExtentCache::DoGetTextSize(wxGraphicsContext &gc,
+                                           const wxFont &font,
+                                           const wxString &fontDescription,
+                                           const wxString &string,
+                                           wxDouble &width,
+                                           wxDouble &height)
+{
+    wxString key;
+
+    {
+        wxCriticalSectionLocker locker(m_lock);
+
+        // Neither the context part nor the font description
+        // can contain this separator so different contexts,
+        // fonts and strings can't give the same key
+        key = GetContextKey(gc);
+        key += '\x1F';
+        key += fontDescription;
+        key += '\x1F';
+        key += string;
+
+        EntryMap::iterator it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            width = it->second->m_width;
+            height = it->second->m_height;
+            ++m_hits;
+            return;
+        }
+        ++m_misses;
+    }
+
+    // The lock isn't held while measuring, at worst two
+    // threads measure the same string
+    wxDouble descent;
+    wxDouble externalLeading;
+    gc.SetFont(font, *wxBLACK);
+    gc.GetTextExtent(string, &width, &height, &descent, &externalLeading);
+
+    wxCriticalSectionLocker locker(m_lock);
+    if ((m_capacity != 0) && (m_index.find(key) == m_index.end()))
+    {
+        m_entries.push_front(Entry(key, width, height));
+        m_index[key] = m_entries.begin();
+        Trim();
+    }
+}
+
+size_t wxChartTextExtentCache::GetCapacity() const
+{
+    wxCriticalSectionLocker locker(m_lock);
+    return m_capacity;
+}
+
+void wxChartTextExtentCache::SetCapacity(size_t capacity)
+{
+    wxCriticalSectionLocker locker(m_lock);
+    m_capacity = capacity;
+    Trim();
+}
+
+size_t wxChartTextExtentCache::GetHits() const
+{
+    wxCriticalSectionLocker locker(m_lock);
+    return m_hits;
+}
+
+size_t wxChartTextExtentCache::GetMisses() const
+{
+    wxCriticalSectionLocker locker(m_lock);
+    return m_misses;
+}
+
+void wxChartTextExtentCache::Clear()
+{
+    wxCriticalSectionLocker locker(m_lock);
+    m_entries.clear();
+    m_index.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+const wxString& wxChartTextExtentCache::GetContextKey(wxGraphicsContext &gc)
+{
+    wxDouble dpiX = 0;
+    wxDouble dpiY = 0;
+    gc.GetDPI(&dpiX, &dpiY);
+    if (m_contextKey.empty() || (gc.GetRenderer() != m_contextRenderer) ||
+        (dpiX != m_contextDPIX) || (dpiY != m_contextDPIY))
+    {
+        std::stringstream contextKey;
+        contextKey << gc.GetRenderer() << ' ' << dpiX << ' ' << dpiY;
+        m_contextRenderer = gc.GetRenderer();
+        m_contextDPIX = dpiX;
+        m_contextDPIY = dpiY;
+        m_contextKey = contextKey.str();
+    }
+    return m_contextKey;
+}
+
+void wxChartTextExtentCache::Trim()
+{
+    while (m_entries.size() > m_capacity)
+    {
+        m_index.erase(m_entries.back().m_key);
+        m_entries.pop_back();
+    }
+}
@@ -0,0 +1,205 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartthreadpool.h"
+#include <algorithm>
+
+wxChartThreadPool::Task::~Task()
+{
+}
+
+wxChartThreadPool::Loop::~Loop()
+{
+}
+
+// Runs one chunk of a loop and counts it as done so the
+// thread running the loop doesn't have to wait for the
+// tasks of other threads
+class wxChartThreadPool::LoopTask : public Task
+{
+public:
+    LoopTask(wxChartThreadPool &pool, Loop &loop, size_t begin,
+        size_t end, size_t &remainingChunks)
+        : m_pool(pool), m_loop(loop), m_begin(begin), m_end(end),
+        m_remainingChunks(remainingChunks)
+    {
+    }
+
+    virtual void Run() wxOVERRIDE
+    {
+        m_loop.Run(m_begin, m_end);
+
+        wxMutexLocker locker(m_pool.m_mutex);
+        if (--m_remainingChunks == 0)
+        {
+            m_pool.m_tasksCompleted.Broadcast();
+        }
+    }
+
+private:
+    wxChartThreadPool &m_pool;
+    Loop &m_loop;
+    size_t m_begin;
+    size_t m_end;
+    size_t &m_remainingChunks;
+};
+
+// The number of iterations of a loop run by a task, large
+// enough for the cost of a task to be negligible
+static const size_t loopChunkSize = 4096;
+
+wxChartThreadPool::Worker::Worker(wxChartThreadPool &pool)
+    : wxThread(wxTHREAD_JOINABLE), m_pool(pool)
+{
+}
+
+wxThread::ExitCode wxChartThreadPool::Worker::Entry()
+{
+    Task *task = 0;
+    while ((task = m_pool.TakeTask()) != 0)
+    {
+        task->Run();
+        m_pool.CompleteTask(task);
+    }
+    return 0;
+}
+
+wxChartThreadPool::wxChartThreadPool(unsigned int numberOfThreads)
+    : m_taskAvailable(m_mutex), m_tasksCompleted(m_mutex),
+      m_pendingTasks(0), m_stopping(false)
+{
+    if (numberOfThreads == 0)
+    {
+        int count = wxThread::GetCPUCount();
+        numberOfThreads = (count > 0) ? count : 1;
+    }
+
+    for (unsigned int i = 0; i < numberOfThreads; ++i)
+    {
+        Worker *worker = new Worker(*this);
+        if (worker->Run() != wxTHREAD_NO_ERROR)
+        {
+            delete worker;
+            break;
+        }
+        m_workers.push_back(worker);
+    }
+}
+
+wxChartThreadPool::~wxChartThreadPool()
+{
+    Wait();
+
+    {
+        wxMutexLocker locker(m_mutex);
+        m_stopping = true;
+        m_taskAvailable.Broadcast();
+    }
+
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        m_workers[i]->Wait();
+        delete m_workers[i];
+    }
+}
+
+unsigned int wxChartThreadPool::GetNumberOfThreads() const
+{
+    return m_workers.size();
+}
+
+void wxChartThreadPool::Submit(Task *task)
+{
+    if (m_workers.empty())
+    {
+        // No thread could be started, run the task
+        // on the calling thread instead
+        task->Run();
+        delete task;
+        return;
+    }
+
+    wxMutexLocker locker(m_mutex);
+    m_tasks.push_back(task);
+    ++m_pendingTasks;
+    m_taskAvailable.Signal();
+}
+
+void wxChartThreadPool::Wait()
+{
+    wxMutexLocker locker(m_mutex);
+    while (m_pendingTasks != 0)
+    {
+        m_tasksCompleted.Wait();
+    }
+}
+
+void wxChartThreadPool::RunLoop(Loop &loop,
+                                size_t count)
+{
+    // The first chunk is run on the calling thread
+    // while the others are taken by the workers
+    size_t firstChunkEnd = std::min(count, loopChunkSize);
+    size_t remainingChunks = (count - firstChunkEnd + loopChunkSize - 1) / loopChunkSize;
+    for (size_t begin = firstChunkEnd; begin < count; begin += loopChunkSize)
+    {
+        Submit(new LoopTask(*this, loop, begin,
+            std::min(count, begin + loopChunkSize), remainingChunks));
+    }
+    loop.Run(0, firstChunkEnd);
+
+    // Other threads may be using the pool at the same
+    // time, only the chunks of this loop are waited for
+    wxMutexLocker locker(m_mutex);
+    while (remainingChunks != 0)
+    {
+        m_tasksCompleted.Wait();
+    }
+}
+
+wxChartThreadPool::Task* wxChartThreadPool::TakeTask()
+{
+    wxMutexLocker locker(m_mutex);
+    while (m_tasks.empty() && !m_stopping)
+    {
+        m_taskAvailable.Wait();
+    }
+    if (m_tasks.empty())
+    {
+        return 0;
+    }
+
+    Task *task = m_tasks.front();
+    m_tasks.pop_front();
+    return task;
+}
+
+void wxChartThreadPool::CompleteTask(Task *task)
+{
+    delete task;
+
+    wxMutexLocker locker(m_mutex);
+    if (--m_pendingTasks == 0)
+    {
+        m_tasksCompleted.Broadcast();
+    }
+}
@@ -0,0 +1,165 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxcharttiledexporter.h"
+#include "wxchartpngwriter.h"
+#include "wxchartthreadpool.h"
+#include <wx/wfstream.h>
+#include <algorithm>
+#include <cstring>
+
+// Hands a band of rows to the PNG writer
+class wxChartTiledExporter::EncodeTask : public wxChartThreadPool::Task
+{
+public:
+    EncodeTask(wxChartPNGWriter &writer, const unsigned char *band,
+        size_t stride, size_t numberOfRows)
+        : m_writer(writer), m_band(band), m_stride(stride),
+          m_numberOfRows(numberOfRows)
+    {
+    }
+
+    virtual void Run() wxOVERRIDE
+    {
+        m_writer.WriteRows(m_band, m_stride, m_numberOfRows);
+    }
+
+private:
+    wxChartPNGWriter &m_writer;
+    const unsigned char *m_band;
+    size_t m_stride;
+    size_t m_numberOfRows;
+};
+
+wxChartTiledExporter::wxChartTiledExporter(const wxSize &tileSize)
+    : m_tileSize(tileSize)
+{
+}
+
+bool wxChartTiledExporter::Save(wxChart &chart,
+                                const wxSize &size,
+                                const wxString &filename)
+{
+    wxFileOutputStream stream(filename);
+    if (!stream.IsOk())
+    {
+        return false;
+    }
+    return (Save(chart, size, stream) && stream.Close());
+}
+
+bool wxChartTiledExporter::Save(wxChart &chart,
+                                const wxSize &size,
+                                wxOutputStream &stream)
+{
+    if ((size.GetWidth() <= 0) || (size.GetHeight() <= 0) ||
+        (m_tileSize.GetWidth() <= 0) || (m_tileSize.GetHeight() <= 0))
+    {
+        return false;
+    }
+
+    wxImage tile(m_tileSize, false);
+    if (!tile.IsOk())
+    {
+        return false;
+    }
+
+    wxSize previousSize = chart.GetSize();
+    if (size != previousSize)
+    {
+        chart.SetSize(size);
+    }
+    chart.ForceSynchronousFit();
+
+    // While one band is being encoded the next one is
+    // rendered into the other buffer
+    const size_t stride = 3 * size.GetWidth();
+    wxVector<unsigned char> bands[2];
+    bands[0].resize(stride * m_tileSize.GetHeight());
+    bands[1].resize(stride * m_tileSize.GetHeight());
+
+    bool success = true;
+    wxChartPNGWriter writer(stream, size);
+    {
+        wxChartThreadPool encoder(1);
+        for (int top = 0, i = 0; top < size.GetHeight(); top += m_tileSize.GetHeight(), ++i)
+        {
+            int numberOfRows = std::min(m_tileSize.GetHeight(), size.GetHeight() - top);
+            unsigned char *band = &bands[i % 2][0];
+            if (!RenderBand(chart, top, numberOfRows, tile, band, stride))
+            {
+                success = false;
+                break;
+            }
+
+            encoder.Wait();
+            encoder.Submit(new EncodeTask(writer, band, stride, numberOfRows));
+        }
+    }
+    success = (writer.Close() && success);
+
+    if ((size != previousSize) && (previousSize != wxDefaultSize))
+    {
+        chart.SetSize(previousSize);
+    }
+
+    return success;
+}
+
+bool wxChartTiledExporter::RenderBand(wxChart &chart,
+                                      int top,
+                                      int numberOfRows,
+                                      wxImage &tile,
+                                      unsigned char *band,
+                                      size_t stride)
+{
+    const int width = stride / 3;
+    const size_t tileStride = 3 * m_tileSize.GetWidth();
+    for (int left = 0; left < width; left += m_tileSize.GetWidth())
+    {
+        int numberOfColumns = std::min(m_tileSize.GetWidth(), width - left);
+
+        tile.SetRGB(wxRect(m_tileSize), 255, 255, 255);
+        wxGraphicsContext* gc = wxGraphicsContext::Create(tile);
+        if (!gc)
+        {
+            return false;
+        }
+        // The whole chart is drawn on every tile, the
+        // clipping discards what falls outside of it
+        gc->Clip(0, 0, numberOfColumns, numberOfRows);
+        gc->Translate(-left, -top);
+        chart.DrawChart(*gc);
+        // The image is only updated when the context
+        // is destroyed
+        delete gc;
+
+        const unsigned char *data = tile.GetData();
+        for (int y = 0; y < numberOfRows; ++y)
+        {
+            memcpy(band + (y * stride) + (3 * left), data + (y * tileStride),
+                3 * numberOfColumns);
+        }
+    }
+
+    return true;
+}
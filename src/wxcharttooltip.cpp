@@ -48,15 +48,29 @@ wxChartTooltip::wxChartTooltip(const wxPoint2DDouble &position,
 {
 }
 
+wxChartTooltip::wxChartTooltip(const wxPoint2DDouble &position,
+							   const wxString &text,
+							   const wxChartTooltipOptions &options)
+	: m_options(options), m_position(position),
+	m_provider(new wxChartTooltipProviderStatic("", text, *wxBLACK))
+{
+}
+
 void wxChartTooltip::Draw(wxGraphicsContext &gc)
+{
+    wxChartGraphicsCache cache;
+    Draw(gc, cache);
+}
+
+void wxChartTooltip::Draw(wxGraphicsContext &gc,
+                          wxChartGraphicsCache &cache)
 {
 	wxString text = m_provider->GetTooltipText();
 
-	wxFont font(wxSize(0, m_options.GetFontSize()),
-		m_options.GetFontFamily(), m_options.GetFontStyle(), wxFONTWEIGHT_NORMAL);
+	const wxChartFontOptions &fontOptions = m_options.GetFontOptions();
 	wxDouble tooltipWidth;
 	wxDouble tooltipHeight;
-	wxChartUtilities::GetTextSize(gc, font, text, tooltipWidth, tooltipHeight);
+	wxChartUtilities::GetTextSize(gc, fontOptions, text, tooltipWidth, tooltipHeight);
 	tooltipWidth += 2 * m_options.GetHorizontalPadding();
 	tooltipHeight += 2 * m_options.GetVerticalPadding();
 
@@ -66,9 +80,9 @@ void wxChartTooltip::Draw(wxGraphicsContext &gc)
 
 
     wxChartBackground background(m_options.GetBackgroundOptions());
-    background.Draw(tooltipX, tooltipY, tooltipWidth, tooltipHeight, gc);
+    background.Draw(tooltipX, tooltipY, tooltipWidth, tooltipHeight, gc, cache);
 
-	gc.SetFont(font, m_options.GetFontColor());
+	gc.SetFont(cache.GetFont(gc, fontOptions));
 	gc.DrawText(text, tooltipX + m_options.GetHorizontalPadding(), tooltipY + m_options.GetVerticalPadding());
 }
 
@@ -25,6 +25,7 @@
 wxChartTooltipOptions::wxChartTooltipOptions()
 	: m_fontFamily(wxFONTFAMILY_SWISS), m_fontSize(14),
 	m_fontStyle(wxFONTSTYLE_NORMAL), m_fontColor(0xFFFFFF),
+	m_fontOptions(m_fontFamily, m_fontSize, m_fontStyle, wxFONTWEIGHT_NORMAL, m_fontColor),
 	m_horizontalPadding(6), m_verticalPadding(6),
     m_backgroundOptions(wxColor(0, 0, 0, 0xCC), 6)
 {
@@ -50,6 +51,11 @@ const wxColor& wxChartTooltipOptions::GetFontColor() const
 	return m_fontColor;
 }
 
+const wxChartFontOptions& wxChartTooltipOptions::GetFontOptions() const
+{
+	return m_fontOptions;
+}
+
 wxDouble wxChartTooltipOptions::GetHorizontalPadding() const
 {
 	return m_horizontalPadding;
@@ -26,6 +26,10 @@ wxChartTooltipProvider::wxChartTooltipProvider()
 {
 }
 
+wxChartTooltipProvider::~wxChartTooltipProvider()
+{
+}
+
 wxChartTooltipProviderStatic::wxChartTooltipProviderStatic(const wxString &title, 
 														   const wxString &text,
 														   const wxColor &color)
@@ -47,3 +51,32 @@ wxColor wxChartTooltipProviderStatic::GetAssociatedColor() const
 {
 	return m_color;
 }
+
+wxChartDatasetTooltipProvider::wxChartDatasetTooltipProvider()
+{
+}
+
+wxChartDatasetTooltipProvider::~wxChartDatasetTooltipProvider()
+{
+}
+
+wxChartTooltipProviderDatasetItem::wxChartTooltipProviderDatasetItem(const wxChartDatasetTooltipProvider::ptr provider,
+																	 size_t index)
+	: m_provider(provider), m_index(index)
+{
+}
+
+wxString wxChartTooltipProviderDatasetItem::GetTooltipTitle() const
+{
+	return m_provider->GetTooltipTitle(m_index);
+}
+
+wxString wxChartTooltipProviderDatasetItem::GetTooltipText() const
+{
+	return m_provider->GetTooltipText(m_index);
+}
+
+wxColor wxChartTooltipProviderDatasetItem::GetAssociatedColor() const
+{
+	return m_provider->GetAssociatedColor(m_index);
+}
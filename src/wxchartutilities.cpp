@@ -32,6 +32,7 @@
 */
 
 #include "wxchartutilities.h"
+#include "wxcharttextextentcache.h"
 #include <sstream>
 
 size_t wxChartUtilities::GetDecimalPlaces()
@@ -100,8 +101,14 @@ void wxChartUtilities::GetTextSize(wxGraphicsContext &gc,
 								   wxDouble &width,
 								   wxDouble &height)
 {
-	wxDouble descent;
-	wxDouble externalLeading;
-	gc.SetFont(font, *wxBLACK);
-	gc.GetTextExtent(string, &width, &height, &descent, &externalLeading);
+	wxChartTextExtentCache::Get().GetTextSize(gc, font, string, width, height);
+}
+
+void wxChartUtilities::GetTextSize(wxGraphicsContext &gc,
+								   const wxChartFontOptions &fontOptions,
+								   const wxString &string,
+								   wxDouble &width,
+								   wxDouble &height)
+{
+	wxChartTextExtentCache::Get().GetTextSize(gc, fontOptions, string, width, height);
 }
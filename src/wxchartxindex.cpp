@@ -0,0 +1,73 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartxindex.h"
+#include <algorithm>
+
+wxChartXIndex::wxChartXIndex()
+    : m_isSorted(true)
+{
+}
+
+void wxChartXIndex::Clear()
+{
+    m_x.clear();
+    m_isSorted = true;
+}
+
+void wxChartXIndex::Add(wxDouble x)
+{
+    // Written so that a NaN also disables the binary search
+    if (!m_x.empty() && !(x >= m_x.back()))
+    {
+        m_isSorted = false;
+    }
+    m_x.push_back(x);
+}
+
+void wxChartXIndex::Query(wxDouble x,
+                          wxDouble range,
+                          wxVector<size_t> &points) const
+{
+    size_t i = 0;
+    if (m_isSorted)
+    {
+        i = std::lower_bound(m_x.begin(), m_x.end(), x - range) - m_x.begin();
+    }
+
+    for (; i < m_x.size(); ++i)
+    {
+        wxDouble distance = (x - m_x[i]);
+        if (m_isSorted && (distance <= -range))
+        {
+            break;
+        }
+        if (distance < 0)
+        {
+            distance = -distance;
+        }
+        if (distance < range)
+        {
+            points.push_back(i);
+        }
+    }
+}
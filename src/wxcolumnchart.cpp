@@ -32,6 +32,8 @@
 */
 
 #include "wxcolumnchart.h"
+#include "wxchartthreadpool.h"
+#include <algorithm>
 #include <sstream>
 
 wxColumnChart::Column::Column(wxDouble value,
@@ -67,7 +69,7 @@ void wxColumnChart::Dataset::AppendColumn(Column::ptr column)
 
 wxColumnChart::wxColumnChart(const wxBarChartData &data,
                              const wxSize &size)
-    : m_grid(
+    : wxChart(size), m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size, data.GetLabels(), GetMinValue(data.GetDatasets()),
         GetMaxValue(data.GetDatasets()), m_options.GetGridOptions()
@@ -153,6 +155,46 @@ wxDouble wxColumnChart::GetMaxValue(const wxVector<wxBarChartDataset::ptr>& data
     return result;
 }
 
+// Positions the columns at a range of positions along
+// the X axis
+class wxColumnChart::ColumnLoop : public wxChartThreadPool::Loop
+{
+public:
+    ColumnLoop(const wxChartGridMapping &mapping,
+        const wxVector<Dataset::ptr> &datasets, wxDouble columnWidth,
+        wxDouble columnSpacing, wxDouble datasetSpacing)
+        : m_mapping(mapping), m_datasets(datasets), m_columnWidth(columnWidth),
+        m_columnSpacing(columnSpacing), m_datasetSpacing(datasetSpacing)
+    {
+    }
+
+    virtual void Run(size_t begin, size_t end) wxOVERRIDE
+    {
+        for (size_t i = 0; i < m_datasets.size(); ++i)
+        {
+            const wxVector<Column::ptr>& columns = m_datasets[i]->GetColumns();
+            for (size_t j = begin; (j < end) && (j < columns.size()); ++j)
+            {
+                Column& column = *(columns[j]);
+                wxPoint2DDouble position = m_mapping.GetWindowPositionAtTickMark(j, column.GetValue());
+                position.m_x += m_columnSpacing + (i * (m_columnWidth + m_datasetSpacing));
+
+                wxPoint2DDouble bottomLeftCornerPosition = m_mapping.GetXAxis().GetTickMarkPosition(j);
+
+                column.SetPosition(position);
+                column.SetSize(m_columnWidth, bottomLeftCornerPosition.m_y - position.m_y);
+            }
+        }
+    }
+
+private:
+    const wxChartGridMapping &m_mapping;
+    const wxVector<Dataset::ptr> &m_datasets;
+    wxDouble m_columnWidth;
+    wxDouble m_columnSpacing;
+    wxDouble m_datasetSpacing;
+};
+
 void wxColumnChart::DoSetSize(const wxSize &size)
 {
     m_grid.Resize(size);
@@ -160,45 +202,49 @@ void wxColumnChart::DoSetSize(const wxSize &size)
 
 void wxColumnChart::DoFit()
 {
-    wxDouble columnWidth = GetColumnWidth();
-
+    size_t count = 0;
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        Dataset& currentDataset = *m_datasets[i];
-        for (size_t j = 0; j < currentDataset.GetColumns().size(); ++j)
-        {
-            Column& column = *(currentDataset.GetColumns()[j]);
-            wxPoint2DDouble position = m_grid.GetMapping().GetWindowPositionAtTickMark(j, column.GetValue());
-            position.m_x += m_options.GetColumnSpacing() + (i * (columnWidth + m_options.GetDatasetSpacing()));
-
-            wxPoint2DDouble bottomLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(j);
+        count = std::max(count, m_datasets[i]->GetColumns().size());
+    }
 
-            column.SetPosition(position);
-            column.SetSize(columnWidth, bottomLeftCornerPosition.m_y - position.m_y);
-        }
+    // Each column is only written by the iteration
+    // for its position
+    ColumnLoop loop(m_grid.GetMapping(), m_datasets, GetColumnWidth(),
+        m_options.GetColumnSpacing(), m_options.GetDatasetSpacing());
+    wxChartThreadPool *pool = GetFitPool(GetNumberOfColumns());
+    if (pool)
+    {
+        pool->RunLoop(loop, count);
+    }
+    else
+    {
+        loop.Run(0, count);
     }
 }
 
 void wxColumnChart::DoDraw(wxGraphicsContext &gc)
 {
-    m_grid.Draw(gc);
+    m_grid.Draw(gc, GetGraphicsCache());
 
     Fit();
 
+    // The columns of a dataset share the same style and are
+    // drawn as one batch
+    wxChartBatchRenderer renderer(gc, GetGraphicsCache());
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
         Dataset& currentDataset = *m_datasets[i];
         for (size_t j = 0; j < currentDataset.GetColumns().size(); ++j)
         {
-            currentDataset.GetColumns()[j]->Draw(gc);
+            currentDataset.GetColumns()[j]->Draw(renderer);
         }
     }
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxColumnChart::GetActiveElements(const wxPoint &point)
+void wxColumnChart::GetActiveElements(const wxPoint &point,
+                                      wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
-
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
         const wxVector<Column::ptr>& columns = m_datasets[i]->GetColumns();
@@ -208,13 +254,21 @@ wxSharedPtr<wxVector<const wxChartElement*> > wxColumnChart::GetActiveElements(c
             {
                 for (size_t k = 0; k < m_datasets.size(); ++k)
                 {
-                    activeElements->push_back(m_datasets[k]->GetColumns()[j].get());
+                    activeElements.push_back(m_datasets[k]->GetColumns()[j].get());
                 }
             }
         }
     }
+}
 
-    return activeElements;
+size_t wxColumnChart::GetNumberOfColumns() const
+{
+    size_t result = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        result += m_datasets[i]->GetColumns().size();
+    }
+    return result;
 }
 
 wxDouble wxColumnChart::GetColumnWidth() const
@@ -64,8 +64,8 @@ wxDouble wxDoughnutAndPieChartBase::SliceArc::GetValue() const
 	return m_value;
 }
 
-wxDoughnutAndPieChartBase::wxDoughnutAndPieChartBase()
-	: m_total(0)
+wxDoughnutAndPieChartBase::wxDoughnutAndPieChartBase(const wxSize &size)
+	: wxChart(size), m_total(0)
 {
 }
 
@@ -103,6 +103,11 @@ void wxDoughnutAndPieChartBase::DoFit()
         m_slices[i]->Resize(m_size, GetOptions());
     }
 
+    if (!m_slices.empty())
+    {
+        m_index.Clear(m_slices[0]->GetCenter());
+    }
+
     wxDouble startAngle = 0.0;
     for (size_t i = 0; i < m_slices.size(); ++i)
     {
@@ -110,6 +115,7 @@ void wxDoughnutAndPieChartBase::DoFit()
 
         wxDouble endAngle = startAngle + CalculateCircumference(currentSlice.GetValue());
         currentSlice.SetAngles(startAngle, endAngle);
+        m_index.Add(&currentSlice, startAngle, endAngle);
         startAngle = endAngle;
     }
 }
@@ -118,23 +124,19 @@ void wxDoughnutAndPieChartBase::DoDraw(wxGraphicsContext &gc)
 {
     Fit();
 
-    for (size_t i = 0; i < m_slices.size(); ++i)
     {
-        m_slices[i]->Draw(gc);
+        wxChartBatchRenderer renderer(gc, GetGraphicsCache());
+        for (size_t i = 0; i < m_slices.size(); ++i)
+        {
+            m_slices[i]->Draw(renderer);
+        }
     }
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxDoughnutAndPieChartBase::GetActiveElements(const wxPoint &point)
+void wxDoughnutAndPieChartBase::GetActiveElements(const wxPoint &point,
+                                                  wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
-    for (size_t i = 0; i < m_slices.size(); ++i)
-    {
-        if (m_slices[i]->HitTest(point))
-        {
-            activeElements->push_back(m_slices[i].get());
-        }
-    }
-    return activeElements;
+    m_index.Query(point, activeElements);
 }
 
 wxDouble wxDoughnutAndPieChartBase::CalculateCircumference(wxDouble value)
@@ -38,6 +38,7 @@ const wxVector<wxChartSliceData>& wxDoughnutChartData::GetSlices() const
 
 wxDoughnutChart::wxDoughnutChart(const wxDoughnutChartData &data,
                                  const wxSize &size)
+    : wxDoughnutAndPieChartBase(size)
 {
     Initialize(data, size);
 }
@@ -45,7 +46,7 @@ wxDoughnutChart::wxDoughnutChart(const wxDoughnutChartData &data,
 wxDoughnutChart::wxDoughnutChart(const wxDoughnutChartData &data,
                                  const wxDougnutChartOptions &options,
                                  const wxSize &size)
-    : m_options(options)
+    : wxDoughnutAndPieChartBase(size), m_options(options)
 {
     Initialize(data, size);
 }
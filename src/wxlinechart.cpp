@@ -34,7 +34,7 @@
 #include "wxlinechart.h"
 #include <wx/brush.h>
 #include <wx/pen.h>
-#include <wx/dcmemory.h>
+#include <algorithm>
 #include <sstream>
 
 wxLineChartDataset::wxLineChartDataset(const wxString &label,
@@ -120,45 +120,52 @@ const wxVector<wxLineChartDataset::ptr>& wxLineChartData::GetDatasets() const
     return m_datasets;
 }
 
-wxLineChart::Point::Point(wxDouble value,
-                          const wxChartTooltipProvider::ptr tooltipProvider,
-                          wxDouble x,
-                          wxDouble y,
-                          wxDouble radius,
-                          unsigned int strokeWidth,
-                          const wxColor &strokeColor,
-                          const wxColor &fillColor,
-                          wxDouble hitDetectionRange)
-    : wxChartPoint(x, y, radius, tooltipProvider, wxChartPointOptions(strokeWidth, strokeColor, fillColor)),
-    m_value(value), m_hitDetectionRange(hitDetectionRange)
+wxLineChart::TooltipProvider::TooltipProvider(const wxChartRingBuffer<wxString> &labels,
+                                              const Dataset &dataset)
+    : m_labels(labels), m_dataset(dataset)
 {
 }
 
-bool wxLineChart::Point::HitTest(const wxPoint &point) const
+wxString wxLineChart::TooltipProvider::GetTooltipTitle(size_t index) const
 {
-    wxDouble distance = (point.x - GetPosition().m_x);
-    if (distance < 0)
+    // The labels and the values are appended separately
+    // so there may be fewer labels than values
+    if (index < m_labels.GetCount())
     {
-        distance = -distance;
+        return m_labels[index];
     }
-    return (distance < m_hitDetectionRange);
+    return wxString();
 }
 
-wxDouble wxLineChart::Point::GetValue() const
+wxString wxLineChart::TooltipProvider::GetTooltipText(size_t index) const
 {
-    return m_value;
+    std::stringstream tooltip;
+    tooltip << m_dataset.GetValues()[index];
+    return tooltip.str();
 }
 
-wxLineChart::Dataset::Dataset(bool showDots,
-    bool showLine,
-    const wxColor &lineColor,
-    bool fill,
-    const wxColor &fillColor,
-    const wxLineType &lineType)
-    : m_showDots(showDots), m_showLine(showLine),
-    m_lineColor(lineColor), m_fill(fill),
-    m_fillColor(fillColor), m_type(lineType)
+wxColor wxLineChart::TooltipProvider::GetAssociatedColor(size_t index) const
 {
+    return m_dataset.GetLineColor();
+}
+
+wxLineChart::Dataset::Dataset(const wxLineChartDataset &data,
+    const wxChartRingBuffer<wxString> &labels,
+    wxDouble dotRadius,
+    wxDouble hitDetectionRange,
+    const wxChartPointOptions &dotOptions)
+    : m_showDots(data.ShowDots()), m_showLine(data.ShowLine()),
+    m_lineColor(data.GetLineColor()), m_fill(data.Fill()),
+    m_fillColor(data.GetFillColor()), m_type(data.GetType()),
+    m_points(data.GetData().size(), dotRadius, hitDetectionRange, dotOptions)
+{
+    const wxVector<wxDouble>& values = data.GetData();
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        m_values.Append(values[i]);
+        m_range.Push(values[i]);
+    }
+    m_tooltipProvider = wxChartDatasetTooltipProvider::ptr(new TooltipProvider(labels, *this));
 }
 
 bool wxLineChart::Dataset::ShowDots() const
@@ -191,19 +198,117 @@ const wxLineType& wxLineChart::Dataset::GetType() const
      return m_type;
 }
 
-const wxVector<wxLineChart::Point::ptr>& wxLineChart::Dataset::GetPoints() const
+const wxChartRingBuffer<wxDouble>& wxLineChart::Dataset::GetValues() const
+{
+    return m_values;
+}
+
+void wxLineChart::Dataset::AppendValue(wxDouble value)
+{
+    if (m_values.IsFull())
+    {
+        m_range.Pop();
+    }
+    m_values.Append(value);
+    m_range.Push(value);
+    m_points.SetCount(m_values.GetCount());
+}
+
+void wxLineChart::Dataset::SetCapacity(size_t capacity)
+{
+    m_values.SetCapacity(capacity);
+    m_points.SetCount(m_values.GetCount());
+
+    m_range.Clear();
+    for (size_t i = 0; i < m_values.GetCount(); ++i)
+    {
+        m_range.Push(m_values[i]);
+    }
+}
+
+const wxChartSlidingMinMax& wxLineChart::Dataset::GetRange() const
+{
+    return m_range;
+}
+
+const wxChartDatasetTooltipProvider::ptr& wxLineChart::Dataset::GetTooltipProvider() const
+{
+    return m_tooltipProvider;
+}
+
+const wxChartPointSeries& wxLineChart::Dataset::GetPoints() const
 {
     return m_points;
 }
 
-void wxLineChart::Dataset::AppendPoint(Point::ptr point)
+wxChartPointSeries& wxLineChart::Dataset::GetPoints()
 {
-    m_points.push_back(point);
+    return m_points;
+}
+
+void wxLineChart::Dataset::UpdateLine(wxChartDownsamplingMode mode,
+                                      size_t threshold)
+{
+    m_line.clear();
+    if (m_points.GetCount() <= threshold)
+    {
+        return;
+    }
+
+    switch (mode)
+    {
+    case wxCHARTDOWNSAMPLINGMODE_LTTB:
+        wxChartDownsampling::LargestTriangleThreeBuckets(m_points.GetPositions(), threshold, m_line);
+        break;
+
+    case wxCHARTDOWNSAMPLINGMODE_M4:
+    case wxCHARTDOWNSAMPLINGMODE_MINMAXPYRAMID:
+        wxChartDownsampling::M4(m_points.GetPositions(), m_line);
+        break;
+
+    case wxCHARTDOWNSAMPLINGMODE_NONE:
+        break;
+    }
+}
+
+const wxVector<wxPoint2DDouble>& wxLineChart::Dataset::GetLine() const
+{
+    if (m_line.empty())
+    {
+        return m_points.GetPositions();
+    }
+    return m_line;
+}
+
+wxLineChart::Point::Point(const Dataset &dataset,
+                          size_t index)
+    : m_dataset(dataset), m_index(index)
+{
+}
+
+bool wxLineChart::Point::HitTest(const wxPoint &point) const
+{
+    wxDouble distance = (point.x - m_dataset.GetPoints().GetPosition(m_index).m_x);
+    if (distance < 0)
+    {
+        distance = -distance;
+    }
+    return (distance < m_dataset.GetPoints().GetHitDetectionRange());
+}
+
+wxPoint2DDouble wxLineChart::Point::GetTooltipPosition() const
+{
+    return m_dataset.GetPoints().GetPosition(m_index);
+}
+
+const wxChartTooltipProvider::ptr wxLineChart::Point::GetTooltipProvider() const
+{
+    return wxChartTooltipProvider::ptr(new wxChartTooltipProviderDatasetItem(m_dataset.GetTooltipProvider(), m_index));
 }
 
 wxLineChart::wxLineChart(const wxLineChartData &data,
                          const wxSize &size)
-    : m_grid(
+    : wxChart(size), m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetTop()),
         size, data.GetLabels(), GetMinValue(data.GetDatasets()),
         GetMaxValue(data.GetDatasets()), m_options.GetGridOptions()
@@ -215,7 +320,7 @@ wxLineChart::wxLineChart(const wxLineChartData &data,
 wxLineChart::wxLineChart(const wxLineChartData &data,
                          const wxLineChartOptions &options,
                          const wxSize &size)
-    : m_options(options),
+    : wxChart(size), m_options(options),
     m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetTop()),
         size, data.GetLabels(), GetMinValue(data.GetDatasets()),
@@ -230,53 +335,78 @@ const wxLineChartOptions& wxLineChart::GetOptions() const
     return m_options;
 }
 
-void wxLineChart::Save(const wxString &filename,
-                       const wxBitmapType &type,
-                       const wxSize &size)
+void wxLineChart::AppendValues(size_t datasetIndex,
+                               const wxVector<wxDouble> &values)
+{
+    wxCHECK_RET(datasetIndex < m_datasets.size(), "Invalid dataset index");
+
+    Dataset &dataset = *m_datasets[datasetIndex];
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        dataset.AppendValue(values[i]);
+    }
+
+    m_valuesChanged = true;
+    Invalidate();
+}
+
+void wxLineChart::AppendLabels(const wxVector<wxString> &labels)
 {
-    wxBitmap bmp(size.GetWidth(), size.GetHeight());
-    wxMemoryDC mdc(bmp);
-    mdc.Clear();
-    wxGraphicsContext* gc = wxGraphicsContext::Create(mdc);
-    if (gc)
+    for (size_t i = 0; i < labels.size(); ++i)
     {
-        DoDraw(*gc);
-        bmp.SaveFile(filename, type);
-        delete gc;
+        m_labels.Append(labels[i]);
     }
+
+    m_labelsChanged = true;
+    Invalidate();
+}
+
+size_t wxLineChart::GetCapacity() const
+{
+    return m_labels.GetCapacity();
+}
+
+void wxLineChart::SetCapacity(size_t capacity)
+{
+    m_labels.SetCapacity(capacity);
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        m_datasets[i]->SetCapacity(capacity);
+    }
+
+    // Some points may no longer exist, the index will be
+    // rebuilt by the next DoFit
+    m_xIndices.clear();
+    ResetActiveElements();
+
+    m_labelsChanged = true;
+    m_valuesChanged = true;
+    Invalidate();
 }
 
 void wxLineChart::Initialize(const wxLineChartData &data)
 {
+    const wxVector<wxString>& labels = data.GetLabels();
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        m_labels.Append(labels[i]);
+    }
+
     const wxVector<wxLineChartDataset::ptr>& datasets = data.GetDatasets();
     for (size_t i = 0; i < datasets.size(); ++i)
     {
-        Dataset::ptr newDataset(new Dataset(datasets[i]->ShowDots(),
-            datasets[i]->ShowLine(), datasets[i]->GetLineColor(),
-            datasets[i]->Fill(), datasets[i]->GetFillColor(),
-            datasets[i]->GetType()));
-
-        const wxVector<wxDouble>& datasetData = datasets[i]->GetData();
-        for (size_t j = 0; j < datasetData.size(); ++j)
-        {
-            std::stringstream tooltip;
-            tooltip << datasetData[j];
-            wxChartTooltipProvider::ptr tooltipProvider(
-                new wxChartTooltipProviderStatic(data.GetLabels()[j], tooltip.str(), datasets[i]->GetLineColor())
-                );
-
-            Point::ptr point(
-                new Point(datasetData[j], tooltipProvider, 20 + j * 10, 0,
-                    m_options.GetDotRadius(), m_options.GetDotStrokeWidth(),
-                    datasets[i]->GetDotStrokeColor(), datasets[i]->GetDotColor(),
-                    m_options.GetHitDetectionRange())
-                );
-
-            newDataset->AppendPoint(point);
-        }
+        Dataset::ptr newDataset(new Dataset(*datasets[i], m_labels,
+            m_options.GetDotRadius(), m_options.GetHitDetectionRange(),
+            wxChartPointOptions(m_options.GetDotStrokeWidth(),
+                datasets[i]->GetDotStrokeColor(), datasets[i]->GetDotColor())));
 
         m_datasets.push_back(newDataset);
     }
+
+    // The grid was built from the same values
+    UpdateValueRange();
+    m_labelsChanged = false;
+    m_valuesChanged = false;
 }
 
 wxDouble wxLineChart::GetMinValue(const wxVector<wxLineChartDataset::ptr>& datasets)
@@ -329,6 +459,58 @@ wxDouble wxLineChart::GetMaxValue(const wxVector<wxLineChartDataset::ptr>& datas
     return result;
 }
 
+void wxLineChart::UpdateValueRange()
+{
+    m_minValue = 0;
+    m_maxValue = 0;
+    bool foundValue = false;
+
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        const wxChartSlidingMinMax &range = m_datasets[i]->GetRange();
+        if (range.IsEmpty())
+        {
+            continue;
+        }
+
+        if (!foundValue)
+        {
+            m_minValue = range.GetMin();
+            m_maxValue = range.GetMax();
+            foundValue = true;
+        }
+        else
+        {
+            m_minValue = std::min(m_minValue, range.GetMin());
+            m_maxValue = std::max(m_maxValue, range.GetMax());
+        }
+    }
+}
+
+void wxLineChart::UpdateGrid()
+{
+    if (m_labelsChanged)
+    {
+        wxVector<wxString> labels;
+        labels.reserve(m_labels.GetCount());
+        for (size_t i = 0; i < m_labels.GetCount(); ++i)
+        {
+            labels.push_back(m_labels[i]);
+        }
+        m_grid.SetXLabels(labels);
+        m_labelsChanged = false;
+    }
+
+    if (m_valuesChanged)
+    {
+        UpdateValueRange();
+        // This only rebuilds the Y axis if the tick
+        // marks need to change
+        m_grid.SetYRange(m_minValue, m_maxValue);
+        m_valuesChanged = false;
+    }
+}
+
 void wxLineChart::DoSetSize(const wxSize &size)
 {
     wxSize newSize(
@@ -340,41 +522,58 @@ void wxLineChart::DoSetSize(const wxSize &size)
 
 void wxLineChart::DoFit()
 {
+    // The lines are downsampled here rather than in DoDraw
+    // so that it is only done when the layout changes
+    const size_t threshold = wxChartDownsampling::GetThreshold(m_grid.GetMapping().GetSize().GetWidth());
+
+    m_xIndices.resize(m_datasets.size());
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        m_xIndices[i].Clear();
+        const wxChartRingBuffer<wxDouble>& values = m_datasets[i]->GetValues();
+        wxChartPointSeries& points = m_datasets[i]->GetPoints();
+        for (size_t j = 0; j < points.GetCount(); ++j)
+        {
+            points.SetPosition(j, m_grid.GetMapping().GetWindowPositionAtTickMark(j, values[j]));
+            m_xIndices[i].Add(points.GetPosition(j).m_x);
+        }
+        m_datasets[i]->UpdateLine(m_options.GetDownsamplingMode(), threshold);
+    }
 }
 
 void wxLineChart::DoDraw(wxGraphicsContext &gc)
 {
-    m_grid.Draw(gc);
+    UpdateGrid();
+    m_grid.Draw(gc, GetGraphicsCache());
+    Fit();
 
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
+        const wxChartPointSeries& points = m_datasets[i]->GetPoints();
+        const wxVector<wxPoint2DDouble>& line = m_datasets[i]->GetLine();
 
         wxGraphicsPath path = gc.CreatePath();
 
-        if (points.size() > 0)
+        if (line.size() > 0)
         {
-            const Point::ptr& point = points[0];
-            wxPoint2DDouble firstPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(0, point->GetValue());
+            wxPoint2DDouble firstPosition = line[0];
             path.MoveToPoint(firstPosition);
 
             wxPoint2DDouble lastPosition;
-            for (size_t j = 1; j < points.size(); ++j)
+            for (size_t j = 1; j < line.size(); ++j)
             {
-                const Point::ptr& point = points[j];
-                lastPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(j, point->GetValue());
+                lastPosition = line[j];
                 if(m_datasets[i]->GetType()==wxLINETYPE_STEPPEDLINE)
                  {
-                     wxPoint2DDouble temp = m_grid.GetMapping().GetWindowPositionAtTickMark(j, points[j-1]->GetValue());
-                     path.AddLineToPoint(temp);
+                     path.AddLineToPoint(lastPosition.m_x, line[j - 1].m_y);
                  }
                 path.AddLineToPoint(lastPosition);
             }
 
             if (m_datasets[i]->ShowLine())
             {
-                wxPen pen(m_datasets[i]->GetLineColor(), m_options.GetLineWidth());
-                gc.SetPen(pen);
+                gc.SetPen(GetGraphicsCache().GetPen(gc, m_datasets[i]->GetLineColor(),
+                    m_options.GetLineWidth()));
             }
             else
             {
@@ -389,36 +588,41 @@ void wxLineChart::DoDraw(wxGraphicsContext &gc)
             path.AddLineToPoint(firstPosition.m_x, yPos.m_y);
             path.CloseSubpath();
 
-            wxBrush brush(m_datasets[i]->GetFillColor());
-            gc.SetBrush(brush);
+            gc.SetBrush(GetGraphicsCache().GetBrush(gc, m_datasets[i]->GetFillColor()));
             gc.FillPath(path);
         }
 
         if (m_datasets[i]->ShowDots())
         {
-            for (size_t j = 0; j < points.size(); ++j)
-            {
-                const Point::ptr& point = points[j];
-                point->SetPosition(m_grid.GetMapping().GetWindowPositionAtTickMark(j, point->GetValue()));
-                point->Draw(gc);
-            }
+            wxChartBatchRenderer renderer(gc, GetGraphicsCache());
+            points.Draw(renderer);
         }
     }
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxLineChart::GetActiveElements(const wxPoint &point)
+void wxLineChart::GetActiveElements(const wxPoint &point,
+                                    wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
-    for (size_t i = 0; i < m_datasets.size(); ++i)
+    m_activePoints.StartPass();
+    for (size_t i = 0; i < m_xIndices.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        m_hitPoints.clear();
+        m_xIndices[i].Query(point.x, m_options.GetHitDetectionRange(), m_hitPoints);
+        for (size_t j = 0; j < m_hitPoints.size(); ++j)
         {
-            if (points[j]->HitTest(point))
-            {
-                activeElements->push_back(points[j].get());
-            }
+            activeElements.push_back(GetActivePoint(i, m_hitPoints[j]));
         }
     }
-    return activeElements;
+}
+
+const wxChartElement* wxLineChart::GetActivePoint(size_t datasetIndex,
+                                                  size_t index)
+{
+    const wxChartElement *point = m_activePoints.Get(datasetIndex, index);
+    if (!point)
+    {
+        point = m_activePoints.Add(datasetIndex, index,
+            new Point(*m_datasets[datasetIndex], index));
+    }
+    return point;
 }
@@ -54,11 +54,30 @@ wxLineChartCtrl::wxLineChartCtrl(wxWindow *parent,
 								 const wxSize &size,
 								 long style)
 	: wxChartCtrl(parent, id, pos, size, style),
-    m_lineChart(data, size)
+    m_lineChart(data, options, size)
 {
     CreateContextMenu();
 }
 
+void wxLineChartCtrl::AppendValues(size_t datasetIndex,
+                                   const wxVector<wxDouble> &values)
+{
+    m_lineChart.AppendValues(datasetIndex, values);
+    Refresh();
+}
+
+void wxLineChartCtrl::AppendLabels(const wxVector<wxString> &labels)
+{
+    m_lineChart.AppendLabels(labels);
+    Refresh();
+}
+
+void wxLineChartCtrl::SetCapacity(size_t capacity)
+{
+    m_lineChart.SetCapacity(capacity);
+    Refresh();
+}
+
 wxLineChart& wxLineChartCtrl::GetChart()
 {
     return m_lineChart;
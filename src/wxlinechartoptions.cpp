@@ -24,7 +24,8 @@
 
 wxLineChartOptions::wxLineChartOptions()
 	: m_dotRadius(4), m_dotStrokeWidth(1),
-	m_lineWidth(2), m_hitDetectionRange(24)
+	m_lineWidth(2), m_hitDetectionRange(24),
+	m_downsamplingMode(wxCHARTDOWNSAMPLINGMODE_NONE)
 {
 }
 
@@ -57,3 +58,13 @@ wxDouble wxLineChartOptions::GetHitDetectionRange() const
 {
 	return m_hitDetectionRange;
 }
+
+wxChartDownsamplingMode wxLineChartOptions::GetDownsamplingMode() const
+{
+	return m_downsamplingMode;
+}
+
+void wxLineChartOptions::SetDownsamplingMode(wxChartDownsamplingMode mode)
+{
+	m_downsamplingMode = mode;
+}
@@ -32,8 +32,10 @@
 */
 
 #include "wxmath2dplot.h"
-#include <wx/dcmemory.h>
+#include "wxchartnumericalaxis.h"
+#include "wxchartthreadpool.h"
 #include <sstream>
+#include <algorithm>
 
 wxMath2DPlotDataset::wxMath2DPlotDataset(
     const wxColor &dotColor,
@@ -95,50 +97,43 @@ const wxVector<wxMath2DPlotDataset::ptr>& wxMath2DPlotData::GetDatasets() const
     return m_datasets;
 }
 
-wxMath2DPlot::Point::Point(
-    wxPoint2DDouble value,
-    const wxChartTooltipProvider::ptr tooltipProvider,
-    wxDouble x,
-    wxDouble y,
-    wxDouble radius,
-    unsigned int strokeWidth,
-    const wxColor &strokeColor,
-    const wxColor &fillColor,
-    wxDouble hitDetectionRange)
-    : wxChartPoint(x, y, radius, tooltipProvider, wxChartPointOptions(strokeWidth, strokeColor, fillColor)),
-      m_value(value), m_hitDetectionRange(hitDetectionRange)
+wxMath2DPlot::TooltipProvider::TooltipProvider(const Dataset &dataset)
+    : m_dataset(dataset)
 {
 }
 
-wxPoint2DDouble wxMath2DPlot::Point::GetTooltipPosition() const
+wxString wxMath2DPlot::TooltipProvider::GetTooltipTitle(size_t index) const
 {
-    wxPoint2DDouble position = wxChartPoint::GetTooltipPosition();
-    position.m_y -= 10;
-    return position;
+    return "";
 }
 
-bool wxMath2DPlot::Point::HitTest(const wxPoint &point) const
+wxString wxMath2DPlot::TooltipProvider::GetTooltipText(size_t index) const
 {
-    wxDouble distance = (point.x - GetPosition().m_x);
-    if (distance < 0)
-    {
-        distance = -distance;
-    }
-    return (distance < m_hitDetectionRange);
+    const wxPoint2DDouble &value = m_dataset.GetValues()[index];
+    std::stringstream tooltip;
+    tooltip << "(" << value.m_x << "," << value.m_y << ")";
+    return tooltip.str();
 }
 
-wxPoint2DDouble wxMath2DPlot::Point::GetValue() const
+wxColor wxMath2DPlot::TooltipProvider::GetAssociatedColor(size_t index) const
 {
-    return m_value;
+    return m_dataset.GetLineColor();
 }
 
-wxMath2DPlot::Dataset::Dataset(bool showDots,
-                               bool showLine,
-                               const wxColor &lineColor,
-                               const wxChartType &chartType)
-    : m_showDots(showDots), m_showLine(showLine),
-      m_lineColor(lineColor), m_type(chartType)
+wxMath2DPlot::Dataset::Dataset(const wxMath2DPlotDataset &data,
+    wxDouble dotRadius,
+    wxDouble hitDetectionRange,
+    const wxChartPointOptions &dotOptions)
+    : m_showDots(data.ShowDots()), m_showLine(data.ShowLine()), m_lineColor(data.GetLineColor()), m_type(data.GetType()),
+    m_points(0, dotRadius, hitDetectionRange, dotOptions),
+    m_downsampled(false), m_unsortedCount(0), m_discardedCount(0)
 {
+    const wxVector<wxPoint2DDouble>& values = data.GetData();
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        AppendValue(values[i]);
+    }
+    m_tooltipProvider = wxChartDatasetTooltipProvider::ptr(new TooltipProvider(*this));
 }
 
 bool wxMath2DPlot::Dataset::ShowDots() const
@@ -161,19 +156,330 @@ const wxChartType& wxMath2DPlot::Dataset::GetType() const
     return m_type;
 }
 
-const wxVector<wxMath2DPlot::Point::ptr>& wxMath2DPlot::Dataset::GetPoints() const
+const wxChartRingBuffer<wxPoint2DDouble>& wxMath2DPlot::Dataset::GetValues() const
+{
+    return m_values;
+}
+
+void wxMath2DPlot::Dataset::AppendValue(const wxPoint2DDouble &value)
+{
+    if (m_values.IsFull())
+    {
+        m_xRange.Pop();
+        m_yRange.Pop();
+        // The first two points are no longer next
+        // to each other once the first one is gone
+        if ((m_values.GetCount() > 1) && (m_values[1].m_x < m_values[0].m_x))
+        {
+            --m_unsortedCount;
+        }
+        ++m_discardedCount;
+    }
+    if ((m_values.GetCount() > 0) &&
+        (value.m_x < m_values[m_values.GetCount() - 1].m_x))
+    {
+        ++m_unsortedCount;
+    }
+    m_values.Append(value);
+    m_xRange.Push(value.m_x);
+    m_yRange.Push(value.m_y);
+    m_points.SetCount(m_values.GetCount());
+}
+
+void wxMath2DPlot::Dataset::SetCapacity(size_t capacity)
+{
+    m_values.SetCapacity(capacity);
+    m_points.SetCount(m_values.GetCount());
+
+    m_xRange.Clear();
+    m_yRange.Clear();
+    m_unsortedCount = 0;
+    for (size_t i = 0; i < m_values.GetCount(); ++i)
+    {
+        m_xRange.Push(m_values[i].m_x);
+        m_yRange.Push(m_values[i].m_y);
+        if ((i > 0) && (m_values[i].m_x < m_values[i - 1].m_x))
+        {
+            ++m_unsortedCount;
+        }
+    }
+    m_pyramid.Clear();
+    m_discardedCount = 0;
+}
+
+const wxChartSlidingMinMax& wxMath2DPlot::Dataset::GetXRange() const
+{
+    return m_xRange;
+}
+
+const wxChartSlidingMinMax& wxMath2DPlot::Dataset::GetYRange() const
+{
+    return m_yRange;
+}
+
+const wxChartDatasetTooltipProvider::ptr& wxMath2DPlot::Dataset::GetTooltipProvider() const
+{
+    return m_tooltipProvider;
+}
+
+const wxChartPointSeries& wxMath2DPlot::Dataset::GetPoints() const
 {
     return m_points;
 }
 
-void wxMath2DPlot::Dataset::AppendPoint(Point::ptr point)
+wxChartPointSeries& wxMath2DPlot::Dataset::GetPoints()
+{
+    return m_points;
+}
+
+bool wxMath2DPlot::Dataset::IsSorted() const
+{
+    return (m_unsortedCount == 0);
+}
+
+// Maps values of a dataset to window positions
+class wxMath2DPlot::PositionLoop : public wxChartThreadPool::Loop
+{
+public:
+    // If indices is 0 all the values are mapped, line
+    // receives a copy of the positions if it isn't 0
+    PositionLoop(const wxChartGridMapping &mapping,
+        const wxChartRingBuffer<wxPoint2DDouble> &values,
+        const wxVector<size_t> *indices, wxChartPointSeries &points,
+        wxVector<wxPoint2DDouble> *line)
+        : m_mapping(mapping), m_values(values), m_indices(indices),
+        m_points(points), m_line(line)
+    {
+    }
+
+    virtual void Run(size_t begin, size_t end) wxOVERRIDE
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            size_t index = m_indices ? (*m_indices)[i] : i;
+            const wxPoint2DDouble &value = m_values[index];
+            wxPoint2DDouble position = m_mapping.GetWindowPosition(value.m_x, value.m_y);
+            m_points.SetPosition(index, position);
+            if (m_line)
+            {
+                (*m_line)[i] = position;
+            }
+        }
+    }
+
+private:
+    const wxChartGridMapping &m_mapping;
+    const wxChartRingBuffer<wxPoint2DDouble> &m_values;
+    const wxVector<size_t> *m_indices;
+    wxChartPointSeries &m_points;
+    wxVector<wxPoint2DDouble> *m_line;
+};
+
+void wxMath2DPlot::Dataset::UpdateLine(const wxChartGridMapping &mapping,
+                                       wxChartDownsamplingMode mode,
+                                       size_t threshold,
+                                       wxChartThreadPool *pool)
+{
+    m_visibleIndices.clear();
+    m_visibleLine.clear();
+    PositionLoop loop(mapping, m_values, 0, m_points, 0);
+    if (pool)
+    {
+        pool->RunLoop(loop, m_points.GetCount());
+    }
+    else
+    {
+        loop.Run(0, m_points.GetCount());
+    }
+    Downsample(m_points.GetPositions(), mode, threshold);
+}
+
+void wxMath2DPlot::Dataset::UpdateVisibleLine(const wxChartGridMapping &mapping,
+                                              wxDouble minXValue,
+                                              wxDouble maxXValue,
+                                              wxChartDownsamplingMode mode,
+                                              size_t threshold,
+                                              wxChartThreadPool *pool)
+{
+    // The points are sorted by X so the visible ones
+    // can be found with a binary search
+    size_t first = 0;
+    size_t end = m_values.GetCount();
+    while (first < end)
+    {
+        size_t middle = first + ((end - first) / 2);
+        if (m_values[middle].m_x < minXValue)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            end = middle;
+        }
+    }
+    size_t last = first;
+    end = m_values.GetCount();
+    while (last < end)
+    {
+        size_t middle = last + ((end - last) / 2);
+        if (m_values[middle].m_x <= maxXValue)
+        {
+            last = middle + 1;
+        }
+        else
+        {
+            end = middle;
+        }
+    }
+
+    // Keep one point on each side so the line
+    // reaches the edges of the plot
+    if (first > 0)
+    {
+        --first;
+    }
+    if (last < m_values.GetCount())
+    {
+        ++last;
+    }
+
+    const bool usesPyramid = UsesPyramid(mode, threshold);
+    if (!usesPyramid && (first == 0) && (last == m_values.GetCount()))
+    {
+        UpdateLine(mapping, mode, threshold, pool);
+        return;
+    }
+
+    // All the visible points are positioned, they
+    // are needed for the dots and the hit detection
+    // even if the line goes through fewer of them
+    m_visibleIndices.clear();
+    m_visibleIndices.reserve(last - first);
+    for (size_t i = first; i < last; ++i)
+    {
+        m_visibleIndices.push_back(i);
+    }
+
+    m_visibleLine.resize(m_visibleIndices.size());
+    PositionLoop loop(mapping, m_values, &m_visibleIndices, m_points, &m_visibleLine);
+    if (pool)
+    {
+        pool->RunLoop(loop, m_visibleIndices.size());
+    }
+    else
+    {
+        loop.Run(0, m_visibleIndices.size());
+    }
+
+    if (usesPyramid)
+    {
+        // The line only goes through the points picked
+        // by the pyramid
+        m_pyramid.Update(m_values, m_discardedCount);
+        m_pyramidIndices.clear();
+        m_pyramid.Select(first, last, threshold / 2, m_pyramidIndices);
+        m_line.resize(m_pyramidIndices.size());
+        for (size_t i = 0; i < m_pyramidIndices.size(); ++i)
+        {
+            m_line[i] = m_visibleLine[m_pyramidIndices[i] - first];
+        }
+        m_downsampled = true;
+    }
+    else
+    {
+        Downsample(m_visibleLine, mode, threshold);
+    }
+}
+
+const wxVector<wxPoint2DDouble>& wxMath2DPlot::Dataset::GetLine() const
+{
+    if (m_downsampled)
+    {
+        return m_line;
+    }
+    if (!m_visibleIndices.empty())
+    {
+        return m_visibleLine;
+    }
+    return m_points.GetPositions();
+}
+
+const wxVector<size_t>& wxMath2DPlot::Dataset::GetVisibleIndices() const
 {
-    m_points.push_back(point);
+    return m_visibleIndices;
+}
+
+bool wxMath2DPlot::Dataset::UsesPyramid(wxChartDownsamplingMode mode,
+                                        size_t threshold) const
+{
+    return ((mode == wxCHARTDOWNSAMPLINGMODE_MINMAXPYRAMID) &&
+        IsSorted() && (m_type != wxCHARTTYPE_STEM) &&
+        (m_values.GetCount() > threshold));
+}
+
+void wxMath2DPlot::Dataset::Downsample(const wxVector<wxPoint2DDouble> &positions,
+                                       wxChartDownsamplingMode mode,
+                                       size_t threshold)
+{
+    m_line.clear();
+    m_downsampled = false;
+
+    // Every point of a stem chart has its own stem so
+    // none of them can be dropped
+    if ((m_type == wxCHARTTYPE_STEM) || (positions.size() <= threshold))
+    {
+        return;
+    }
+
+    switch (mode)
+    {
+    case wxCHARTDOWNSAMPLINGMODE_LTTB:
+        wxChartDownsampling::LargestTriangleThreeBuckets(positions, threshold, m_line);
+        m_downsampled = true;
+        break;
+
+    case wxCHARTDOWNSAMPLINGMODE_M4:
+    case wxCHARTDOWNSAMPLINGMODE_MINMAXPYRAMID:
+        wxChartDownsampling::M4(positions, m_line);
+        m_downsampled = true;
+        break;
+
+    case wxCHARTDOWNSAMPLINGMODE_NONE:
+        break;
+    }
+}
+
+wxMath2DPlot::Point::Point(const Dataset &dataset,
+                           size_t index)
+    : m_dataset(dataset), m_index(index)
+{
+}
+
+bool wxMath2DPlot::Point::HitTest(const wxPoint &point) const
+{
+    wxDouble distance = (point.x - m_dataset.GetPoints().GetPosition(m_index).m_x);
+    if (distance < 0)
+    {
+        distance = -distance;
+    }
+    return (distance < m_dataset.GetPoints().GetHitDetectionRange());
+}
+
+wxPoint2DDouble wxMath2DPlot::Point::GetTooltipPosition() const
+{
+    wxPoint2DDouble position = m_dataset.GetPoints().GetPosition(m_index);
+    position.m_y -= 10;
+    return position;
+}
+
+const wxChartTooltipProvider::ptr wxMath2DPlot::Point::GetTooltipProvider() const
+{
+    return wxChartTooltipProvider::ptr(new wxChartTooltipProviderDatasetItem(m_dataset.GetTooltipProvider(), m_index));
 }
 
 wxMath2DPlot::wxMath2DPlot(const wxMath2DPlotData &data,
                            const wxSize &size)
-    : m_grid(
+    : wxChart(size), m_grid(
           wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
           size,
           GetMinXValue(data.GetDatasets()), GetMaxXValue(data.GetDatasets()),
@@ -186,7 +492,7 @@ wxMath2DPlot::wxMath2DPlot(const wxMath2DPlotData &data,
 wxMath2DPlot::wxMath2DPlot(const wxMath2DPlotData &data,
                            const wxMath2DPlotOptions &options,
                            const wxSize &size)
-    : m_options(options),
+    : wxChart(size), m_options(options),
       m_grid(
           wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
           size,
@@ -202,59 +508,71 @@ const wxMath2DPlotOptions& wxMath2DPlot::GetOptions() const
     return m_options;
 }
 
-void wxMath2DPlot::Save(const wxString &filename,
-                        const wxBitmapType &type,
-                        const wxSize &size)
+bool wxMath2DPlot::Scale(int coeff)
 {
-    wxBitmap bmp(size.GetWidth(), size.GetHeight());
-    wxMemoryDC mdc(bmp);
-    mdc.Clear();
-    wxGraphicsContext* gc = wxGraphicsContext::Create(mdc);
-    if (gc)
+    if (!m_grid.Scale(coeff))
     {
-        DoDraw(*gc);
-        bmp.SaveFile(filename, type);
-        delete gc;
+        return false;
     }
+    Invalidate();
+    return true;
 }
 
-bool wxMath2DPlot::Scale(int coeff)
+void wxMath2DPlot::Shift(double dx,double dy)
 {
-    return m_grid.Scale(coeff);
+    m_grid.Shift(dx,-dy);
+    Invalidate();
 }
 
-void wxMath2DPlot::Shift(double dx,double dy)
+void wxMath2DPlot::AppendValues(size_t datasetIndex,
+                                const wxVector<wxPoint2DDouble> &values)
 {
-    m_grid.Shift(dx,-dy);
+    wxCHECK_RET(datasetIndex < m_datasets.size(), "Invalid dataset index");
+
+    Dataset &dataset = *m_datasets[datasetIndex];
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        dataset.AppendValue(values[i]);
+    }
+
+    m_valuesChanged = true;
+    Invalidate();
+}
+
+size_t wxMath2DPlot::GetCapacity() const
+{
+    return m_capacity;
+}
+
+void wxMath2DPlot::SetCapacity(size_t capacity)
+{
+    m_capacity = capacity;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        m_datasets[i]->SetCapacity(capacity);
+    }
+
+    // Some points may no longer exist, the index will be
+    // rebuilt by the next DoFit
+    m_xIndices.clear();
+    ResetActiveElements();
+
+    m_valuesChanged = true;
+    Invalidate();
 }
 
 void wxMath2DPlot::Initialize(const wxMath2DPlotData &data)
 {
+    m_capacity = 0;
+    m_valuesChanged = false;
 
     const wxVector<wxMath2DPlotDataset::ptr>& datasets = data.GetDatasets();
     for (size_t i = 0; i < datasets.size(); ++i)
     {
-
-        Dataset::ptr newDataset(new Dataset(datasets[i]->ShowDots(),datasets[i]->ShowLine(),
-                                            datasets[i]->GetLineColor(),datasets[i]->GetType()));
-
-        const wxVector<wxPoint2DDouble>& datasetData = datasets[i]->GetData();
-        for (size_t j = 0; j < datasetData.size(); ++j)
-        {
-            std::stringstream tooltip;
-            tooltip << "(" << datasetData[j].m_x << "," << datasetData[j].m_y << ")";
-            wxChartTooltipProvider::ptr tooltipProvider(
-                new wxChartTooltipProviderStatic("", tooltip.str(), datasets[i]->GetLineColor())
-            );
-
-            Point::ptr point(
-                new Point(datasetData[j], tooltipProvider, 20 + j * 10, 0,
-                          m_options.GetDotRadius(), m_options.GetDotStrokeWidth(),
-                          datasets[i]->GetDotStrokeColor(), datasets[i]->GetDotColor(),
-                          m_options.GetHitDetectionRange()));
-
-            newDataset->AppendPoint(point);
-        }
+        Dataset::ptr newDataset(new Dataset(*datasets[i],
+            m_options.GetDotRadius(), m_options.GetHitDetectionRange(),
+            wxChartPointOptions(m_options.GetDotStrokeWidth(),
+                datasets[i]->GetDotStrokeColor(), datasets[i]->GetDotColor())));
 
         m_datasets.push_back(newDataset);
     }
@@ -360,6 +678,54 @@ wxDouble wxMath2DPlot::GetMaxYValue(const wxVector<wxMath2DPlotDataset::ptr>& da
     return result;
 }
 
+void wxMath2DPlot::UpdateGrid()
+{
+    if (!m_valuesChanged)
+    {
+        return;
+    }
+    m_valuesChanged = false;
+
+    wxDouble minXValue = 0;
+    wxDouble maxXValue = 0;
+    wxDouble minYValue = 0;
+    wxDouble maxYValue = 0;
+    bool foundValue = false;
+
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        const wxChartSlidingMinMax &xRange = m_datasets[i]->GetXRange();
+        const wxChartSlidingMinMax &yRange = m_datasets[i]->GetYRange();
+        if (xRange.IsEmpty())
+        {
+            continue;
+        }
+
+        if (!foundValue)
+        {
+            minXValue = xRange.GetMin();
+            maxXValue = xRange.GetMax();
+            minYValue = yRange.GetMin();
+            maxYValue = yRange.GetMax();
+            foundValue = true;
+        }
+        else
+        {
+            minXValue = std::min(minXValue, xRange.GetMin());
+            maxXValue = std::max(maxXValue, xRange.GetMax());
+            minYValue = std::min(minYValue, yRange.GetMin());
+            maxYValue = std::max(maxYValue, yRange.GetMax());
+        }
+    }
+
+    if (foundValue)
+    {
+        // This only rebuilds the axes whose tick
+        // marks need to change
+        m_grid.SetRange(minXValue, maxXValue, minYValue, maxYValue);
+    }
+}
+
 void wxMath2DPlot::DoSetSize(const wxSize &size)
 {
     wxSize newSize(
@@ -371,75 +737,203 @@ void wxMath2DPlot::DoSetSize(const wxSize &size)
 
 void wxMath2DPlot::DoFit()
 {
+    // The lines are downsampled here rather than in DoDraw
+    // so that it is only done when the layout changes
+    const size_t threshold = wxChartDownsampling::GetThreshold(m_grid.GetMapping().GetSize().GetWidth());
+
+    const wxChartNumericalAxis &xAxis = static_cast<const wxChartNumericalAxis&>(m_grid.GetMapping().GetXAxis());
+
+    wxChartThreadPool *pool = GetFitPool(GetNumberOfValues());
+
+    m_xIndices.resize(m_datasets.size());
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        Dataset &dataset = *m_datasets[i];
+        m_xIndices[i].Clear();
+
+        if (dataset.IsSorted())
         {
-            const Point::ptr& point = points[j];
-            point->SetPosition(m_grid.GetMapping().GetWindowPosition(point->GetValue().m_x, point->GetValue().m_y));
+            // Only the points that are visible are positioned
+            // so zooming in on a large dataset costs about the
+            // same as plotting the visible points. The other
+            // points can't be hit.
+            dataset.UpdateVisibleLine(m_grid.GetMapping(), xAxis.GetMinValue(),
+                xAxis.GetMaxValue(), m_options.GetDownsamplingMode(), threshold,
+                pool);
+        }
+        else
+        {
+            dataset.UpdateLine(m_grid.GetMapping(),
+                m_options.GetDownsamplingMode(), threshold, pool);
+        }
+
+        const wxChartPointSeries& points = dataset.GetPoints();
+        const wxVector<size_t>& visibleIndices = dataset.GetVisibleIndices();
+        if (visibleIndices.empty())
+        {
+            for (size_t j = 0; j < points.GetCount(); ++j)
+            {
+                m_xIndices[i].Add(points.GetPosition(j).m_x);
+            }
+        }
+        else
+        {
+            for (size_t j = 0; j < visibleIndices.size(); ++j)
+            {
+                m_xIndices[i].Add(points.GetPosition(visibleIndices[j]).m_x);
+            }
         }
     }
 }
 
-void wxMath2DPlot::DoDraw(wxGraphicsContext &gc)
+// Clips a segment to a rectangle using the Liang-Barsky
+// algorithm. Returns false if the segment is entirely
+// outside of the rectangle.
+static bool ClipSegment(const wxRect2DDouble &clip,
+                        wxPoint2DDouble &start,
+                        wxPoint2DDouble &end)
+{
+    const wxDouble dx = end.m_x - start.m_x;
+    const wxDouble dy = end.m_y - start.m_y;
+    const wxDouble p[4] = { -dx, dx, -dy, dy };
+    const wxDouble q[4] = {
+        start.m_x - clip.GetLeft(),
+        clip.GetRight() - start.m_x,
+        start.m_y - clip.GetTop(),
+        clip.GetBottom() - start.m_y
+    };
+
+    wxDouble t0 = 0;
+    wxDouble t1 = 1;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        if (p[i] == 0)
+        {
+            // Parallel to this edge
+            if (q[i] < 0)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            wxDouble t = q[i] / p[i];
+            if (p[i] < 0)
+            {
+                if (t > t1)
+                {
+                    return false;
+                }
+                t0 = std::max(t0, t);
+            }
+            else
+            {
+                if (t < t0)
+                {
+                    return false;
+                }
+                t1 = std::min(t1, t);
+            }
+        }
+    }
+
+    const wxPoint2DDouble origin = start;
+    if (t0 > 0)
+    {
+        start = wxPoint2DDouble(origin.m_x + (t0 * dx), origin.m_y + (t0 * dy));
+    }
+    if (t1 < 1)
+    {
+        end = wxPoint2DDouble(origin.m_x + (t1 * dx), origin.m_y + (t1 * dy));
+    }
+    return true;
+}
+
+// Adds the visible part of a segment to a path. The
+// subpath is only restarted if the segment doesn't
+// continue from the end of the previous one.
+static void AddClippedSegment(wxGraphicsPath &path,
+                              const wxRect2DDouble &clip,
+                              wxPoint2DDouble start,
+                              wxPoint2DDouble end,
+                              wxPoint2DDouble &currentPoint,
+                              bool &hasCurrentPoint)
 {
+    if (!ClipSegment(clip, start, end))
+    {
+        return;
+    }
+    if (!hasCurrentPoint || (start != currentPoint))
+    {
+        path.MoveToPoint(start);
+    }
+    path.AddLineToPoint(end);
+    currentPoint = end;
+    hasCurrentPoint = true;
+}
 
-    m_grid.Draw(gc);
+void wxMath2DPlot::DoDraw(wxGraphicsContext &gc)
+{
+    UpdateGrid();
+    m_grid.Draw(gc, GetGraphicsCache());
     Fit();
 
+    // Nothing outside of the axes is visible so the
+    // segments are clipped to the plot area. This also
+    // keeps the coordinates given to the renderer small
+    // when zoomed in.
+    const wxRect2DDouble plotArea = m_grid.GetMapping().GetPlotArea();
+
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
+        const Dataset &dataset = *m_datasets[i];
+        const wxChartRingBuffer<wxPoint2DDouble>& values = dataset.GetValues();
+        const wxChartPointSeries& points = dataset.GetPoints();
+        const wxVector<size_t>& visibleIndices = dataset.GetVisibleIndices();
+        // For stem charts this is never downsampled so it
+        // matches the visible points
+        const wxVector<wxPoint2DDouble>& line = dataset.GetLine();
 
         wxGraphicsPath path = gc.CreatePath();
+        wxPoint2DDouble currentPoint;
+        bool hasCurrentPoint = false;
 
-        if (points.size() > 0)
+        if (dataset.GetType() == wxCHARTTYPE_STEM)
         {
-            const Point::ptr& point = points[0];
-            auto value = point->GetValue();
-
-            wxPoint2DDouble firstPosition = m_grid.GetMapping().GetWindowPosition(value.m_x,value.m_y);
-            path.MoveToPoint(firstPosition);
-
-            wxPoint2DDouble lastPosition;
-            for (size_t j = 1; j < points.size(); ++j)
+            for (size_t j = 0; j < line.size(); ++j)
             {
-                const Point::ptr& point = points[j];
-                value = point->GetValue();
-                lastPosition =  m_grid.GetMapping().GetWindowPosition(value.m_x,value.m_y );
-
-                if(m_datasets[i]->GetType()==wxCHARTTYPE_STEPPED)
-                {
-                    wxDouble y = value.m_y;
-                    value = points[j-1]->GetValue();
-                    value = m_grid.GetMapping().GetWindowPosition(value.m_x,y);
-                    path.AddLineToPoint(value);
-                }
-
-                if(m_datasets[i]->GetType()==wxCHARTTYPE_STEM)
+                size_t index = visibleIndices.empty() ? j : visibleIndices[j];
+                AddClippedSegment(path, plotArea, line[j],
+                    m_grid.GetMapping().GetWindowPosition(values[index].m_x, 0),
+                    currentPoint, hasCurrentPoint);
+            }
+        }
+        else
+        {
+            for (size_t j = 1; j < line.size(); ++j)
+            {
+                if (dataset.GetType() == wxCHARTTYPE_STEPPED)
                 {
-                    value = points[j-1]->GetValue();
-                    value = m_grid.GetMapping().GetWindowPosition(value.m_x,0);
-                    path.AddLineToPoint(value);
-                    path.MoveToPoint(lastPosition);
-                    if(j+1==points.size())
-                    {
-                        value = points[j]->GetValue();
-                        value = m_grid.GetMapping().GetWindowPosition(value.m_x,0);
-                        path.AddLineToPoint(value);
-                    }
+                    wxPoint2DDouble corner(line[j - 1].m_x, line[j].m_y);
+                    AddClippedSegment(path, plotArea, line[j - 1], corner,
+                        currentPoint, hasCurrentPoint);
+                    AddClippedSegment(path, plotArea, corner, line[j],
+                        currentPoint, hasCurrentPoint);
                 }
                 else
                 {
-                    path.AddLineToPoint(lastPosition);
+                    AddClippedSegment(path, plotArea, line[j - 1], line[j],
+                        currentPoint, hasCurrentPoint);
                 }
             }
+        }
 
-            if (m_datasets[i]->ShowLine())
+        if (hasCurrentPoint)
+        {
+            if (dataset.ShowLine())
             {
-                wxPen pen(m_datasets[i]->GetLineColor(), m_options.GetLineWidth());
-                gc.SetPen(pen);
+                gc.SetPen(GetGraphicsCache().GetPen(gc, dataset.GetLineColor(),
+                    m_options.GetLineWidth()));
             }
             else
             {
@@ -449,29 +943,63 @@ void wxMath2DPlot::DoDraw(wxGraphicsContext &gc)
             gc.StrokePath(path);
         }
 
-        if (m_datasets[i]->ShowDots())
+        if (dataset.ShowDots())
         {
-            for (size_t j = 0; j < points.size(); ++j)
+            wxChartBatchRenderer renderer(gc, GetGraphicsCache());
+            if (visibleIndices.empty())
+            {
+                points.Draw(renderer, plotArea);
+            }
+            else
             {
-                points[j]->Draw(gc);
+                points.Draw(renderer, visibleIndices, plotArea);
             }
         }
     }
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxMath2DPlot::GetActiveElements(const wxPoint &point)
+void wxMath2DPlot::GetActiveElements(const wxPoint &point,
+                                     wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
-    for (size_t i = 0; i < m_datasets.size(); ++i)
+    m_activePoints.StartPass();
+    for (size_t i = 0; i < m_xIndices.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        m_hitPoints.clear();
+        m_xIndices[i].Query(point.x, m_options.GetHitDetectionRange(), m_hitPoints);
+
+        // When only some of the points have been positioned
+        // the index only contains those points
+        const wxVector<size_t>& visibleIndices = m_datasets[i]->GetVisibleIndices();
+        for (size_t j = 0; j < m_hitPoints.size(); ++j)
         {
-            if (points[j]->HitTest(point))
+            size_t index = m_hitPoints[j];
+            if (!visibleIndices.empty())
             {
-                activeElements->push_back(points[j].get());
+                index = visibleIndices[index];
             }
+            activeElements.push_back(GetActivePoint(i, index));
         }
     }
-    return activeElements;
+}
+
+const wxChartElement* wxMath2DPlot::GetActivePoint(size_t datasetIndex,
+                                                   size_t index)
+{
+    const wxChartElement *point = m_activePoints.Get(datasetIndex, index);
+    if (!point)
+    {
+        point = m_activePoints.Add(datasetIndex, index,
+            new Point(*m_datasets[datasetIndex], index));
+    }
+    return point;
+}
+
+size_t wxMath2DPlot::GetNumberOfValues() const
+{
+    size_t result = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        result += m_datasets[i]->GetValues().GetCount();
+    }
+    return result;
 }
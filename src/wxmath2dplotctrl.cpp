@@ -61,6 +61,19 @@ wxMath2DPlotCtrl::wxMath2DPlotCtrl(wxWindow *parent,
     CreateContextMenu();
 }
 
+void wxMath2DPlotCtrl::AppendValues(size_t datasetIndex,
+                                    const wxVector<wxPoint2DDouble> &values)
+{
+    m_math2dPlot.AppendValues(datasetIndex, values);
+    Refresh();
+}
+
+void wxMath2DPlotCtrl::SetCapacity(size_t capacity)
+{
+    m_math2dPlot.SetCapacity(capacity);
+    Refresh();
+}
+
 wxMath2DPlot& wxMath2DPlotCtrl::GetChart()
 {
     return m_math2dPlot;
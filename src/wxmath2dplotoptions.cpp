@@ -24,7 +24,8 @@
 
 wxMath2DPlotOptions::wxMath2DPlotOptions()
     : m_dotRadius(4), m_dotStrokeWidth(1),
-    m_lineWidth(2), m_hitDetectionRange(24)
+    m_lineWidth(2), m_hitDetectionRange(24),
+    m_downsamplingMode(wxCHARTDOWNSAMPLINGMODE_NONE)
 {
     GetMultiTooltipOptions().SetShowTitle(false);
     GetMultiTooltipOptions().SetAlignment(wxALIGN_TOP);
@@ -59,3 +60,13 @@ wxDouble wxMath2DPlotOptions::GetHitDetectionRange() const
 {
     return m_hitDetectionRange;
 }
+
+wxChartDownsamplingMode wxMath2DPlotOptions::GetDownsamplingMode() const
+{
+    return m_downsamplingMode;
+}
+
+void wxMath2DPlotOptions::SetDownsamplingMode(wxChartDownsamplingMode mode)
+{
+    m_downsamplingMode = mode;
+}
@@ -70,14 +70,41 @@ const wxVector<wxChartOHLCData>& wxOHLCChartData::GetData() const
     return m_data;
 }
 
+wxOHLCChart::TooltipProvider::TooltipProvider(const wxSharedPtr<wxOHLCChartData> data)
+    : m_data(data)
+{
+}
+
+wxString wxOHLCChart::TooltipProvider::GetTooltipTitle(size_t index) const
+{
+    return m_data->GetLabels()[index];
+}
+
+wxString wxOHLCChart::TooltipProvider::GetTooltipText(size_t index) const
+{
+    std::stringstream tooltip;
+    tooltip << "O: " << m_data->GetData()[index].GetOpenValue()
+        << "\r\nH: " << m_data->GetData()[index].GetHighValue()
+        << "\r\nL: " << m_data->GetData()[index].GetLowValue()
+        << "\r\nC: " << m_data->GetData()[index].GetCloseValue();
+    return tooltip.str();
+}
+
+wxColor wxOHLCChart::TooltipProvider::GetAssociatedColor(size_t index) const
+{
+    return *wxWHITE;
+}
+
 wxOHLCChart::OHLDCLines::OHLDCLines(const wxChartOHLCData &data,
                                     unsigned int lineWidth,
                                     const wxColor& upLineColor,
                                     const wxColor& downLineColor,
                                     unsigned int openLineLength,
                                     unsigned int closeLineLength,
-                                    const wxChartTooltipProvider::ptr tooltipProvider)
-    : wxChartElement(tooltipProvider), m_data(data), m_lowPoint(0, 0), m_highPoint(0, 0),
+                                    const wxChartDatasetTooltipProvider::ptr tooltipProvider,
+                                    size_t index)
+    : wxChartElement(wxChartTooltipProvider::ptr()), m_data(data),
+    m_tooltipProvider(tooltipProvider), m_index(index), m_lowPoint(0, 0), m_highPoint(0, 0),
     m_openPoint(0, 0), m_closePoint(0, 0), m_lineWidth(lineWidth),
     m_upLineColor(upLineColor), m_downLineColor(downLineColor),
     m_openLineLength(openLineLength), m_closeLineLength(closeLineLength)
@@ -91,34 +118,30 @@ bool wxOHLCChart::OHLDCLines::HitTest(const wxPoint &point) const
         (point.x <= (m_lowPoint.m_x + m_closeLineLength)));
 }
 
+const wxChartTooltipProvider::ptr wxOHLCChart::OHLDCLines::GetTooltipProvider() const
+{
+    return wxChartTooltipProvider::ptr(new wxChartTooltipProviderDatasetItem(m_tooltipProvider, m_index));
+}
+
 wxPoint2DDouble wxOHLCChart::OHLDCLines::GetTooltipPosition() const
 {
     return wxPoint2DDouble(m_lowPoint.m_x, m_highPoint.m_y + (m_lowPoint.m_y - m_highPoint.m_y) / 2);
 }
 
-void wxOHLCChart::OHLDCLines::Draw(wxGraphicsContext &gc)
+bool wxOHLCChart::OHLDCLines::IsUp() const
 {
-    wxGraphicsPath path = gc.CreatePath();
-    path.MoveToPoint(m_highPoint);
-    path.AddLineToPoint(m_lowPoint);
-
-    path.MoveToPoint(wxPoint2DDouble(m_openPoint.m_x - m_openLineLength, m_openPoint.m_y));
-    path.AddLineToPoint(m_openPoint);
+    return (m_data.GetCloseValue() >= m_data.GetOpenValue());
+}
 
-    path.MoveToPoint(m_closePoint);
-    path.AddLineToPoint(wxPoint2DDouble(m_closePoint.m_x + m_closeLineLength, m_closePoint.m_y));
+void wxOHLCChart::OHLDCLines::Draw(wxChartBatchRenderer &renderer) const
+{
+    renderer.SetStrokeStyle(IsUp() ? m_upLineColor : m_downLineColor, m_lineWidth);
 
-    if (m_data.GetCloseValue() >= m_data.GetOpenValue())
-    {
-        wxPen pen(m_upLineColor, m_lineWidth);
-        gc.SetPen(pen);
-    }
-    else
-    {
-        wxPen pen(m_downLineColor, m_lineWidth);
-        gc.SetPen(pen);
-    }
-    gc.StrokePath(path);
+    renderer.AddLine(m_highPoint, m_lowPoint);
+    renderer.AddLine(wxPoint2DDouble(m_openPoint.m_x - m_openLineLength, m_openPoint.m_y),
+        m_openPoint);
+    renderer.AddLine(m_closePoint,
+        wxPoint2DDouble(m_closePoint.m_x + m_closeLineLength, m_closePoint.m_y));
 }
 
 void wxOHLCChart::OHLDCLines::Update(const wxChartGridMapping& mapping,
@@ -132,22 +155,17 @@ void wxOHLCChart::OHLDCLines::Update(const wxChartGridMapping& mapping,
 
 wxOHLCChart::wxOHLCChart(const wxOHLCChartData &data,
                          const wxSize &size)
-    : m_grid(
+    : wxChart(size), m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetTop()),
         size, data.GetLabels(), GetMinValue(data), GetMaxValue(data), m_options.GetGridOptions()
         )
 {
+    wxChartDatasetTooltipProvider::ptr tooltipProvider(
+        new TooltipProvider(wxSharedPtr<wxOHLCChartData>(new wxOHLCChartData(data)))
+        );
+
     for (size_t i = 0; i < data.GetData().size(); ++i)
     {
-        std::stringstream tooltip;
-        tooltip << "O: " << data.GetData()[i].GetOpenValue()
-            << "\r\nH: " << data.GetData()[i].GetHighValue()
-            << "\r\nL: " << data.GetData()[i].GetLowValue()
-            << "\r\nC: " << data.GetData()[i].GetCloseValue();
-        wxChartTooltipProvider::ptr tooltipProvider(
-            new wxChartTooltipProviderStatic(data.GetLabels()[i], tooltip.str(), *wxWHITE)
-            );
-
         OHLDCLines::ptr newOHLCLines(new OHLDCLines(
             data.GetData()[i],
             data.GetLineWidth(),
@@ -155,7 +173,8 @@ wxOHLCChart::wxOHLCChart(const wxOHLCChartData &data,
             data.GetDownLineColor(),
             data.GetOpenLineLength(),
             data.GetCloseLineLength(),
-            tooltipProvider
+            tooltipProvider,
+            i
             ));
         m_data.push_back(newOHLCLines);
     }
@@ -227,25 +246,38 @@ void wxOHLCChart::DoFit()
 
 void wxOHLCChart::DoDraw(wxGraphicsContext &gc)
 {
-    m_grid.Draw(gc);
+    m_grid.Draw(gc, GetGraphicsCache());
 
     Fit();
 
+    // The lines of different values don't overlap so all the
+    // rising ones are drawn first and then all the falling
+    // ones, which only takes two batches
+    wxChartBatchRenderer renderer(gc, GetGraphicsCache());
+    for (size_t i = 0; i < m_data.size(); ++i)
+    {
+        if (m_data[i]->IsUp())
+        {
+            m_data[i]->Draw(renderer);
+        }
+    }
     for (size_t i = 0; i < m_data.size(); ++i)
     {
-        m_data[i]->Draw(gc);
+        if (!m_data[i]->IsUp())
+        {
+            m_data[i]->Draw(renderer);
+        }
     }
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxOHLCChart::GetActiveElements(const wxPoint &point)
+void wxOHLCChart::GetActiveElements(const wxPoint &point,
+                                    wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
     for (size_t i = 0; i < m_data.size(); ++i)
     {
         if (m_data[i]->HitTest(point))
         {
-            activeElements->push_back(m_data[i].get());
+            activeElements.push_back(m_data[i].get());
         }
     }
-    return activeElements;
 }
@@ -38,6 +38,7 @@ const wxVector<wxChartSliceData>& wxPieChartData::GetSlices() const
 
 wxPieChart::wxPieChart(const wxPieChartData &data,
                        const wxSize &size)
+    : wxDoughnutAndPieChartBase(size)
 {
     Initialize(data, size);
 }
@@ -45,7 +46,7 @@ wxPieChart::wxPieChart(const wxPieChartData &data,
 wxPieChart::wxPieChart(const wxPieChartData &data,
                        const wxPieChartOptions &options,
                        const wxSize &size)
-    : m_options(options)
+    : wxDoughnutAndPieChartBase(size), m_options(options)
 {
     Initialize(data, size);
 }
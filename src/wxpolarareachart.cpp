@@ -75,7 +75,7 @@ wxDouble wxPolarAreaChart::SliceArc::GetValue() const
 
 wxPolarAreaChart::wxPolarAreaChart(const wxPolarAreaChartData &data,
                                    const wxSize &size)
-    : m_grid(size, GetMinValue(data.GetSlices()), GetMaxValue(data.GetSlices()),
+    : wxChart(size), m_grid(size, GetMinValue(data.GetSlices()), GetMaxValue(data.GetSlices()),
         m_options.GetGridOptions())
 {
     const wxVector<wxChartSliceData>& slices = data.GetSlices();
@@ -88,7 +88,7 @@ wxPolarAreaChart::wxPolarAreaChart(const wxPolarAreaChartData &data,
 wxPolarAreaChart::wxPolarAreaChart(const wxPolarAreaChartData &data,
                                    const wxPolarAreaChartOptions &options,
                                    const wxSize &size)
-    : m_options(options),
+    : wxChart(size), m_options(options),
     m_grid(size, GetMinValue(data.GetSlices()), GetMaxValue(data.GetSlices()),
         m_options.GetGridOptions())
 {
@@ -178,6 +178,11 @@ void wxPolarAreaChart::DoFit()
     wxDouble startAngle = m_options.GetStartAngle();
     wxDouble angleIncrement = ((2 * M_PI) / m_slices.size());
 
+    if (!m_slices.empty())
+    {
+        m_index.Clear(m_slices[0]->GetCenter());
+    }
+
     for (size_t i = 0; i < m_slices.size(); ++i)
     {
         SliceArc& currentSlice = *m_slices[i];
@@ -185,6 +190,7 @@ void wxPolarAreaChart::DoFit()
         wxDouble endAngle = startAngle + angleIncrement;
         currentSlice.SetAngles(startAngle, endAngle);
         currentSlice.SetRadiuses(m_grid.GetRadius(currentSlice.GetValue()), 0);
+        m_index.Add(&currentSlice, startAngle, endAngle);
         startAngle = endAngle;
     }
 }
@@ -193,23 +199,19 @@ void wxPolarAreaChart::DoDraw(wxGraphicsContext &gc)
 {
     Fit();
 
-    for (size_t i = 0; i < m_slices.size(); ++i)
     {
-        m_slices[i]->Draw(gc);
+        wxChartBatchRenderer renderer(gc, GetGraphicsCache());
+        for (size_t i = 0; i < m_slices.size(); ++i)
+        {
+            m_slices[i]->Draw(renderer);
+        }
     }
 
-    m_grid.Draw(gc);
+    m_grid.Draw(gc, GetGraphicsCache());
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxPolarAreaChart::GetActiveElements(const wxPoint &point)
+void wxPolarAreaChart::GetActiveElements(const wxPoint &point,
+                                         wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
-    for (size_t i = 0; i < m_slices.size(); ++i)
-    {
-        if (m_slices[i]->HitTest(point))
-        {
-            activeElements->push_back(m_slices[i].get());
-        }
-    }
-    return activeElements;
+    m_index.Query(point, activeElements);
 }
@@ -44,7 +44,7 @@ const wxVector<wxString>& wxRadarChartData::GetLabels() const
 };
 
 wxRadarChart::wxRadarChart(const wxSize &size)
-    : m_grid(size, GetMinValue(), GetMaxValue(),
+    : wxChart(size), m_grid(size, GetMinValue(), GetMaxValue(),
         m_options.GetGridOptions())
 {
 }
@@ -77,11 +77,10 @@ void wxRadarChart::DoFit()
 
 void wxRadarChart::DoDraw(wxGraphicsContext &gc)
 {
-    m_grid.Draw(gc);
+    m_grid.Draw(gc, GetGraphicsCache());
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxRadarChart::GetActiveElements(const wxPoint &point)
+void wxRadarChart::GetActiveElements(const wxPoint &point,
+                                     wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
-    return activeElements;
 }
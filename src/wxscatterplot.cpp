@@ -23,6 +23,7 @@
 /// @file
 
 #include "wxscatterplot.h"
+#include "wxchartthreadpool.h"
 #include <sstream>
 
 wxScatterPlotDataset::wxScatterPlotDataset(const wxColor& fillColor,
@@ -61,44 +62,166 @@ const wxVector<wxScatterPlotDataset::ptr>& wxScatterPlotData::GetDatasets() cons
     return m_datasets;
 }
 
-wxScatterPlot::Point::Point(wxPoint2DDouble value,
-                            const wxChartTooltipProvider::ptr tooltipProvider,
-                            wxDouble x,
-                            wxDouble y,
-                            const wxChartPointOptions &options)
-    : wxChartPoint(x, y, 5, 20, tooltipProvider, options), m_value(value)
+wxScatterPlot::TooltipProvider::TooltipProvider(const wxScatterPlotDataset::ptr dataset)
+    : m_dataset(dataset)
 {
 }
 
-wxPoint2DDouble wxScatterPlot::Point::GetTooltipPosition() const
+wxString wxScatterPlot::TooltipProvider::GetTooltipTitle(size_t index) const
 {
-    wxPoint2DDouble position = wxChartPoint::GetTooltipPosition();
-    position.m_y -= 10;
-    return position;
+    return "";
 }
 
-wxPoint2DDouble wxScatterPlot::Point::GetValue() const
+wxString wxScatterPlot::TooltipProvider::GetTooltipText(size_t index) const
 {
-    return m_value;
+    std::stringstream tooltip;
+    tooltip << "(" << m_dataset->GetData()[index].m_x << "," << m_dataset->GetData()[index].m_y << ")";
+    return tooltip.str();
 }
 
-wxScatterPlot::Dataset::Dataset()
+wxColor wxScatterPlot::TooltipProvider::GetAssociatedColor(size_t index) const
 {
+    return m_dataset->GetFillColor();
 }
 
-const wxVector<wxScatterPlot::Point::ptr>& wxScatterPlot::Dataset::GetPoints() const
+wxScatterPlot::Dataset::Dataset(const wxScatterPlotDataset::ptr data,
+    const wxChartDatasetTooltipProvider::ptr tooltipProvider,
+    wxDouble dotRadius,
+    wxDouble hitDetectionRange,
+    const wxChartPointOptions &dotOptions)
+    : m_data(data),
+    m_tooltipProvider(tooltipProvider),
+    m_points(data->GetData().size(), dotRadius, hitDetectionRange, dotOptions),
+    m_markerSprite(dotRadius, dotOptions)
+{
+}
+
+const wxVector<wxPoint2DDouble>& wxScatterPlot::Dataset::GetValues() const
+{
+    return m_data->GetData();
+}
+
+const wxChartDatasetTooltipProvider::ptr& wxScatterPlot::Dataset::GetTooltipProvider() const
+{
+    return m_tooltipProvider;
+}
+
+const wxChartPointSeries& wxScatterPlot::Dataset::GetPoints() const
 {
     return m_points;
 }
 
-void wxScatterPlot::Dataset::AppendPoint(Point::ptr point)
+wxChartPointSeries& wxScatterPlot::Dataset::GetPoints()
+{
+    return m_points;
+}
+
+wxChartMarkerSprite& wxScatterPlot::Dataset::GetMarkerSprite()
+{
+    return m_markerSprite;
+}
+
+// Maps the values of a dataset to window positions
+class wxScatterPlot::PositionLoop : public wxChartThreadPool::Loop
+{
+public:
+    PositionLoop(const wxChartGridMapping &mapping,
+        const wxVector<wxPoint2DDouble> &values,
+        wxVector<wxPoint2DDouble> &positions)
+        : m_mapping(mapping), m_values(values), m_positions(positions)
+    {
+    }
+
+    virtual void Run(size_t begin, size_t end) wxOVERRIDE
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_positions[i] = m_mapping.GetWindowPosition(m_values[i].m_x, m_values[i].m_y);
+        }
+    }
+
+private:
+    const wxChartGridMapping &m_mapping;
+    const wxVector<wxPoint2DDouble> &m_values;
+    wxVector<wxPoint2DDouble> &m_positions;
+};
+
+wxScatterPlot::Layout::Layout(const wxChartGridMapping &mapping,
+                              const wxVector<Dataset::ptr> &datasets,
+                              wxChartThreadPool *pool)
+    : m_mapping(mapping), m_datasets(datasets), m_pool(pool),
+    m_positions(datasets.size())
+{
+}
+
+void wxScatterPlot::Layout::Compute()
+{
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        const wxVector<wxPoint2DDouble>& values = m_datasets[i]->GetValues();
+        m_positions[i].resize(values.size());
+        PositionLoop loop(m_mapping, values, m_positions[i]);
+        if (m_pool)
+        {
+            m_pool->RunLoop(loop, values.size());
+        }
+        else
+        {
+            loop.Run(0, values.size());
+        }
+    }
+
+    // The index is filled by a single thread so that
+    // the items are always added in the same order
+    m_index.Clear();
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        wxDouble hitDetectionRange = m_datasets[i]->GetPoints().GetHitDetectionRange();
+        const wxVector<wxPoint2DDouble>& positions = m_positions[i];
+        for (size_t j = 0; j < positions.size(); ++j)
+        {
+            m_index.Add(positions[j], hitDetectionRange);
+        }
+    }
+    m_index.Build();
+}
+
+wxVector<wxPoint2DDouble>& wxScatterPlot::Layout::GetPositions(size_t datasetIndex)
+{
+    return m_positions[datasetIndex];
+}
+
+wxChartSpatialIndex& wxScatterPlot::Layout::GetIndex()
 {
-    m_points.push_back(point);
+    return m_index;
+}
+
+wxScatterPlot::Point::Point(const Dataset &dataset,
+                            size_t index)
+    : m_dataset(dataset), m_index(index)
+{
+}
+
+bool wxScatterPlot::Point::HitTest(const wxPoint &point) const
+{
+    return m_dataset.GetPoints().HitTest(m_index, point);
+}
+
+wxPoint2DDouble wxScatterPlot::Point::GetTooltipPosition() const
+{
+    wxPoint2DDouble position = m_dataset.GetPoints().GetPosition(m_index);
+    position.m_y -= 10;
+    return position;
+}
+
+const wxChartTooltipProvider::ptr wxScatterPlot::Point::GetTooltipProvider() const
+{
+    return wxChartTooltipProvider::ptr(new wxChartTooltipProviderDatasetItem(m_dataset.GetTooltipProvider(), m_index));
 }
 
 wxScatterPlot::wxScatterPlot(const wxScatterPlotData &data,
                              const wxSize &size)
-    : m_grid(
+    : wxChart(size), m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size,
         GetMinXValue(data.GetDatasets()), GetMaxXValue(data.GetDatasets()),
@@ -112,7 +235,7 @@ wxScatterPlot::wxScatterPlot(const wxScatterPlotData &data,
 wxScatterPlot::wxScatterPlot(const wxScatterPlotData &data,
                              const wxScatterPlotOptions &options, 
                              const wxSize &size)
-    : m_options(options),
+    : wxChart(size), m_options(options),
     m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size,
@@ -134,24 +257,12 @@ void wxScatterPlot::Initialize(const wxScatterPlotData &data)
     const wxVector<wxScatterPlotDataset::ptr>& datasets = data.GetDatasets();
     for (size_t i = 0; i < datasets.size(); ++i)
     {
-        Dataset::ptr newDataset(new Dataset());
+        wxChartDatasetTooltipProvider::ptr tooltipProvider(
+            new TooltipProvider(datasets[i])
+            );
 
-        const wxVector<wxPoint2DDouble>& datasetData = datasets[i]->GetData();
-        for (size_t j = 0; j < datasetData.size(); ++j)
-        {
-            std::stringstream tooltip;
-            tooltip << "(" << datasetData[j].m_x << "," << datasetData[j].m_y << ")";
-            wxChartTooltipProvider::ptr tooltipProvider(
-                new wxChartTooltipProviderStatic("", tooltip.str(), datasets[i]->GetFillColor())
-                );
-
-            Point::ptr point(
-                new Point(datasetData[j], tooltipProvider, 20 + j * 10, 0,
-                    wxChartPointOptions(2, datasets[i]->GetStrokeColor(), datasets[i]->GetFillColor()))
-                );
-
-            newDataset->AppendPoint(point);
-        }
+        Dataset::ptr newDataset(new Dataset(datasets[i], tooltipProvider,
+            5, 20, wxChartPointOptions(2, datasets[i]->GetStrokeColor(), datasets[i]->GetFillColor())));
 
         m_datasets.push_back(newDataset);
     }
@@ -268,46 +379,109 @@ void wxScatterPlot::DoSetSize(const wxSize &size)
 
 void wxScatterPlot::DoFit()
 {
+    Layout layout(m_grid.GetMapping(), m_datasets,
+        GetFitPool(GetNumberOfPoints()));
+    layout.Compute();
+    ApplyLayout(layout);
+}
+
+wxChart::Layout* wxScatterPlot::CreateLayout()
+{
+    const size_t threshold = m_options.GetBackgroundFitThreshold();
+    const size_t numberOfPoints = GetNumberOfPoints();
+    if ((threshold == 0) || (numberOfPoints <= threshold))
+    {
+        return 0;
+    }
+
+    // The grid keeps updating its axes while the
+    // layout is computed
+    return new Layout(m_grid.GetMapping().Clone(), m_datasets,
+        GetFitPool(numberOfPoints));
+}
+
+void wxScatterPlot::ApplyLayout(wxChart::Layout &layout)
+{
+    Layout &scatterLayout = static_cast<Layout&>(layout);
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
-        {
-            const Point::ptr& point = points[j];
-            point->SetPosition(m_grid.GetMapping().GetWindowPosition(point->GetValue().m_x, point->GetValue().m_y));
-        }
+        m_datasets[i]->GetPoints().SwapPositions(scatterLayout.GetPositions(i));
     }
+    m_index.Swap(scatterLayout.GetIndex());
 }
 
 void wxScatterPlot::DoDraw(wxGraphicsContext &gc)
 {
-    m_grid.Draw(gc);
+    m_grid.Draw(gc, GetGraphicsCache());
 
     Fit();
 
+    const size_t spriteThreshold = m_options.GetMarkerSpriteThreshold();
+
+    wxChartBatchRenderer renderer(gc, GetGraphicsCache());
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        const wxChartPointSeries& points = m_datasets[i]->GetPoints();
+        if ((spriteThreshold > 0) && (points.GetCount() > spriteThreshold))
+        {
+            // The previous datasets must be drawn first so
+            // that they stay below this one
+            renderer.Flush();
+            m_datasets[i]->GetMarkerSprite().Draw(gc, points.GetPositions());
+        }
+        else
         {
-            points[j]->Draw(gc);
+            points.Draw(renderer);
         }
     }
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxScatterPlot::GetActiveElements(const wxPoint &point)
+void wxScatterPlot::GetActiveElements(const wxPoint &point,
+                                      wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
-    for (size_t i = 0; i < m_datasets.size(); ++i)
+    m_activePoints.StartPass();
+    m_hitPoints.clear();
+    m_index.Query(point, m_hitPoints);
+
+    // The items of the index are the points of all the
+    // datasets, numbered in order. The query returns them
+    // in increasing order.
+    size_t datasetIndex = 0;
+    size_t firstItem = 0;
+    for (size_t i = 0; i < m_hitPoints.size(); ++i)
     {
-        const wxVector<Point::ptr>& points = m_datasets[i]->GetPoints();
-        for (size_t j = 0; j < points.size(); ++j)
+        while (m_hitPoints[i] >= (firstItem + m_datasets[datasetIndex]->GetPoints().GetCount()))
         {
-            if (points[j]->HitTest(point))
-            {
-                activeElements->push_back(points[j].get());
-            }
+            firstItem += m_datasets[datasetIndex]->GetPoints().GetCount();
+            ++datasetIndex;
+        }
+
+        size_t index = m_hitPoints[i] - firstItem;
+        if (m_datasets[datasetIndex]->GetPoints().HitTest(index, point))
+        {
+            activeElements.push_back(GetActivePoint(datasetIndex, index));
         }
     }
-    return activeElements;
+}
+
+const wxChartElement* wxScatterPlot::GetActivePoint(size_t datasetIndex,
+                                                    size_t index)
+{
+    const wxChartElement *point = m_activePoints.Get(datasetIndex, index);
+    if (!point)
+    {
+        point = m_activePoints.Add(datasetIndex, index,
+            new Point(*m_datasets[datasetIndex], index));
+    }
+    return point;
+}
+
+size_t wxScatterPlot::GetNumberOfPoints() const
+{
+    size_t result = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        result += m_datasets[i]->GetPoints().GetCount();
+    }
+    return result;
 }
@@ -25,6 +25,7 @@
 #include "wxscatterplotoptions.h"
 
 wxScatterPlotOptions::wxScatterPlotOptions()
+    : m_markerSpriteThreshold(10000)
 {
     GetMultiTooltipOptions().SetShowTitle(false);
     GetMultiTooltipOptions().SetAlignment(wxALIGN_TOP);
@@ -34,3 +35,13 @@ const wxChartGridOptions& wxScatterPlotOptions::GetGridOptions() const
 {
 	return m_gridOptions;
 }
+
+size_t wxScatterPlotOptions::GetMarkerSpriteThreshold() const
+{
+	return m_markerSpriteThreshold;
+}
+
+void wxScatterPlotOptions::SetMarkerSpriteThreshold(size_t threshold)
+{
+	m_markerSpriteThreshold = threshold;
+}
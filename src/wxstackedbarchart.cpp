@@ -21,6 +21,7 @@
 */
 
 #include "wxstackedbarchart.h"
+#include "wxchartthreadpool.h"
 #include <sstream>
 
 wxStackedBarChart::Bar::Bar(wxDouble value,
@@ -60,9 +61,110 @@ void wxStackedBarChart::Dataset::AppendBar(Bar::ptr column)
     m_bars.push_back(column);
 }
 
+// Computes the areas of the bars stacked at a range
+// of positions along the X axis
+class wxStackedBarChart::StackLoop : public wxChartThreadPool::Loop
+{
+public:
+    StackLoop(const wxChartGridMapping &mapping,
+        const wxVector<Dataset::ptr> &datasets,
+        const wxVector<size_t> &offsets, wxDouble spacing,
+        wxVector<wxRect2DDouble> &areas)
+        : m_mapping(mapping), m_datasets(datasets), m_offsets(offsets),
+        m_spacing(spacing), m_areas(areas)
+    {
+    }
+
+    virtual void Run(size_t begin, size_t end) wxOVERRIDE
+    {
+        for (size_t j = begin; j < end; ++j)
+        {
+            wxDouble widthOfPreviousDatasets = 0;
+            for (size_t i = 0; i < m_datasets.size(); ++i)
+            {
+                const wxVector<Bar::ptr>& bars = m_datasets[i]->GetBars();
+                if (j >= bars.size())
+                {
+                    continue;
+                }
+                const Bar& bar = *(bars[j]);
+
+                wxPoint2DDouble upperLeftCornerPosition = m_mapping.GetXAxis().GetTickMarkPosition(j + 1);
+                upperLeftCornerPosition.m_x += widthOfPreviousDatasets;
+                upperLeftCornerPosition.m_y += m_spacing;
+                wxPoint2DDouble bottomLeftCornerPosition = m_mapping.GetXAxis().GetTickMarkPosition(j);
+                bottomLeftCornerPosition.m_x += widthOfPreviousDatasets;
+                bottomLeftCornerPosition.m_y -= m_spacing;
+
+                wxPoint2DDouble upperRightCornerPosition = m_mapping.GetWindowPositionAtTickMark(j + 1, bar.GetValue());
+                upperRightCornerPosition.m_x += widthOfPreviousDatasets;
+
+                m_areas[m_offsets[i] + j] = wxRect2DDouble(upperLeftCornerPosition.m_x, upperLeftCornerPosition.m_y,
+                    upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x,
+                    bottomLeftCornerPosition.m_y - upperLeftCornerPosition.m_y);
+
+                widthOfPreviousDatasets += (upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x);
+            }
+        }
+    }
+
+private:
+    const wxChartGridMapping &m_mapping;
+    const wxVector<Dataset::ptr> &m_datasets;
+    // The index in m_areas of the first bar of
+    // each dataset
+    const wxVector<size_t> &m_offsets;
+    wxDouble m_spacing;
+    wxVector<wxRect2DDouble> &m_areas;
+};
+
+wxStackedBarChart::Layout::Layout(const wxChartGridMapping &mapping,
+                                  const wxVector<Dataset::ptr> &datasets,
+                                  wxDouble spacing,
+                                  wxChartThreadPool *pool)
+    : m_mapping(mapping), m_datasets(datasets), m_spacing(spacing),
+    m_pool(pool)
+{
+}
+
+void wxStackedBarChart::Layout::Compute()
+{
+    wxVector<size_t> offsets;
+    size_t numberOfBars = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        offsets.push_back(numberOfBars);
+        numberOfBars += m_datasets[i]->GetBars().size();
+    }
+    m_areas.resize(numberOfBars);
+
+    if (m_datasets.empty())
+    {
+        return;
+    }
+
+    // The bars at different positions along the X
+    // axis don't depend on each other
+    StackLoop loop(m_mapping, m_datasets, offsets, m_spacing, m_areas);
+    const size_t count = m_datasets[0]->GetBars().size();
+    if (m_pool)
+    {
+        m_pool->RunLoop(loop, count);
+    }
+    else
+    {
+        loop.Run(0, count);
+    }
+}
+
+const wxVector<wxRect2DDouble>& wxStackedBarChart::Layout::GetAreas() const
+{
+    return m_areas;
+}
+
 wxStackedBarChart::wxStackedBarChart(const wxBarChartData &data,
                                      const wxSize &size)
-    : m_grid(
+    : wxChart(size), m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size, data.GetLabels(), GetCumulativeMinValue(data.GetDatasets()),
         GetCumulativeMaxValue(data.GetDatasets()), m_options.GetGridOptions()
@@ -105,7 +207,7 @@ wxStackedBarChart::wxStackedBarChart(const wxBarChartData &data,
 wxStackedBarChart::wxStackedBarChart(const wxBarChartData &data,
                                      const wxStackedBarChartOptions &options, 
                                      const wxSize &size)
-    : m_options(options),
+    : wxChart(size), m_options(options),
     m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size, data.GetLabels(), GetCumulativeMinValue(data.GetDatasets()),
@@ -226,58 +328,66 @@ void wxStackedBarChart::DoSetSize(const wxSize &size)
 
 void wxStackedBarChart::DoFit()
 {
-    wxVector<wxDouble> widthOfPreviousDatasets;
-    for (size_t i = 0; i < m_datasets[0]->GetBars().size(); ++i)
+    Layout layout(m_grid.GetMapping(), m_datasets, m_options.GetBarSpacing(),
+        GetFitPool(GetNumberOfBars()));
+    layout.Compute();
+    ApplyLayout(layout);
+}
+
+wxChart::Layout* wxStackedBarChart::CreateLayout()
+{
+    const size_t threshold = m_options.GetBackgroundFitThreshold();
+    const size_t numberOfBars = GetNumberOfBars();
+    if ((threshold == 0) || (numberOfBars <= threshold))
     {
-        widthOfPreviousDatasets.push_back(0);
+        return 0;
     }
 
+    // The grid keeps updating its axes while the
+    // layout is computed
+    return new Layout(m_grid.GetMapping().Clone(), m_datasets,
+        m_options.GetBarSpacing(), GetFitPool(numberOfBars));
+}
+
+void wxStackedBarChart::ApplyLayout(wxChart::Layout &layout)
+{
+    const wxVector<wxRect2DDouble>& areas = static_cast<Layout&>(layout).GetAreas();
+
+    size_t k = 0;
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        Dataset& currentDataset = *m_datasets[i];
-        for (size_t j = 0; j < currentDataset.GetBars().size(); ++j)
+        const wxVector<Bar::ptr>& bars = m_datasets[i]->GetBars();
+        for (size_t j = 0; j < bars.size(); ++j)
         {
-            Bar& bar = *(currentDataset.GetBars()[j]);
-
-            wxPoint2DDouble upperLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(j + 1);
-            upperLeftCornerPosition.m_x += widthOfPreviousDatasets[j];
-            upperLeftCornerPosition.m_y += m_options.GetBarSpacing();
-            wxPoint2DDouble bottomLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(j);
-            bottomLeftCornerPosition.m_x += widthOfPreviousDatasets[j];
-            bottomLeftCornerPosition.m_y -= m_options.GetBarSpacing();
-
-            wxPoint2DDouble upperRightCornerPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(j + 1, bar.GetValue());
-            upperRightCornerPosition.m_x += widthOfPreviousDatasets[j];
-
-            bar.SetPosition(upperLeftCornerPosition);
-            bar.SetSize(upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x,
-                bottomLeftCornerPosition.m_y - upperLeftCornerPosition.m_y);
-
-            widthOfPreviousDatasets[j] += (upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x);
+            const wxRect2DDouble &area = areas[k++];
+            bars[j]->SetPosition(area.GetLeftTop());
+            bars[j]->SetSize(area.m_width, area.m_height);
         }
     }
 }
 
 void wxStackedBarChart::DoDraw(wxGraphicsContext &gc)
 {
-    m_grid.Draw(gc);
+    m_grid.Draw(gc, GetGraphicsCache());
 
     Fit();
 
+    // The bars of a dataset share the same style and are
+    // drawn as one batch
+    wxChartBatchRenderer renderer(gc, GetGraphicsCache());
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
         Dataset& currentDataset = *m_datasets[i];
         for (size_t j = 0; j < currentDataset.GetBars().size(); ++j)
         {
-            currentDataset.GetBars()[j]->Draw(gc);
+            currentDataset.GetBars()[j]->Draw(renderer);
         }
     }
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxStackedBarChart::GetActiveElements(const wxPoint &point)
+void wxStackedBarChart::GetActiveElements(const wxPoint &point,
+                                          wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
-
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
         const wxVector<Bar::ptr>& bars = m_datasets[i]->GetBars();
@@ -285,10 +395,18 @@ wxSharedPtr<wxVector<const wxChartElement*> > wxStackedBarChart::GetActiveElemen
         {
             if (bars[j]->HitTest(point))
             {
-                activeElements->push_back(bars[j].get());
+                activeElements.push_back(bars[j].get());
             }
         }
     }
+}
 
-    return activeElements;
+size_t wxStackedBarChart::GetNumberOfBars() const
+{
+    size_t result = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        result += m_datasets[i]->GetBars().size();
+    }
+    return result;
 }
@@ -32,6 +32,7 @@
 */
 
 #include "wxstackedcolumnchart.h"
+#include "wxchartthreadpool.h"
 #include <sstream>
 
 wxStackedColumnChart::Column::Column(wxDouble value,
@@ -71,9 +72,109 @@ void wxStackedColumnChart::Dataset::AppendColumn(Column::ptr column)
     m_columns.push_back(column);
 }
 
+// Computes the areas of the columns stacked at a range
+// of positions along the X axis
+class wxStackedColumnChart::StackLoop : public wxChartThreadPool::Loop
+{
+public:
+    StackLoop(const wxChartGridMapping &mapping,
+        const wxVector<Dataset::ptr> &datasets,
+        const wxVector<size_t> &offsets, wxDouble spacing,
+        wxVector<wxRect2DDouble> &areas)
+        : m_mapping(mapping), m_datasets(datasets), m_offsets(offsets),
+        m_spacing(spacing), m_areas(areas)
+    {
+    }
+
+    virtual void Run(size_t begin, size_t end) wxOVERRIDE
+    {
+        for (size_t j = begin; j < end; ++j)
+        {
+            wxDouble heightOfPreviousDatasets = 0;
+            for (size_t i = 0; i < m_datasets.size(); ++i)
+            {
+                const wxVector<Column::ptr>& columns = m_datasets[i]->GetColumns();
+                if (j >= columns.size())
+                {
+                    continue;
+                }
+                const Column& column = *(columns[j]);
+
+                wxPoint2DDouble upperLeftCornerPosition = m_mapping.GetWindowPositionAtTickMark(j, column.GetValue());
+                upperLeftCornerPosition.m_x += m_spacing;
+                upperLeftCornerPosition.m_y -= heightOfPreviousDatasets;
+                wxPoint2DDouble upperRightCornerPosition = m_mapping.GetWindowPositionAtTickMark(j + 1, column.GetValue());
+                upperRightCornerPosition.m_x -= m_spacing;
+                upperRightCornerPosition.m_y -= heightOfPreviousDatasets;
+
+                wxPoint2DDouble bottomLeftCornerPosition = m_mapping.GetXAxis().GetTickMarkPosition(j);
+
+                m_areas[m_offsets[i] + j] = wxRect2DDouble(upperLeftCornerPosition.m_x, upperLeftCornerPosition.m_y,
+                    upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x,
+                    (bottomLeftCornerPosition.m_y - heightOfPreviousDatasets) - upperLeftCornerPosition.m_y);
+
+                heightOfPreviousDatasets = bottomLeftCornerPosition.m_y - upperLeftCornerPosition.m_y;
+            }
+        }
+    }
+
+private:
+    const wxChartGridMapping &m_mapping;
+    const wxVector<Dataset::ptr> &m_datasets;
+    // The index in m_areas of the first column of
+    // each dataset
+    const wxVector<size_t> &m_offsets;
+    wxDouble m_spacing;
+    wxVector<wxRect2DDouble> &m_areas;
+};
+
+wxStackedColumnChart::Layout::Layout(const wxChartGridMapping &mapping,
+                                     const wxVector<Dataset::ptr> &datasets,
+                                     wxDouble spacing,
+                                     wxChartThreadPool *pool)
+    : m_mapping(mapping), m_datasets(datasets), m_spacing(spacing),
+    m_pool(pool)
+{
+}
+
+void wxStackedColumnChart::Layout::Compute()
+{
+    wxVector<size_t> offsets;
+    size_t numberOfColumns = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        offsets.push_back(numberOfColumns);
+        numberOfColumns += m_datasets[i]->GetColumns().size();
+    }
+    m_areas.resize(numberOfColumns);
+
+    if (m_datasets.empty())
+    {
+        return;
+    }
+
+    // The columns at different positions along the X
+    // axis don't depend on each other
+    StackLoop loop(m_mapping, m_datasets, offsets, m_spacing, m_areas);
+    const size_t count = m_datasets[0]->GetColumns().size();
+    if (m_pool)
+    {
+        m_pool->RunLoop(loop, count);
+    }
+    else
+    {
+        loop.Run(0, count);
+    }
+}
+
+const wxVector<wxRect2DDouble>& wxStackedColumnChart::Layout::GetAreas() const
+{
+    return m_areas;
+}
+
 wxStackedColumnChart::wxStackedColumnChart(const wxBarChartData &data,
                                            const wxSize &size)
-    : m_grid(
+    : wxChart(size), m_grid(
         wxPoint2DDouble(m_options.GetPadding().GetLeft(), m_options.GetPadding().GetRight()),
         size, data.GetLabels(), GetCumulativeMinValue(data.GetDatasets()),
         GetCumulativeMaxValue(data.GetDatasets()), m_options.GetGridOptions()
@@ -189,57 +290,66 @@ void wxStackedColumnChart::DoSetSize(const wxSize &size)
 
 void wxStackedColumnChart::DoFit()
 {
-    wxVector<wxDouble> heightOfPreviousDatasets;
-    for (size_t i = 0; i < m_datasets[0]->GetColumns().size(); ++i)
+    Layout layout(m_grid.GetMapping(), m_datasets, m_options.GetColumnSpacing(),
+        GetFitPool(GetNumberOfColumns()));
+    layout.Compute();
+    ApplyLayout(layout);
+}
+
+wxChart::Layout* wxStackedColumnChart::CreateLayout()
+{
+    const size_t threshold = m_options.GetBackgroundFitThreshold();
+    const size_t numberOfColumns = GetNumberOfColumns();
+    if ((threshold == 0) || (numberOfColumns <= threshold))
     {
-        heightOfPreviousDatasets.push_back(0);
+        return 0;
     }
 
+    // The grid keeps updating its axes while the
+    // layout is computed
+    return new Layout(m_grid.GetMapping().Clone(), m_datasets,
+        m_options.GetColumnSpacing(), GetFitPool(numberOfColumns));
+}
+
+void wxStackedColumnChart::ApplyLayout(wxChart::Layout &layout)
+{
+    const wxVector<wxRect2DDouble>& areas = static_cast<Layout&>(layout).GetAreas();
+
+    size_t k = 0;
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
-        Dataset& currentDataset = *m_datasets[i];
-        for (size_t j = 0; j < currentDataset.GetColumns().size(); ++j)
+        const wxVector<Column::ptr>& columns = m_datasets[i]->GetColumns();
+        for (size_t j = 0; j < columns.size(); ++j)
         {
-            Column& column = *(currentDataset.GetColumns()[j]);
-
-            wxPoint2DDouble upperLeftCornerPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(j, column.GetValue());
-            upperLeftCornerPosition.m_x += m_options.GetColumnSpacing();
-            upperLeftCornerPosition.m_y -= heightOfPreviousDatasets[j];
-            wxPoint2DDouble upperRightCornerPosition = m_grid.GetMapping().GetWindowPositionAtTickMark(j + 1, column.GetValue());
-            upperRightCornerPosition.m_x -= m_options.GetColumnSpacing();
-            upperRightCornerPosition.m_y -= heightOfPreviousDatasets[j];
-
-            wxPoint2DDouble bottomLeftCornerPosition = m_grid.GetMapping().GetXAxis().GetTickMarkPosition(j);
-
-            column.SetPosition(upperLeftCornerPosition);
-            column.SetSize(upperRightCornerPosition.m_x - upperLeftCornerPosition.m_x,
-                (bottomLeftCornerPosition.m_y - heightOfPreviousDatasets[j]) - upperLeftCornerPosition.m_y);
-
-            heightOfPreviousDatasets[j] = bottomLeftCornerPosition.m_y - upperLeftCornerPosition.m_y;
+            const wxRect2DDouble &area = areas[k++];
+            columns[j]->SetPosition(area.GetLeftTop());
+            columns[j]->SetSize(area.m_width, area.m_height);
         }
     }
 }
 
 void wxStackedColumnChart::DoDraw(wxGraphicsContext &gc)
 {
-    m_grid.Draw(gc);
+    m_grid.Draw(gc, GetGraphicsCache());
 
     Fit();
 
+    // The columns of a dataset share the same style and are
+    // drawn as one batch
+    wxChartBatchRenderer renderer(gc, GetGraphicsCache());
     for (size_t i = 0; i < m_datasets.size(); ++i)
     {
         Dataset& currentDataset = *m_datasets[i];
         for (size_t j = 0; j < currentDataset.GetColumns().size(); ++j)
         {
-            currentDataset.GetColumns()[j]->Draw(gc);
+            currentDataset.GetColumns()[j]->Draw(renderer);
         }
     }
 }
 
-wxSharedPtr<wxVector<const wxChartElement*> > wxStackedColumnChart::GetActiveElements(const wxPoint &point)
+void wxStackedColumnChart::GetActiveElements(const wxPoint &point,
+                                             wxVector<const wxChartElement*> &activeElements)
 {
-    wxSharedPtr<wxVector<const wxChartElement*> > activeElements(new wxVector<const wxChartElement*>());
-
     // Dataset are iterated in reverse order so that the tooltip items
     // are in the same order as the stacked columns
     for (int i = m_datasets.size() - 1; i >= 0; --i)
@@ -249,10 +359,18 @@ wxSharedPtr<wxVector<const wxChartElement*> > wxStackedColumnChart::GetActiveEle
         {
             if (columns[j]->HitTest(point))
             {
-                activeElements->push_back(columns[j].get());
+                activeElements.push_back(columns[j].get());
             }
         }
     }
+}
 
-    return activeElements;
+size_t wxStackedColumnChart::GetNumberOfColumns() const
+{
+    size_t result = 0;
+    for (size_t i = 0; i < m_datasets.size(); ++i)
+    {
+        result += m_datasets[i]->GetColumns().size();
+    }
+    return result;
 }
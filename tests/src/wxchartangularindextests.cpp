@@ -0,0 +1,164 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartangularindextests.h"
+#include <wx/charts/wxchartangularindex.h>
+#include <wx/sharedptr.h>
+#include <cmath>
+#include <cstdlib>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(wxChartAngularIndexTests);
+
+namespace
+{
+    const wxDouble centerX = 200;
+    const wxDouble centerY = 150;
+
+    // Splits the circle into slices of random sizes the
+    // way the circular charts do, starting at a given
+    // angle
+    void CreateSlices(wxDouble startAngle,
+                      wxDouble innerRadius,
+                      wxVector<wxSharedPtr<wxChartArc> > &arcs,
+                      wxVector<wxDouble> &startAngles,
+                      wxVector<wxDouble> &endAngles)
+    {
+        wxVector<wxDouble> values;
+        wxDouble total = 0;
+        const size_t count = 1 + (rand() % 20);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values.push_back(1 + (rand() % 50));
+            total += values.back();
+        }
+
+        arcs.clear();
+        startAngles.clear();
+        endAngles.clear();
+        for (size_t i = 0; i < count; ++i)
+        {
+            wxDouble endAngle = startAngle + (2 * M_PI * values[i] / total);
+            wxSharedPtr<wxChartArc> arc(new wxChartArc(centerX, centerY, 0, 0,
+                100 + (rand() % 40), innerRadius, "", wxChartArcOptions(1, wxColor(255, 0, 0))));
+            arc->SetAngles(startAngle, endAngle);
+            arcs.push_back(arc);
+            startAngles.push_back(startAngle);
+            endAngles.push_back(endAngle);
+            startAngle = endAngle;
+        }
+    }
+
+    // Compares the queries with a hit test of all the arcs
+    void CheckQueries(const wxVector<wxSharedPtr<wxChartArc> > &arcs,
+                      const wxVector<size_t> &order,
+                      const wxVector<wxDouble> &startAngles,
+                      const wxVector<wxDouble> &endAngles)
+    {
+        wxChartAngularIndex index;
+        index.Clear(wxPoint2DDouble(centerX, centerY));
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            index.Add(arcs[order[i]].get(), startAngles[order[i]], endAngles[order[i]]);
+        }
+
+        wxVector<const wxChartElement*> expected;
+        wxVector<const wxChartElement*> elements;
+        for (int y = 0; y < 300; y += 3)
+        {
+            for (int x = 50; x < 350; x += 3)
+            {
+                wxPoint point(x, y);
+                expected.clear();
+                for (size_t i = 0; i < order.size(); ++i)
+                {
+                    if (arcs[order[i]]->HitTest(point))
+                    {
+                        expected.push_back(arcs[order[i]].get());
+                    }
+                }
+
+                elements.clear();
+                index.Query(point, elements);
+                CPPUNIT_ASSERT_EQUAL(expected.size(), elements.size());
+                for (size_t i = 0; i < expected.size(); ++i)
+                {
+                    CPPUNIT_ASSERT(expected[i] == elements[i]);
+                }
+            }
+        }
+    }
+}
+
+void wxChartAngularIndexTests::testConsecutiveArcs()
+{
+    srand(1);
+    wxVector<wxSharedPtr<wxChartArc> > arcs;
+    wxVector<wxDouble> startAngles;
+    wxVector<wxDouble> endAngles;
+    for (size_t round = 0; round < 10; ++round)
+    {
+        CreateSlices(0, (round % 2) ? 40 : 0, arcs, startAngles, endAngles);
+        wxVector<size_t> order;
+        for (size_t i = 0; i < arcs.size(); ++i)
+        {
+            order.push_back(i);
+        }
+        CheckQueries(arcs, order, startAngles, endAngles);
+    }
+}
+
+void wxChartAngularIndexTests::testRotatedArcs()
+{
+    srand(2);
+    wxVector<wxSharedPtr<wxChartArc> > arcs;
+    wxVector<wxDouble> startAngles;
+    wxVector<wxDouble> endAngles;
+    for (size_t round = 0; round < 10; ++round)
+    {
+        // The last arcs end after a full turn
+        CreateSlices(0.5 + (rand() % 50) / 10.0, 0, arcs, startAngles, endAngles);
+        wxVector<size_t> order;
+        for (size_t i = 0; i < arcs.size(); ++i)
+        {
+            order.push_back(i);
+        }
+        CheckQueries(arcs, order, startAngles, endAngles);
+    }
+}
+
+void wxChartAngularIndexTests::testUnsortedArcs()
+{
+    srand(3);
+    wxVector<wxSharedPtr<wxChartArc> > arcs;
+    wxVector<wxDouble> startAngles;
+    wxVector<wxDouble> endAngles;
+    for (size_t round = 0; round < 10; ++round)
+    {
+        CreateSlices(0, 0, arcs, startAngles, endAngles);
+        wxVector<size_t> order;
+        for (size_t i = 0; i < arcs.size(); ++i)
+        {
+            order.push_back(arcs.size() - 1 - i);
+        }
+        CheckQueries(arcs, order, startAngles, endAngles);
+    }
+}
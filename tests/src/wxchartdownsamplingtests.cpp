@@ -0,0 +1,215 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartdownsamplingtests.h"
+#include <wx/charts/wxchartdownsampling.h>
+#include <cmath>
+#include <cstdlib>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(wxChartDownsamplingTests);
+
+namespace
+{
+    // Points with increasing X coordinates, several of
+    // them usually fall in the same pixel column
+    void CreateLine(size_t count,
+                    wxVector<wxPoint2DDouble> &points)
+    {
+        points.clear();
+        wxDouble x = 10;
+        for (size_t i = 0; i < count; ++i)
+        {
+            x += (1 + (rand() % 100)) / 60.0;
+            points.push_back(wxPoint2DDouble(x, rand() % 500));
+        }
+    }
+
+    void CheckSamePoints(const wxVector<wxPoint2DDouble> &expected,
+                         const wxVector<wxPoint2DDouble> &points)
+    {
+        CPPUNIT_ASSERT_EQUAL(expected.size(), points.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            CPPUNIT_ASSERT_EQUAL(expected[i].m_x, points[i].m_x);
+            CPPUNIT_ASSERT_EQUAL(expected[i].m_y, points[i].m_y);
+        }
+    }
+
+    // Finds the index of each point of a result in the
+    // original line, the points must have been kept in
+    // order
+    void FindIndices(const wxVector<wxPoint2DDouble> &points,
+                     const wxVector<wxPoint2DDouble> &result,
+                     wxVector<size_t> &indices)
+    {
+        indices.clear();
+        size_t i = 0;
+        for (size_t j = 0; j < result.size(); ++j)
+        {
+            while ((i < points.size()) &&
+                ((points[i].m_x != result[j].m_x) || (points[i].m_y != result[j].m_y)))
+            {
+                ++i;
+            }
+            CPPUNIT_ASSERT(i < points.size());
+            indices.push_back(i++);
+        }
+    }
+}
+
+void wxChartDownsamplingTests::testGetThreshold()
+{
+    CPPUNIT_ASSERT_EQUAL((size_t)2, wxChartDownsampling::GetThreshold(0));
+    CPPUNIT_ASSERT_EQUAL((size_t)2, wxChartDownsampling::GetThreshold(1));
+    CPPUNIT_ASSERT_EQUAL((size_t)802, wxChartDownsampling::GetThreshold(400.5));
+}
+
+void wxChartDownsamplingTests::testLTTBCopiesShortLines()
+{
+    srand(1);
+    wxVector<wxPoint2DDouble> points;
+    CreateLine(50, points);
+
+    wxVector<wxPoint2DDouble> result;
+    wxChartDownsampling::LargestTriangleThreeBuckets(points, 50, result);
+    CheckSamePoints(points, result);
+    wxChartDownsampling::LargestTriangleThreeBuckets(points, 100, result);
+    CheckSamePoints(points, result);
+
+    // Two points can't be split into buckets
+    wxChartDownsampling::LargestTriangleThreeBuckets(points, 2, result);
+    CheckSamePoints(points, result);
+}
+
+void wxChartDownsamplingTests::testLTTBSelection()
+{
+    srand(2);
+    wxVector<wxPoint2DDouble> points;
+    wxVector<wxPoint2DDouble> result;
+    wxVector<size_t> indices;
+    for (size_t round = 0; round < 50; ++round)
+    {
+        CreateLine(100 + (rand() % 5000), points);
+        const size_t threshold = 3 + (rand() % (points.size() - 3));
+        wxChartDownsampling::LargestTriangleThreeBuckets(points, threshold, result);
+
+        CPPUNIT_ASSERT_EQUAL(threshold, result.size());
+        FindIndices(points, result, indices);
+        CPPUNIT_ASSERT_EQUAL((size_t)0, indices.front());
+        CPPUNIT_ASSERT_EQUAL(points.size() - 1, indices.back());
+
+        // One point from each bucket
+        const wxDouble bucketSize = static_cast<wxDouble>(points.size() - 2) / (threshold - 2);
+        for (size_t i = 1; (i + 1) < indices.size(); ++i)
+        {
+            size_t start = static_cast<size_t>((i - 1) * bucketSize) + 1;
+            size_t end = static_cast<size_t>(i * bucketSize) + 1;
+            CPPUNIT_ASSERT(indices[i] >= start);
+            CPPUNIT_ASSERT((indices[i] < end) || (indices[i] == start));
+        }
+    }
+}
+
+void wxChartDownsamplingTests::testLTTBKeepsSpike()
+{
+    wxVector<wxPoint2DDouble> points;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        points.push_back(wxPoint2DDouble(i, (i == 567) ? 1000 : 0));
+    }
+
+    wxVector<wxPoint2DDouble> result;
+    wxChartDownsampling::LargestTriangleThreeBuckets(points, 20, result);
+
+    bool found = false;
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        if (result[i].m_y == 1000)
+        {
+            CPPUNIT_ASSERT_EQUAL(567.0, result[i].m_x);
+            found = true;
+        }
+    }
+    CPPUNIT_ASSERT(found);
+}
+
+void wxChartDownsamplingTests::testM4Empty()
+{
+    wxVector<wxPoint2DDouble> points;
+    wxVector<wxPoint2DDouble> result;
+    result.push_back(wxPoint2DDouble(1, 1));
+    wxChartDownsampling::M4(points, result);
+    CPPUNIT_ASSERT(result.empty());
+
+    points.push_back(wxPoint2DDouble(3.5, 7));
+    wxChartDownsampling::M4(points, result);
+    CheckSamePoints(points, result);
+}
+
+void wxChartDownsamplingTests::testM4Selection()
+{
+    srand(3);
+    wxVector<wxPoint2DDouble> points;
+    wxVector<wxPoint2DDouble> result;
+    wxVector<wxPoint2DDouble> expected;
+    for (size_t round = 0; round < 50; ++round)
+    {
+        CreateLine(1 + (rand() % 5000), points);
+        wxChartDownsampling::M4(points, result);
+
+        // For each run of points in the same pixel column,
+        // the first, lowest, highest and last points in
+        // their original order
+        expected.clear();
+        size_t start = 0;
+        while (start < points.size())
+        {
+            size_t end = start;
+            size_t minIndex = start;
+            size_t maxIndex = start;
+            while ((end < points.size()) &&
+                (std::floor(points[end].m_x) == std::floor(points[start].m_x)))
+            {
+                if (points[end].m_y < points[minIndex].m_y)
+                {
+                    minIndex = end;
+                }
+                if (points[end].m_y > points[maxIndex].m_y)
+                {
+                    maxIndex = end;
+                }
+                ++end;
+            }
+
+            for (size_t i = start; i < end; ++i)
+            {
+                if ((i == start) || (i == minIndex) || (i == maxIndex) || (i == (end - 1)))
+                {
+                    expected.push_back(points[i]);
+                }
+            }
+            start = end;
+        }
+
+        CheckSamePoints(expected, result);
+    }
+}
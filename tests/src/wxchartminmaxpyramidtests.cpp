@@ -0,0 +1,255 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartminmaxpyramidtests.h"
+#include <wx/charts/wxchartminmaxpyramid.h>
+#include <algorithm>
+#include <cstdlib>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(wxChartMinMaxPyramidTests);
+
+namespace
+{
+    // Appends random points, once the list is full each
+    // new point discards the oldest one
+    void AppendPoints(wxChartRingBuffer<wxPoint2DDouble> &points,
+                      size_t count,
+                      size_t &discarded)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t position = discarded + points.GetCount();
+            if (points.IsFull())
+            {
+                ++discarded;
+            }
+            // Few distinct values so that there are ties
+            points.Append(wxPoint2DDouble(position, rand() % 100));
+        }
+    }
+
+    void CheckSelection(size_t first,
+                        size_t last,
+                        const wxVector<size_t> &indices)
+    {
+        CPPUNIT_ASSERT(!indices.empty());
+        CPPUNIT_ASSERT_EQUAL(first, indices.front());
+        CPPUNIT_ASSERT_EQUAL(last - 1, indices.back());
+        for (size_t i = 1; i < indices.size(); ++i)
+        {
+            CPPUNIT_ASSERT(indices[i - 1] < indices[i]);
+        }
+    }
+
+    void CheckSameSelection(const wxVector<size_t> &expected,
+                            const wxVector<size_t> &indices)
+    {
+        CPPUNIT_ASSERT_EQUAL(expected.size(), indices.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            CPPUNIT_ASSERT_EQUAL(expected[i], indices[i]);
+        }
+    }
+}
+
+void wxChartMinMaxPyramidTests::testSelectEmptyRange()
+{
+    wxChartRingBuffer<wxPoint2DDouble> points;
+    size_t discarded = 0;
+    wxChartMinMaxPyramid pyramid;
+
+    wxVector<size_t> indices;
+    pyramid.Update(points, discarded);
+    pyramid.Select(0, 0, 10, indices);
+    CPPUNIT_ASSERT(indices.empty());
+
+    AppendPoints(points, 100, discarded);
+    pyramid.Update(points, discarded);
+    pyramid.Select(50, 50, 10, indices);
+    CPPUNIT_ASSERT(indices.empty());
+}
+
+void wxChartMinMaxPyramidTests::testSelectSmallBuckets()
+{
+    srand(1);
+    wxChartRingBuffer<wxPoint2DDouble> points;
+    size_t discarded = 0;
+    AppendPoints(points, 1000, discarded);
+
+    wxChartMinMaxPyramid pyramid;
+    pyramid.Update(points, discarded);
+
+    // With less than 8 points per bucket all the points
+    // of the range are selected
+    wxVector<size_t> indices;
+    pyramid.Select(100, 900, 800 / 7, indices);
+    CPPUNIT_ASSERT_EQUAL((size_t)800, indices.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        CPPUNIT_ASSERT_EQUAL(100 + i, indices[i]);
+    }
+}
+
+void wxChartMinMaxPyramidTests::testSelectKeepsBucketExtremes()
+{
+    srand(1);
+    wxChartRingBuffer<wxPoint2DDouble> points(5000);
+    size_t discarded = 0;
+    wxChartMinMaxPyramid pyramid;
+
+    wxVector<size_t> indices;
+    for (size_t round = 0; round < 40; ++round)
+    {
+        AppendPoints(points, 1 + (rand() % 700), discarded);
+        pyramid.Update(points, discarded);
+
+        const size_t count = points.GetCount();
+        for (size_t query = 0; query < 10; ++query)
+        {
+            size_t first = rand() % count;
+            size_t last = first + 1 + (rand() % (count - first));
+
+            // Asking for (last - first) / 2^shift buckets selects
+            // the level whose buckets hold 2^shift points
+            for (size_t shift = 3; ((size_t)1 << shift) <= (last - first); ++shift)
+            {
+                const size_t buckets = ((last - first) >> shift);
+                indices.clear();
+                pyramid.Select(first, last, buckets, indices);
+                CheckSelection(first, last, indices);
+                CPPUNIT_ASSERT(indices.size() <= ((2 * (buckets + 2)) + 2));
+
+                // The buckets are aligned on the position of the
+                // points, each bucket that is entirely inside the
+                // range must contribute its lowest and highest
+                // points
+                const size_t size = ((size_t)1 << shift);
+                const size_t begin = discarded + first;
+                const size_t end = discarded + last;
+                size_t selected = 0;
+                for (size_t b = ((begin + size - 1) / size); ((b + 1) * size) <= end; ++b)
+                {
+                    const size_t bucketFirst = (b * size) - discarded;
+                    const size_t bucketLast = bucketFirst + size;
+
+                    wxDouble expectedMin = points[bucketFirst].m_y;
+                    wxDouble expectedMax = points[bucketFirst].m_y;
+                    for (size_t i = bucketFirst + 1; i < bucketLast; ++i)
+                    {
+                        expectedMin = std::min(expectedMin, points[i].m_y);
+                        expectedMax = std::max(expectedMax, points[i].m_y);
+                    }
+
+                    while ((selected < indices.size()) && (indices[selected] < bucketFirst))
+                    {
+                        ++selected;
+                    }
+                    CPPUNIT_ASSERT((selected < indices.size()) && (indices[selected] < bucketLast));
+                    wxDouble selectedMin = points[indices[selected]].m_y;
+                    wxDouble selectedMax = points[indices[selected]].m_y;
+                    for (; (selected < indices.size()) && (indices[selected] < bucketLast); ++selected)
+                    {
+                        selectedMin = std::min(selectedMin, points[indices[selected]].m_y);
+                        selectedMax = std::max(selectedMax, points[indices[selected]].m_y);
+                    }
+                    CPPUNIT_ASSERT_EQUAL(expectedMin, selectedMin);
+                    CPPUNIT_ASSERT_EQUAL(expectedMax, selectedMax);
+                }
+            }
+        }
+    }
+}
+
+void wxChartMinMaxPyramidTests::testUpdateMatchesRebuild()
+{
+    srand(2);
+    wxChartRingBuffer<wxPoint2DDouble> points(3000);
+    size_t discarded = 0;
+    wxChartMinMaxPyramid pyramid;
+
+    wxVector<size_t> expected;
+    wxVector<size_t> indices;
+    for (size_t round = 0; round < 60; ++round)
+    {
+        AppendPoints(points, 1 + (rand() % 500), discarded);
+        pyramid.Update(points, discarded);
+
+        wxChartMinMaxPyramid rebuilt;
+        rebuilt.Update(points, discarded);
+
+        const size_t count = points.GetCount();
+        for (size_t query = 0; query < 10; ++query)
+        {
+            size_t first = rand() % count;
+            size_t last = first + 1 + (rand() % (count - first));
+            size_t buckets = 1 + (rand() % 200);
+
+            expected.clear();
+            rebuilt.Select(first, last, buckets, expected);
+            indices.clear();
+            pyramid.Select(first, last, buckets, indices);
+            CheckSameSelection(expected, indices);
+        }
+    }
+}
+
+void wxChartMinMaxPyramidTests::testUpdateAfterRewind()
+{
+    srand(3);
+    wxChartRingBuffer<wxPoint2DDouble> points(1000);
+    size_t discarded = 0;
+    wxChartMinMaxPyramid pyramid;
+
+    AppendPoints(points, 2500, discarded);
+    pyramid.Update(points, discarded);
+
+    // The list starts over, the pyramid must not reuse
+    // any of its buckets
+    points.Clear();
+    discarded = 0;
+    AppendPoints(points, 1500, discarded);
+    pyramid.Update(points, discarded);
+
+    wxChartMinMaxPyramid rebuilt;
+    rebuilt.Update(points, discarded);
+
+    wxVector<size_t> expected;
+    rebuilt.Select(0, points.GetCount(), 50, expected);
+    wxVector<size_t> indices;
+    pyramid.Select(0, points.GetCount(), 50, indices);
+    CheckSameSelection(expected, indices);
+
+    // Same thing after an explicit clear
+    pyramid.Clear();
+    points.Clear();
+    AppendPoints(points, 800, discarded);
+    pyramid.Update(points, discarded);
+
+    rebuilt.Clear();
+    rebuilt.Update(points, discarded);
+
+    expected.clear();
+    rebuilt.Select(0, points.GetCount(), 30, expected);
+    indices.clear();
+    pyramid.Select(0, points.GetCount(), 30, indices);
+    CheckSameSelection(expected, indices);
+}
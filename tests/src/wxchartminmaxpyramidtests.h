@@ -0,0 +1,46 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#ifndef _TESTS_WX_CHARTS_WXCHARTMINMAXPYRAMIDTESTS_H_
+#define _TESTS_WX_CHARTS_WXCHARTMINMAXPYRAMIDTESTS_H_
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class wxChartMinMaxPyramidTests : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(wxChartMinMaxPyramidTests);
+    CPPUNIT_TEST(testSelectEmptyRange);
+    CPPUNIT_TEST(testSelectSmallBuckets);
+    CPPUNIT_TEST(testSelectKeepsBucketExtremes);
+    CPPUNIT_TEST(testUpdateMatchesRebuild);
+    CPPUNIT_TEST(testUpdateAfterRewind);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    void testSelectEmptyRange();
+    void testSelectSmallBuckets();
+    void testSelectKeepsBucketExtremes();
+    void testUpdateMatchesRebuild();
+    void testUpdateAfterRewind();
+};
+
+#endif
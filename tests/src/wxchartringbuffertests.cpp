@@ -0,0 +1,145 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartringbuffertests.h"
+#include <wx/charts/wxchartringbuffer.h>
+#include <cstdlib>
+#include <deque>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(wxChartRingBufferTests);
+
+namespace
+{
+    void CheckItems(const std::deque<int> &expected,
+                    const wxChartRingBuffer<int> &buffer)
+    {
+        CPPUNIT_ASSERT_EQUAL(expected.size(), buffer.GetCount());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            CPPUNIT_ASSERT_EQUAL(expected[i], buffer[i]);
+        }
+    }
+}
+
+void wxChartRingBufferTests::testUnlimited()
+{
+    wxChartRingBuffer<int> buffer;
+    CPPUNIT_ASSERT_EQUAL((size_t)0, buffer.GetCapacity());
+
+    std::deque<int> expected;
+    for (int i = 0; i < 1000; ++i)
+    {
+        buffer.Append(i);
+        expected.push_back(i);
+        CPPUNIT_ASSERT(!buffer.IsFull());
+    }
+    CheckItems(expected, buffer);
+}
+
+void wxChartRingBufferTests::testAppendDiscardsOldest()
+{
+    srand(1);
+    wxChartRingBuffer<int> buffer(100);
+    std::deque<int> expected;
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        int value = rand();
+        buffer.Append(value);
+        expected.push_back(value);
+        if (expected.size() > 100)
+        {
+            expected.pop_front();
+        }
+
+        CPPUNIT_ASSERT_EQUAL(expected.size() == 100, buffer.IsFull());
+        CheckItems(expected, buffer);
+    }
+}
+
+void wxChartRingBufferTests::testSetCapacity()
+{
+    srand(2);
+    wxChartRingBuffer<int> buffer(50);
+    std::deque<int> expected;
+    for (int i = 0; i < 130; ++i)
+    {
+        buffer.Append(i);
+        expected.push_back(i);
+    }
+    expected.erase(expected.begin(), expected.end() - 50);
+    CheckItems(expected, buffer);
+
+    // Shrinking keeps the most recent items
+    buffer.SetCapacity(20);
+    expected.erase(expected.begin(), expected.end() - 20);
+    CPPUNIT_ASSERT_EQUAL((size_t)20, buffer.GetCapacity());
+    CPPUNIT_ASSERT(buffer.IsFull());
+    CheckItems(expected, buffer);
+
+    // Growing keeps all of them and makes room for more
+    buffer.SetCapacity(40);
+    CPPUNIT_ASSERT(!buffer.IsFull());
+    CheckItems(expected, buffer);
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        int value = rand();
+        buffer.Append(value);
+        expected.push_back(value);
+        if (expected.size() > 40)
+        {
+            expected.pop_front();
+        }
+        CheckItems(expected, buffer);
+    }
+
+    // No limit
+    buffer.SetCapacity(0);
+    for (int i = 0; i < 100; ++i)
+    {
+        buffer.Append(i);
+        expected.push_back(i);
+    }
+    CheckItems(expected, buffer);
+}
+
+void wxChartRingBufferTests::testClear()
+{
+    wxChartRingBuffer<int> buffer(10);
+    for (int i = 0; i < 25; ++i)
+    {
+        buffer.Append(i);
+    }
+    buffer.Clear();
+    CPPUNIT_ASSERT_EQUAL((size_t)0, buffer.GetCount());
+    CPPUNIT_ASSERT_EQUAL((size_t)10, buffer.GetCapacity());
+
+    std::deque<int> expected;
+    for (int i = 0; i < 15; ++i)
+    {
+        buffer.Append(i);
+        expected.push_back(i);
+    }
+    expected.erase(expected.begin(), expected.begin() + 5);
+    CheckItems(expected, buffer);
+}
@@ -0,0 +1,109 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartslidingminmaxtests.h"
+#include <wx/charts/wxchartslidingminmax.h>
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(wxChartSlidingMinMaxTests);
+
+void wxChartSlidingMinMaxTests::testEmpty()
+{
+    wxChartSlidingMinMax window;
+    CPPUNIT_ASSERT(window.IsEmpty());
+
+    window.Push(1);
+    CPPUNIT_ASSERT(!window.IsEmpty());
+    window.Pop();
+    CPPUNIT_ASSERT(window.IsEmpty());
+}
+
+void wxChartSlidingMinMaxTests::testPushAndPop()
+{
+    wxChartSlidingMinMax window;
+    window.Push(3);
+    window.Push(1);
+    window.Push(4);
+    window.Push(1);
+    CPPUNIT_ASSERT_EQUAL(1.0, window.GetMin());
+    CPPUNIT_ASSERT_EQUAL(4.0, window.GetMax());
+
+    // The first 1 leaves but the second one is still there
+    window.Pop();
+    window.Pop();
+    CPPUNIT_ASSERT_EQUAL(1.0, window.GetMin());
+    CPPUNIT_ASSERT_EQUAL(4.0, window.GetMax());
+
+    window.Pop();
+    CPPUNIT_ASSERT_EQUAL(1.0, window.GetMin());
+    CPPUNIT_ASSERT_EQUAL(1.0, window.GetMax());
+}
+
+void wxChartSlidingMinMaxTests::testRandomWindow()
+{
+    srand(1);
+    wxChartSlidingMinMax window;
+    std::deque<wxDouble> values;
+
+    for (size_t i = 0; i < 20000; ++i)
+    {
+        // Grow the window more often than it shrinks at
+        // first and the other way round afterwards
+        bool push = values.empty() ||
+            ((rand() % 100) < ((i < 10000) ? 60 : 40));
+        if (push)
+        {
+            wxDouble value = rand() % 50;
+            window.Push(value);
+            values.push_back(value);
+        }
+        else
+        {
+            window.Pop();
+            values.pop_front();
+        }
+
+        CPPUNIT_ASSERT_EQUAL(values.empty(), window.IsEmpty());
+        if (!values.empty())
+        {
+            CPPUNIT_ASSERT_EQUAL(*std::min_element(values.begin(), values.end()),
+                window.GetMin());
+            CPPUNIT_ASSERT_EQUAL(*std::max_element(values.begin(), values.end()),
+                window.GetMax());
+        }
+    }
+}
+
+void wxChartSlidingMinMaxTests::testClear()
+{
+    wxChartSlidingMinMax window;
+    window.Push(-5);
+    window.Push(5);
+    window.Clear();
+    CPPUNIT_ASSERT(window.IsEmpty());
+
+    window.Push(2);
+    CPPUNIT_ASSERT_EQUAL(2.0, window.GetMin());
+    CPPUNIT_ASSERT_EQUAL(2.0, window.GetMax());
+}
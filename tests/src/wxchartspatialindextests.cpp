@@ -0,0 +1,143 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartspatialindextests.h"
+#include <wx/charts/wxchartspatialindex.h>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(wxChartSpatialIndexTests);
+
+namespace
+{
+    struct Item
+    {
+        wxPoint2DDouble position;
+        wxDouble extent;
+    };
+
+    // The query may return items that can't be hit but
+    // must return all the items that can
+    void CheckQuery(const wxChartSpatialIndex &index,
+                    const wxVector<Item> &items,
+                    const wxPoint &point)
+    {
+        wxVector<size_t> result;
+        index.Query(point, result);
+        for (size_t i = 1; i < result.size(); ++i)
+        {
+            CPPUNIT_ASSERT(result[i - 1] < result[i]);
+        }
+
+        size_t j = 0;
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            while ((j < result.size()) && (result[j] < i))
+            {
+                ++j;
+            }
+            if ((std::fabs(point.x - items[i].position.m_x) < items[i].extent) &&
+                (std::fabs(point.y - items[i].position.m_y) < items[i].extent))
+            {
+                CPPUNIT_ASSERT((j < result.size()) && (result[j] == i));
+            }
+        }
+        if (!result.empty())
+        {
+            CPPUNIT_ASSERT(result.back() < items.size());
+        }
+    }
+}
+
+void wxChartSpatialIndexTests::testEmpty()
+{
+    wxChartSpatialIndex index;
+    wxVector<size_t> result;
+    index.Query(wxPoint(0, 0), result);
+    CPPUNIT_ASSERT(result.empty());
+
+    index.Build();
+    index.Query(wxPoint(0, 0), result);
+    CPPUNIT_ASSERT(result.empty());
+}
+
+void wxChartSpatialIndexTests::testQuery()
+{
+    srand(1);
+    for (size_t round = 0; round < 5; ++round)
+    {
+        wxChartSpatialIndex index;
+        wxVector<Item> items;
+        const size_t count = 1 + (rand() % 3000);
+        for (size_t i = 0; i < count; ++i)
+        {
+            Item item;
+            item.position = wxPoint2DDouble((rand() % 10000) / 10.0 - 50,
+                (rand() % 8000) / 10.0 - 50);
+            // A few items are much larger than the others
+            item.extent = ((i % 100) == 0) ? (rand() % 300) : ((rand() % 200) / 10.0);
+            items.push_back(item);
+            index.Add(item.position, item.extent);
+        }
+        index.Build();
+
+        for (size_t i = 0; i < 2000; ++i)
+        {
+            CheckQuery(index, items, wxPoint((rand() % 1200) - 100, (rand() % 1000) - 100));
+        }
+    }
+}
+
+void wxChartSpatialIndexTests::testNonFiniteItems()
+{
+    wxChartSpatialIndex index;
+    index.Add(wxPoint2DDouble(10, 10), 5);
+    index.Add(wxPoint2DDouble(std::numeric_limits<wxDouble>::quiet_NaN(), 10), 5);
+    index.Add(wxPoint2DDouble(10, 10), std::numeric_limits<wxDouble>::infinity());
+    index.Add(wxPoint2DDouble(10, 10), 5);
+    index.Build();
+
+    // The items that can't be hit still get a number
+    wxVector<size_t> result;
+    index.Query(wxPoint(10, 10), result);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, result.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)0, result[0]);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, result[1]);
+}
+
+void wxChartSpatialIndexTests::testSwap()
+{
+    wxChartSpatialIndex index1;
+    index1.Add(wxPoint2DDouble(10, 10), 5);
+    index1.Build();
+    wxChartSpatialIndex index2;
+
+    index1.Swap(index2);
+
+    wxVector<size_t> result;
+    index1.Query(wxPoint(10, 10), result);
+    CPPUNIT_ASSERT(result.empty());
+    index2.Query(wxPoint(10, 10), result);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, result.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)0, result[0]);
+}
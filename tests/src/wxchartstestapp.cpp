@@ -21,13 +21,23 @@
 */
 
 #include "wxchartstestapp.h"
+// Also links the wxCharts library with Visual C++
+#include <wx/charts/wxcharts.h>
 #include <cppunit/TextTestRunner.h>
-#include <cppunit/TestResultCollector.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
 
 wxIMPLEMENT_APP_NO_MAIN(wxChartsTestApp);
 
+int wxChartsTestApp::OnRun()
+{
+    return RunTests();
+}
+
 int wxChartsTestApp::RunTests()
 {
+    // The suites register themselves with
+    // CPPUNIT_TEST_SUITE_REGISTRATION
     CppUnit::TextTestRunner runner;
-    return runner.result().testFailures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    runner.addTest(CppUnit::TestFactoryRegistry::getRegistry().makeTest());
+    return runner.run() ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -27,6 +27,9 @@
 
 class wxChartsTestApp : public wxAppConsole
 {
+public:
+    virtual int OnRun();
+
 private:
     int RunTests();
 };
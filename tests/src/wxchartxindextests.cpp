@@ -0,0 +1,126 @@
+/*
+    Copyright (c) 2016-2017 Xavier Leclercq and the wxCharts contributors.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in
+    all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+    IN THE SOFTWARE.
+*/
+
+#include "wxchartxindextests.h"
+#include <wx/charts/wxchartxindex.h>
+#include <cmath>
+#include <cstdlib>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(wxChartXIndexTests);
+
+namespace
+{
+    // Compares the result of a query with a test of
+    // all the points
+    void CheckQuery(const wxChartXIndex &index,
+                    const wxVector<wxDouble> &x,
+                    wxDouble queryX,
+                    wxDouble range)
+    {
+        wxVector<size_t> expected;
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+            if (std::fabs(queryX - x[i]) < range)
+            {
+                expected.push_back(i);
+            }
+        }
+
+        wxVector<size_t> points;
+        index.Query(queryX, range, points);
+        CPPUNIT_ASSERT_EQUAL(expected.size(), points.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            CPPUNIT_ASSERT_EQUAL(expected[i], points[i]);
+        }
+    }
+}
+
+void wxChartXIndexTests::testEmpty()
+{
+    wxChartXIndex index;
+    wxVector<size_t> points;
+    index.Query(0, 100, points);
+    CPPUNIT_ASSERT(points.empty());
+}
+
+void wxChartXIndexTests::testSortedQuery()
+{
+    srand(1);
+    wxChartXIndex index;
+    wxVector<wxDouble> x;
+    wxDouble position = 0;
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        // Some points share the same X coordinate
+        position += (rand() % 4) / 2.0;
+        x.push_back(position);
+        index.Add(position);
+    }
+
+    for (size_t i = 0; i < 500; ++i)
+    {
+        wxDouble queryX = (rand() % (int)(position + 40)) - 20;
+        wxDouble range = (rand() % 20) / 2.0;
+        CheckQuery(index, x, queryX, range);
+    }
+    // Exactly on a point
+    CheckQuery(index, x, x[1000], 0.5);
+}
+
+void wxChartXIndexTests::testUnsortedQuery()
+{
+    srand(2);
+    wxChartXIndex index;
+    wxVector<wxDouble> x;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        wxDouble position = (rand() % 2000) / 2.0;
+        x.push_back(position);
+        index.Add(position);
+    }
+
+    for (size_t i = 0; i < 500; ++i)
+    {
+        wxDouble queryX = (rand() % 1040) - 20;
+        wxDouble range = (rand() % 20) / 2.0;
+        CheckQuery(index, x, queryX, range);
+    }
+}
+
+void wxChartXIndexTests::testClear()
+{
+    wxChartXIndex index;
+    index.Add(10);
+    index.Add(5);
+    index.Clear();
+
+    // The index is sorted again after being cleared
+    wxVector<wxDouble> x;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        x.push_back(i);
+        index.Add(i);
+    }
+    CheckQuery(index, x, 10, 3);
+    CheckQuery(index, x, 99.5, 1);
+}